@@ -9,6 +9,7 @@
 #include <type_traits>
 #include <memory>
 #include <cassert>
+#include <exception>
 
 #ifndef FLUX_FOUNDRY_NO_EXCEPTION_STRICT
 #define FLUX_FOUNDRY_NO_EXCEPTION_STRICT 0
@@ -104,6 +105,37 @@
 #define FLUX_FOUNDRY_AWAITABLE_POOL_SLOT_COUNT 256
 #endif
 
+// default number of nested continuations an executor that opts into hop coalescing
+// runs inline before it enqueues again, see flow_impl::inline_hop_traits.
+#ifndef FLUX_FOUNDRY_INLINE_HOP_BUDGET
+#define FLUX_FOUNDRY_INLINE_HOP_BUDGET 16
+#endif
+
+// number of consecutive calc steps fused into one blueprint node (flow_impl::fused_callable),
+// the blueprint starts a new calc node once a chain gets longer than this.
+#ifndef FLUX_FOUNDRY_MAX_ZIP_N
+#define FLUX_FOUNDRY_MAX_ZIP_N 128
+#endif
+
+// lets either_t<T, std::error_code> keep its discriminant in the error_code's category pointer,
+// which is never null for a live error_code (see either_niche). set to 0 for a standard library
+// whose error_code does not end with its category pointer.
+#ifndef FLUX_FOUNDRY_ERROR_CODE_NICHE
+#define FLUX_FOUNDRY_ERROR_CODE_NICHE 1
+#endif
+
+// reports every type a type-erased wrapper (task_wrapper, callable_wrapper, ...) has to store on the
+// heap because it does not fit the SBO buffer: 1 warns at the emplace site, 2 fails the build.
+#ifndef FLUX_FOUNDRY_SBO_SPILL_DIAGNOSTIC
+#define FLUX_FOUNDRY_SBO_SPILL_DIAGNOSTIC 0
+#endif
+
+// inline buffer of the continuation a runner hands to an awaitable (awaitable_next_step_t). it holds the
+// blueprint pointer, the receiver, the controller and the dispatcher, larger receivers spill to the heap.
+#ifndef FLUX_FOUNDRY_NEXT_STEP_SBO_SIZE
+#define FLUX_FOUNDRY_NEXT_STEP_SBO_SIZE 48
+#endif
+
 #ifndef FLUX_FOUNDRY_CACHE_LINE_SIZE
 #  if defined(__APPLE__) && defined(__aarch64__)
 #    define FLUX_FOUNDRY_CACHE_LINE_SIZE 128
@@ -282,6 +314,30 @@ namespace flux_foundry {
             std::is_nothrow_copy_constructible<T>> {
     };
 
+    // is_trivially_relocatable<T>: moving a T and destroying the source does nothing more than copying its
+    // bytes and forgetting the source, so raw_type_erase_base moves it with a memcpy.
+    // specialize it for types that own a resource through a plain pointer (lite_ptr, shared_ptr, ...).
+    template <typename T>
+    struct is_trivially_relocatable
+        : conjunction<std::is_trivially_move_constructible<T>, std::is_trivially_destructible<T>> {
+    };
+
+    template <typename T>
+    struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {
+    };
+
+    template <typename T>
+    struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {
+    };
+
+    template <>
+    struct is_trivially_relocatable<std::exception_ptr> : std::true_type {
+    };
+
+    template <typename ... Ts>
+    struct all_trivially_relocatable : conjunction<is_trivially_relocatable<std::decay_t<Ts>>...> {
+    };
+
     template <typename T, typename ... Args>
     struct is_aggregate_constructible_impl {
     private:
@@ -25,6 +25,21 @@ namespace flux_foundry {
                 std::integral_constant<bool, (sizeof(T) <= sbo_size) && (alignof(T) <= align)>,
                 std::is_nothrow_move_constructible<T>> {
         };
+
+        // instantiated for every T stored out of line, see FLUX_FOUNDRY_SBO_SPILL_DIAGNOSTIC.
+        // the diagnostic names T, the buffer size and its alignment.
+        template <typename T, size_t sbo_size, size_t align>
+        struct sbo_spill {
+            static_assert(FLUX_FOUNDRY_SBO_SPILL_DIAGNOSTIC != 2 || sizeof(T) == 0,
+                "T does not fit the SBO buffer and would be stored on the heap.");
+
+#if FLUX_FOUNDRY_SBO_SPILL_DIAGNOSTIC == 1
+            [[deprecated("T does not fit the SBO buffer and is stored on the heap.")]]
+#endif
+            static constexpr bool report() noexcept {
+                return true;
+            }
+        };
     }
 
     template <typename T, bool sbo_enabled, std::enable_if_t<sbo_enabled>* = nullptr>
@@ -61,7 +76,7 @@ namespace flux_foundry {
 
     template <typename T, bool sbo_enabled,
         std::enable_if_t<!std::is_copy_constructible<T>::value>* = nullptr>
-    lifespan_op_error copy_construct_impl(void* dst, const void* src) {
+    lifespan_op_error copy_construct_impl(void*, const void*) {
         return lifespan_op_error::unsupported;
     }
 
@@ -162,6 +177,16 @@ namespace flux_foundry {
         return lifespan_op_error::success;
     }
 
+    using lite_span_management = lifespan_op_error(void* dst, const void* src, type_erase_lifespan_op op);
+
+    // per stored type descriptor, one static instance per life_span_manager.
+    // trivially_relocatable: the buffer may be moved with a memcpy and the source forgotten without
+    // running manage. always set for spilled targets, the buffer only holds the owning pointer.
+    struct type_erase_vtable {
+        lite_span_management* manage;
+        bool trivially_relocatable;
+    };
+
     template <typename T, bool enabled>
     struct life_span_manager {
         static lifespan_op_error manage(void* dst, const void* src, type_erase_lifespan_op op) {
@@ -176,9 +201,41 @@ namespace flux_foundry {
                 return lifespan_op_error::unsupported;
             }
         }
+
+        static constexpr type_erase_vtable vtable{ &manage, !enabled || is_trivially_relocatable<T>::value };
     };
 
-    using lite_span_management = lifespan_op_error(void* dst, const void* src, type_erase_lifespan_op op);
+    template <typename T, bool enabled>
+    constexpr type_erase_vtable life_span_manager<T, enabled>::vtable;
+
+    // closure types cannot specialize is_trivially_relocatable, a callable whose captures are all
+    // relocatable is wrapped in relocatable_fn to say so, see relocatable_if.
+    template <typename F>
+    struct relocatable_fn {
+        F f;
+
+        template <typename ... Args>
+        FORCE_INLINE auto operator()(Args&& ... args)
+            noexcept(noexcept(std::declval<F&>()(std::forward<Args>(args)...)))
+            -> decltype(std::declval<F&>()(std::forward<Args>(args)...)) {
+            return f(std::forward<Args>(args)...);
+        }
+    };
+
+    template <typename F>
+    struct is_trivially_relocatable<relocatable_fn<F>> : std::true_type {
+    };
+
+    template <bool relocatable, typename F, std::enable_if_t<relocatable>* = nullptr>
+    relocatable_fn<std::decay_t<F>> relocatable_if(F&& f)
+        noexcept(std::is_nothrow_constructible<std::decay_t<F>, F&&>::value) {
+        return relocatable_fn<std::decay_t<F>>{ std::forward<F>(f) };
+    }
+
+    template <bool relocatable, typename F, std::enable_if_t<!relocatable>* = nullptr>
+    F&& relocatable_if(F&& f) noexcept {
+        return std::forward<F>(f);
+    }
 
     template <typename derived,
         size_t size = sbo_size,
@@ -187,7 +244,7 @@ namespace flux_foundry {
     struct raw_type_erase_base {
         static_assert(sizeof(void*) <= size, "the given buffer should be at least sufficient to store a T*");
         hotpath_invoker_t* invoker_;
-        lite_span_management* manager_;
+        const type_erase_vtable* manager_;
         alignas(align) unsigned char data_[size];
 
         static constexpr size_t buf_size = size;
@@ -203,7 +260,7 @@ namespace flux_foundry {
 #endif
             : invoker_ { derived::stub } , manager_ { nullptr } {
             if (rhs.manager_) {
-                auto res = rhs.manager_(this->data_, rhs.data_, type_erase_lifespan_op::copy);
+                auto res = rhs.manager_->manage(this->data_, rhs.data_, type_erase_lifespan_op::copy);
                 switch (res) {
                     case lifespan_op_error::unsupported:
 #if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
@@ -243,20 +300,16 @@ namespace flux_foundry {
 
         raw_type_erase_base(raw_type_erase_base&& rhs) noexcept
             : invoker_ { derived::stub } , manager_ { nullptr } {
-            if (rhs.manager_) {
-                rhs.manager_(this->data_, rhs.data_, type_erase_lifespan_op::move);
-                this->invoker_ = rhs.invoker_;
-                this->manager_ = rhs.manager_;
-                rhs.clear();
-            }
+            this->move_from(rhs);
         }
 
+        // moves are noexcept, so the target can be cleared first and rhs moved straight in.
         raw_type_erase_base& operator=(raw_type_erase_base&& rhs) noexcept {
             if (this == &rhs) {
                 return *this;
             }
-            raw_type_erase_base tmp(std::move(rhs));
-            this->swap(tmp);
+            this->clear();
+            this->move_from(rhs);
             return *this;
         }
 
@@ -307,6 +360,7 @@ namespace flux_foundry {
             void emplace(Args &&... args) {
             static_assert(align >= alignof(T*),
                 "SBO placement-new requires buffer alignment >= alignof(T*)");
+            static_assert(detail::sbo_spill<T, buf_size, align>::report(), "");
 
             auto p = flux_foundry_allocator<sizeof(T), alignof(T)>().alloc();
             if (!p) {
@@ -341,24 +395,30 @@ namespace flux_foundry {
                 return;
             }
 
-            LIKELY_IF (this->manager_ && rhs.manager_) {
+            if ((!this->manager_ || this->manager_->trivially_relocatable) &&
+                (!rhs.manager_ || rhs.manager_->trivially_relocatable)) {
+                alignas(align) unsigned char backup[buf_size];
+                memcpy(backup, this->data_, size);
+                memcpy(this->data_, rhs.data_, size);
+                memcpy(rhs.data_, backup, size);
+            } else if (this->manager_ && rhs.manager_) {
                 alignas(align) unsigned char backup[buf_size];
 
-                this->manager_(backup, this->data_, type_erase_lifespan_op::move);
-                this->manager_(nullptr, this->data_, type_erase_lifespan_op::destroy);
+                this->manager_->manage(backup, this->data_, type_erase_lifespan_op::move);
+                this->manager_->manage(nullptr, this->data_, type_erase_lifespan_op::destroy);
 
-                rhs.manager_(this->data_, rhs.data_, type_erase_lifespan_op::move);
-                rhs.manager_(nullptr, rhs.data_, type_erase_lifespan_op::destroy);
+                rhs.manager_->manage(this->data_, rhs.data_, type_erase_lifespan_op::move);
+                rhs.manager_->manage(nullptr, rhs.data_, type_erase_lifespan_op::destroy);
 
-                this->manager_(rhs.data_, backup, type_erase_lifespan_op::move);
-                this->manager_(nullptr, backup, type_erase_lifespan_op::destroy);
+                this->manager_->manage(rhs.data_, backup, type_erase_lifespan_op::move);
+                this->manager_->manage(nullptr, backup, type_erase_lifespan_op::destroy);
             } else {
                 if (this->manager_ && !rhs.manager_) {
-                    this->manager_(rhs.data_, this->data_, type_erase_lifespan_op::move);
-                    this->manager_(nullptr, this->data_, type_erase_lifespan_op::destroy);
+                    this->manager_->manage(rhs.data_, this->data_, type_erase_lifespan_op::move);
+                    this->manager_->manage(nullptr, this->data_, type_erase_lifespan_op::destroy);
                 } else {
-                    rhs.manager_(this->data_, rhs.data_, type_erase_lifespan_op::move);
-                    rhs.manager_(nullptr, rhs.data_, type_erase_lifespan_op::destroy);
+                    rhs.manager_->manage(this->data_, rhs.data_, type_erase_lifespan_op::move);
+                    rhs.manager_->manage(nullptr, rhs.data_, type_erase_lifespan_op::destroy);
                 }
             }
 
@@ -367,9 +427,28 @@ namespace flux_foundry {
             swap(this->manager_, rhs.manager_);
         }
 
+        // requires *this to be empty, leaves rhs empty.
+        void move_from(raw_type_erase_base& rhs) noexcept {
+            auto vtable = rhs.manager_;
+            if (!vtable) {
+                return;
+            }
+
+            LIKELY_IF (vtable->trivially_relocatable) {
+                memcpy(this->data_, rhs.data_, size);
+            } else {
+                vtable->manage(this->data_, rhs.data_, type_erase_lifespan_op::move);
+                vtable->manage(nullptr, rhs.data_, type_erase_lifespan_op::destroy);
+            }
+            this->invoker_ = rhs.invoker_;
+            this->manager_ = vtable;
+            rhs.invoker_ = derived::stub;
+            rhs.manager_ = nullptr;
+        }
+
         void clear() noexcept {
             if (manager_) {
-                manager_(nullptr, data_, type_erase_lifespan_op::destroy);
+                manager_->manage(nullptr, data_, type_erase_lifespan_op::destroy);
                 manager_ = nullptr;
             }
             invoker_ = derived::stub;
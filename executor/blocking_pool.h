@@ -0,0 +1,182 @@
+#ifndef FLUX_FOUNDRY_BLOCKING_POOL_H
+#define FLUX_FOUNDRY_BLOCKING_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "../utility/concurrent_queues.h"
+#include "../task/task_wrapper.h"
+#include "current_executor.h"
+
+namespace flux_foundry {
+    // blocking_pool: elastic thread pool for blocking calls (compression, legacy file APIs ...),
+    // keeps them off the latency-critical executors. Satisfies the executor concept, see await_blocking().
+    //
+    // Execution model:
+    // - any thread may call dispatch(), any worker may run the task
+    // - a worker is started when a task is queued and no worker is parked, up to `max_threads`
+    // - idle workers park on a condition variable, a parked worker that sees no task for
+    //   `keep_alive` exits, so the pool shrinks back to zero threads
+    // - dispatch() on a full queue waits until a worker takes a task
+    // Lifecycle model:
+    // - the destructor runs every queued task, then joins all workers
+    // - dispatch() after destruction started is invalid usage
+    template <size_t capacity = 1024>
+    class blocking_pool {
+        struct worker_slot {
+            std::thread thread;
+            bool busy = false;
+        };
+
+        mpmc_queue<task_wrapper_sbo, capacity> q_;
+
+        std::mutex lock_;
+        std::condition_variable wake_;
+        std::condition_variable drained_;
+        size_t threads_ = 0;
+        size_t parked_ = 0;
+        size_t signaled_ = 0;
+        bool stop_ = false;
+
+        const size_t max_threads_;
+        const std::chrono::steady_clock::duration keep_alive_;
+        std::unique_ptr<worker_slot[]> slots_;
+
+        // must be called with the lock held.
+        bool spawn() noexcept {
+            for (size_t i = 0; i < max_threads_; ++i) {
+                auto& slot = slots_[i];
+                if (slot.busy) {
+                    continue;
+                }
+
+                // the previous owner released the slot as its very last step.
+                if (slot.thread.joinable()) {
+                    slot.thread.join();
+                }
+
+                slot.busy = true;
+                ++threads_;
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+                try {
+#endif
+                    slot.thread = std::thread([this, i]() noexcept { work(i); });
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+                } catch (...) {
+                    slot.busy = false;
+                    --threads_;
+                    return false;
+                }
+#endif
+                return true;
+            }
+            return false;
+        }
+
+        void work(size_t slot) noexcept {
+            // await_sticky() steps submitted from a pool task resume on the pool.
+            current_executor_scope scope(this);
+            std::unique_lock<std::mutex> lk(lock_, std::defer_lock);
+            for (;;) {
+                auto t = q_.try_pop();
+                if (t) {
+                    t.get()();
+                    continue;
+                }
+
+                lk.lock();
+                if (!q_.empty()) {
+                    lk.unlock();
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                if (stop_) {
+                    break;
+                }
+
+                ++parked_;
+                bool woke = wake_.wait_for(lk, keep_alive_, [this]() noexcept {
+                    return stop_ || !q_.empty();
+                });
+                --parked_;
+                if (signaled_) {
+                    --signaled_;
+                }
+
+                if (!woke) {
+                    break;
+                }
+                lk.unlock();
+            }
+
+            --threads_;
+            slots_[slot].busy = false;
+            drained_.notify_all();
+        }
+
+    public:
+        explicit blocking_pool(size_t max_threads = 4,
+            std::chrono::steady_clock::duration keep_alive = std::chrono::seconds(5))
+            : max_threads_(max_threads ? max_threads : 1),
+              keep_alive_(keep_alive),
+              slots_(new worker_slot[max_threads ? max_threads : 1]) {
+        }
+
+        blocking_pool(const blocking_pool&) = delete;
+        blocking_pool& operator=(const blocking_pool&) = delete;
+
+        ~blocking_pool() noexcept {
+            std::unique_lock<std::mutex> lk(lock_);
+            stop_ = true;
+            wake_.notify_all();
+            drained_.wait(lk, [this]() noexcept { return threads_ == 0; });
+            lk.unlock();
+
+            for (size_t i = 0; i < max_threads_; ++i) {
+                if (slots_[i].thread.joinable()) {
+                    slots_[i].thread.join();
+                }
+            }
+
+            // only reachable when no worker could ever be started.
+            for (auto t = q_.try_pop(); t; t = q_.try_pop()) {
+                t.get()();
+            }
+        }
+
+        void dispatch(task_wrapper_sbo&& task) noexcept {
+            q_.wait_and_emplace(std::move(task));
+
+            bool stranded = false;
+            {
+                std::lock_guard<std::mutex> lk(lock_);
+                if (parked_ > signaled_) {
+                    ++signaled_;
+                    wake_.notify_one();
+                } else if (threads_ < max_threads_) {
+                    stranded = !spawn() && threads_ == 0;
+                }
+            }
+
+            // no worker could be started at all, do not strand the task.
+            UNLIKELY_IF (stranded) {
+                for (auto t = q_.try_pop(); t; t = q_.try_pop()) {
+                    t.get()();
+                }
+            }
+        }
+
+        // number of live workers, for diagnostics.
+        size_t threads() noexcept {
+            std::lock_guard<std::mutex> lk(lock_);
+            return threads_;
+        }
+    };
+}
+
+#endif // FLUX_FOUNDRY_BLOCKING_POOL_H
@@ -0,0 +1,114 @@
+#ifndef FLUX_FOUNDRY_CURRENT_EXECUTOR_H
+#define FLUX_FOUNDRY_CURRENT_EXECUTOR_H
+
+#include "../task/task_wrapper.h"
+
+namespace flux_foundry {
+    // number of nested continuations an executor runs inline on its own thread before it enqueues
+    // again: `static constexpr size_t inline_hop_budget` of the executor type if present,
+    // FLUX_FOUNDRY_INLINE_HOP_BUDGET otherwise, 0 turns coalescing off.
+    template <typename Executor, typename = void>
+    struct inline_hop_budget_of {
+        static constexpr size_t value = FLUX_FOUNDRY_INLINE_HOP_BUDGET;
+    };
+
+    template <typename Executor>
+    struct inline_hop_budget_of<Executor, void_t<decltype(Executor::inline_hop_budget)>> {
+        static constexpr size_t value = Executor::inline_hop_budget;
+    };
+
+    // executor_ref: type-erased, non-owning reference to an executor.
+    // It is pointer-like (`ref->dispatch(task)`), so it satisfies the flow executor concept.
+    //
+    // Executors publish themselves as the thread's current executor while they run tasks
+    // (see current_executor_scope). await_sticky() reads it at submit time and resumes there,
+    // so the continuation runs where the flow's state was last touched. It is also the marker
+    // behind running_in_this_thread() of the bundled executors.
+    class executor_ref {
+        struct vtable_t {
+            void (*dispatch)(void*, task_wrapper_sbo&&) noexcept;
+            size_t inline_hop_budget;
+        };
+
+        template <typename Executor>
+        struct vtable_of {
+            static void dispatch(void* exec, task_wrapper_sbo&& task) noexcept {
+                static_cast<Executor*>(exec)->dispatch(std::move(task));
+            }
+
+            static constexpr vtable_t value{ &dispatch, inline_hop_budget_of<Executor>::value };
+        };
+
+        void* exec_;
+        const vtable_t* vtable_;
+
+    public:
+        executor_ref() noexcept
+            : exec_(nullptr), vtable_(nullptr) {
+        }
+
+        template <typename Executor>
+        explicit executor_ref(Executor* exec) noexcept
+            : exec_(exec), vtable_(&vtable_of<Executor>::value) {
+        }
+
+        explicit operator bool() const noexcept {
+            return exec_ != nullptr;
+        }
+
+        bool operator==(const executor_ref& rhs) const noexcept {
+            return exec_ == rhs.exec_;
+        }
+
+        bool operator!=(const executor_ref& rhs) const noexcept {
+            return exec_ != rhs.exec_;
+        }
+
+        bool refers_to(const void* exec) const noexcept {
+            return exec_ == exec;
+        }
+
+        executor_ref* operator->() noexcept {
+            return this;
+        }
+
+        void dispatch(task_wrapper_sbo&& task) noexcept {
+            vtable_->dispatch(exec_, std::move(task));
+        }
+
+        // inline_hop_budget_of the referenced executor type, 0 for an empty ref.
+        size_t inline_hop_budget() const noexcept {
+            return vtable_ ? vtable_->inline_hop_budget : 0;
+        }
+
+        // the executor running the calling thread's current task, empty outside of any executor.
+        static executor_ref& current() noexcept {
+            thread_local executor_ref ref;
+            return ref;
+        }
+    };
+
+    template <typename Executor>
+    constexpr executor_ref::vtable_t executor_ref::vtable_of<Executor>::value;
+
+    // publishes `exec` as the current executor for the scope, restores the outer one on exit.
+    class current_executor_scope {
+        executor_ref outer_;
+
+    public:
+        template <typename Executor>
+        explicit current_executor_scope(Executor* exec) noexcept
+            : outer_(executor_ref::current()) {
+            executor_ref::current() = executor_ref(exec);
+        }
+
+        current_executor_scope(const current_executor_scope&) = delete;
+        current_executor_scope& operator=(const current_executor_scope&) = delete;
+
+        ~current_executor_scope() noexcept {
+            executor_ref::current() = outer_;
+        }
+    };
+}
+
+#endif // FLUX_FOUNDRY_CURRENT_EXECUTOR_H
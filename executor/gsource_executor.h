@@ -17,6 +17,7 @@
 
 #include "../utility/concurrent_queues.h"
 #include "../task/task_wrapper.h"
+#include "current_executor.h"
 
 namespace flux_foundry {
     template <size_t capacity_>
@@ -41,6 +42,9 @@ namespace flux_foundry {
                     if (r <= 0) break;
                 }
 
+                // the source may recurse, the scope restores the outer executor on the way out.
+                current_executor_scope scope(&self->executor_ref_);
+
                 bool queue_became_empty = false;
                 for (int c = 0; c < gsource_executor::max_task_per_round; ++c) {
                     auto tsk = self->executor_ref_.q_.try_pop();
@@ -150,6 +154,12 @@ namespace flux_foundry {
             return 0;
         }
 
+        // true while this thread runs a batch of this executor's tasks, lets flow continuations
+        // targeting it run inline there (see flow_impl::inline_hop_traits).
+        bool running_in_this_thread() const noexcept {
+            return executor_ref::current().refers_to(this);
+        }
+
         void dispatch(task_wrapper_sbo&& task) noexcept {
             assert(task && "attempting to dispatch an empty task into the executor.");
             if (!task) {
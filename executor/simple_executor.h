@@ -10,9 +10,12 @@
 #include "../utility/back_off.h"
 #include "../utility/concurrent_queues.h"
 #include "../task/task_wrapper.h"
+#include "current_executor.h"
 
 namespace flux_foundry {
-    template <size_t capacity>
+    // task_t is the task type the queue holds. Flow continuations targeting the executor are built
+    // in it directly (task_type), tasks dispatched as task_wrapper_sbo are wrapped into it.
+    template <size_t capacity, typename task_t = task_wrapper_sbo>
     class simple_executor {
         // Execution model:
         // - many producer threads may call dispatch()
@@ -27,12 +30,7 @@ namespace flux_foundry {
         static constexpr size_t pending_unit = size_t{1} << pending_shift;
 
         padded_t<std::atomic<size_t>> ctrl_{0};
-        mpsc_queue<task_wrapper_sbo, capacity> q;
-
-        static simple_executor*& current() noexcept {
-            thread_local simple_executor* executor = nullptr;
-            return executor;
-        }
+        mpsc_queue<task_t, capacity> q;
 
         static bool is_running(size_t ctrl) noexcept {
             return (ctrl & running_flag) != 0;
@@ -46,13 +44,15 @@ namespace flux_foundry {
             return ctrl >> pending_shift;
         }
     public:
+        using task_type = task_t;
+
         simple_executor() noexcept = default;
 
         // Thread-safe for producer side.
         // Tasks that "buy a ticket" (pending++) are guaranteed to be either:
         // - enqueued and later consumed by run(), or
         // - executed inline by the consumer thread when queue is full.
-        void dispatch(task_wrapper_sbo&& sbo) noexcept {
+        void dispatch(task_type&& sbo) noexcept {
             auto& ctrl = ctrl_.get();
             for (backoff_strategy<> gate_backoff;; gate_backoff.yield()) {
                 auto state = ctrl.load(std::memory_order_acquire);
@@ -69,7 +69,7 @@ namespace flux_foundry {
 
             backoff_strategy<> backoff;
             for (; !q.try_emplace(std::move(sbo)); backoff.yield()) {
-                if (current() == this) {
+                if (running_in_this_thread()) {
                     sbo();
                     ctrl.fetch_sub(pending_unit, std::memory_order_acq_rel);
                     break;
@@ -84,6 +84,21 @@ namespace flux_foundry {
             }
         }
 
+        // a task_wrapper_sbo fits the inline buffer of a larger task_t, wrapping it does not allocate.
+        template <typename task_t_ = task_t,
+            std::enable_if_t<!std::is_same<task_t_, task_wrapper_sbo>::value>* = nullptr>
+        void dispatch(task_wrapper_sbo&& sbo) noexcept {
+            static_assert(detail::can_enable_sbo<task_wrapper_sbo, task_t_::sbo_size, task_t_::align>::value,
+                "task_t must hold a task_wrapper_sbo inline.");
+            dispatch(task_type(std::move(sbo)));
+        }
+
+        // true on the thread inside run(), lets flow continuations targeting this executor
+        // run inline there (see flow_impl::inline_hop_traits).
+        bool running_in_this_thread() const noexcept {
+            return executor_ref::current().refers_to(this);
+        }
+
         // Contract:
         // - `run()` must be called by at most one thread at a time for this executor instance.
         // - `run()` must NOT be re-entered or nested on the same thread (e.g., calling `run()` from a task).
@@ -103,8 +118,8 @@ namespace flux_foundry {
                 }
             }
 
-            assert(current() == nullptr && "simple_executor::run() must not be nested/re-entered on the same thread");
-            current() = this;
+            assert(!running_in_this_thread() && "simple_executor::run() must not be re-entered on the same thread");
+            current_executor_scope scope(this);
             for (backoff_strategy<> backoff;; backoff.yield()) {
                 auto p = q.try_pop();
                 if (p) {
@@ -123,7 +138,6 @@ namespace flux_foundry {
                 }
             }
 
-            current() = nullptr;
             ctrl.fetch_and(~running_flag, std::memory_order_release);
         }
         
@@ -0,0 +1,310 @@
+#ifndef FLUX_FOUNDRY_BATCHED_EXTERNAL_ASYNC_H
+#define FLUX_FOUNDRY_BATCHED_EXTERNAL_ASYNC_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+#include "../utility/back_off.h"
+#include "external_async_awaitable.h"
+
+namespace flux_foundry {
+namespace extension {
+
+namespace detail {
+
+// check size_t OP::submit_batch(context_t**, size_t, callback, user_data*) noexcept;
+template<typename OP, typename = void>
+struct submit_batch_prob : std::false_type {};
+
+template<typename OP>
+struct submit_batch_prob<OP, void_t<decltype(OP::submit_batch)>> : conjunction<
+    std::is_convertible<invoke_result_t<decltype(&OP::submit_batch),
+        typename OP::context_t**, size_t, external_async_callback_fp_t, external_async_callback_param_t*>, size_t>,
+    std::integral_constant<bool, noexcept(OP::submit_batch(
+        std::declval<typename OP::context_t**>(),
+        std::declval<size_t>(),
+        std::declval<external_async_callback_fp_t>(),
+        std::declval<external_async_callback_param_t*>()))>> {};
+
+template<typename OP>
+constexpr bool submit_batch_prob_v = submit_batch_prob<OP>::value;
+
+} // namespace detail
+
+template<typename external_async_operator_t, typename Stage>
+struct batched_external_async_awaitable;
+
+// external_async_batcher: per-executor staging buffer for external async operations.
+//
+// Runners stage their initialized contexts here instead of submitting them one by one.
+// A staged batch is handed to the backend in one call when:
+// - `max_batch` contexts are staged (the runner staging the last one submits the batch),
+// - the executor's current tick ends: staging into an empty buffer queues one flush task on
+//   `exec`, which runs behind the work already queued there,
+// - the oldest staged context waited `max_delay` (checked on staging and by poll()).
+//
+// If OP provides
+//     size_t OP::submit_batch(context_t** contexts, size_t n,
+//         external_async_callback_fp_t callback, external_async_callback_param_t* user_data) noexcept;
+// the batch goes through it: `callback(user_data[i])` must be called once per accepted context,
+// the return value is the number of leading contexts accepted, the rest fail with
+// async_submission_failed_error. Otherwise the batch falls back to OP::submit per context.
+//
+// The batcher is borrowed by the blueprint, it must outlive every runner and the flush task it queued.
+template<typename external_async_operator_t, typename Executor, size_t capacity = 64>
+class external_async_batcher {
+    static_assert(capacity > 0, "capacity must be greater than 0");
+    static_assert(flow_impl::check_executor<Executor>::value,
+        "Executor must be pointer-like and support "
+        "noexcept exec->dispatch(task_wrapper_sbo).");
+
+public:
+    using awaitable_t = batched_external_async_awaitable<external_async_operator_t, external_async_batcher>;
+    using context_t = typename external_async_operator_t::context_t;
+    using clock = std::chrono::steady_clock;
+
+private:
+    std::atomic<bool> locked_{false};
+    bool armed_ = false;
+    size_t size_ = 0;
+    clock::time_point first_at_;
+    awaitable_t* staged_[capacity];
+
+    Executor exec_;
+    size_t max_batch_;
+    clock::duration max_delay_;
+
+    void lock() noexcept {
+        for (backoff_strategy<> backoff;; backoff.yield()) {
+            if (!locked_.load(std::memory_order_relaxed)
+                && !locked_.exchange(true, std::memory_order_acquire)) {
+                return;
+            }
+        }
+    }
+
+    void unlock() noexcept {
+        locked_.store(false, std::memory_order_release);
+    }
+
+    // must be called with the lock held.
+    size_t take(awaitable_t** out) noexcept {
+        auto n = size_;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = staged_[i];
+        }
+        size_ = 0;
+        return n;
+    }
+
+    static void submit(awaitable_t** batch, size_t n) noexcept {
+        submit(batch, n, std::integral_constant<bool, detail::submit_batch_prob_v<external_async_operator_t>>{});
+    }
+
+    static void submit(awaitable_t** batch, size_t n, std::true_type /* submit_batch */) noexcept {
+        context_t* ctxs[capacity];
+        external_async_callback_param_t params[capacity];
+        for (size_t i = 0; i < n; ++i) {
+            ctxs[i] = &batch[i]->ctx;
+            params[i] = batch[i];
+        }
+
+        size_t accepted = external_async_operator_t::submit_batch(ctxs, n, awaitable_t::on_complete, params);
+        for (size_t i = accepted < n ? accepted : n; i < n; ++i) {
+            awaitable_t::on_submit_failed(batch[i]);
+        }
+    }
+
+    static void submit(awaitable_t** batch, size_t n, std::false_type /* submit per context */) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            UNLIKELY_IF (external_async_operator_t::submit(&batch[i]->ctx, awaitable_t::on_complete, batch[i]) != 0) {
+                awaitable_t::on_submit_failed(batch[i]);
+            }
+        }
+    }
+
+    void on_tick() noexcept {
+        awaitable_t* batch[capacity];
+        lock();
+        armed_ = false;
+        auto n = take(batch);
+        unlock();
+
+        LIKELY_IF (n) {
+            submit(batch, n);
+        }
+    }
+
+public:
+    external_async_batcher(Executor exec, size_t max_batch = capacity,
+        clock::duration max_delay = std::chrono::microseconds(100)) noexcept
+        : exec_(std::move(exec)),
+          max_batch_(max_batch == 0 || max_batch > capacity ? capacity : max_batch),
+          max_delay_(max_delay) {
+    }
+
+    external_async_batcher(const external_async_batcher&) = delete;
+    external_async_batcher& operator=(const external_async_batcher&) = delete;
+
+    // called by the awaitable's submit(), aw is submitted (or failed) by whichever trigger fires first.
+    void stage(awaitable_t* aw) noexcept {
+        awaitable_t* batch[capacity];
+        size_t n = 0;
+        bool arm = false;
+
+        lock();
+        const auto now = clock::now();
+        UNLIKELY_IF (size_ == 0) {
+            first_at_ = now;
+        }
+        staged_[size_++] = aw;
+        UNLIKELY_IF (size_ >= max_batch_ || now - first_at_ >= max_delay_) {
+            n = take(batch);
+        } else if (!armed_) {
+            armed_ = arm = true;
+        }
+        unlock();
+
+        UNLIKELY_IF (n) {
+            submit(batch, n);
+        }
+
+        if (arm) {
+            exec_->dispatch(task_wrapper_sbo([this]() noexcept {
+                on_tick();
+            }));
+        }
+    }
+
+    // submits the staged batch if its oldest context waited max_delay. returns true if it did.
+    bool poll() noexcept {
+        awaitable_t* batch[capacity];
+        size_t n = 0;
+        lock();
+        if (size_ && clock::now() - first_at_ >= max_delay_) {
+            n = take(batch);
+        }
+        unlock();
+
+        if (n) {
+            submit(batch, n);
+            return true;
+        }
+        return false;
+    }
+
+    // submits whatever is staged.
+    bool flush() noexcept {
+        awaitable_t* batch[capacity];
+        lock();
+        auto n = take(batch);
+        unlock();
+
+        if (n) {
+            submit(batch, n);
+            return true;
+        }
+        return false;
+    }
+};
+
+// same contract as external_async_awaitable, but submit() stages the context into a batcher.
+template<typename external_async_operator_t, typename Stage>
+struct batched_external_async_awaitable final :
+    external_async_awaitable_base<batched_external_async_awaitable<external_async_operator_t, Stage>, external_async_operator_t> {
+    using base = external_async_awaitable_base<batched_external_async_awaitable<external_async_operator_t, Stage>, external_async_operator_t>;
+    using typename base::async_result_type;
+
+    static_assert(detail::submit_batch_prob_v<external_async_operator_t> || detail::submit_prob_v<external_async_operator_t>,
+        "there should be static function whose signature is like:"
+        "size_t external_async_operator_t::submit_batch(typename external_async_operator_t::context_t**, size_t, external_async_callback_fp_t, external_async_callback_param_t*) noexcept;\n"
+        "or int external_async_operator_t::submit(typename external_async_operator_t::context_t*, external_async_callback_fp_t, external_async_callback_param_t) noexcept;\n"
+        "which is used to submit the external async operations.\n");
+
+    Stage* stage;
+    std::atomic_flag not_ready = ATOMIC_FLAG_INIT;
+
+    template<typename param_t>
+    batched_external_async_awaitable(Stage* stage_, param_t&& param)
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+        noexcept
+#endif
+        : base(std::forward<param_t>(param)), stage(stage_) {
+        not_ready.test_and_set(std::memory_order_relaxed);
+    }
+
+    static void on_complete(external_async_callback_param_t param) noexcept {
+        auto self = static_cast<batched_external_async_awaitable*>(param);
+        if (self->not_ready.test_and_set(std::memory_order_acquire)) {
+            return;
+        }
+        self->complete();
+    }
+
+    // the backend rejected the context, it will never call on_complete for it.
+    static void on_submit_failed(batched_external_async_awaitable* self) noexcept {
+        if (self->not_ready.test_and_set(std::memory_order_acquire)) {
+            return;
+        }
+        self->resume(async_result_type(error_tag, async_submission_failed_error<external_async_error_t>::make()));
+    }
+
+    int submit() noexcept {
+        not_ready.clear(std::memory_order_release);
+        stage->stage(this);
+        return 0;
+    }
+};
+
+} // namespace extension
+
+namespace flow_impl {
+    template <typename Executor, typename external_async_operator_t, typename Stage>
+    struct batched_external_async_node {
+        static_assert(check_executor<Executor>::value,
+            "Executor must be pointer-like and support "
+            "noexcept exec->dispatch(task_wrapper_sbo).");
+
+        Executor e;
+        Stage* stage;
+    };
+
+    template <typename I, typename O, typename... Nodes, typename Executor, typename external_async_operator_t, typename Stage>
+    auto operator|(flow_blueprint<I, O, Nodes...>&& bp, batched_external_async_node<Executor, external_async_operator_t, Stage>&& a) {
+        using awaitable_t = extension::batched_external_async_awaitable<external_async_operator_t, Stage>;
+        using F_O = typename awaitable_t::async_result_type;
+        using wrapper_t = dispatch_wrapper_t<Executor>;
+        using factory_t = bound_awaitable_factory<awaitable_t, Stage>;
+
+        return std::move(bp) | flow_async_node<O, F_O, wrapper_t, identity, factory_t> {
+            wrapper_t{std::move(a.e)}, identity{}, factory_t{a.stage}
+        };
+    }
+}
+
+// Same as await_external_async<OP>(), but contexts from concurrent runners are staged in `stage`
+// and handed to the backend in batches, see extension::external_async_batcher.
+template<typename external_async_operator_t, typename Executor, typename StageExecutor, size_t capacity,
+    std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+auto await_batched_external_async(extension::external_async_batcher<external_async_operator_t, StageExecutor, capacity>& stage,
+    Executor&& executor_to_resume) noexcept {
+    using E = std::decay_t<Executor>;
+    using stage_t = extension::external_async_batcher<external_async_operator_t, StageExecutor, capacity>;
+    return flow_impl::batched_external_async_node<E, external_async_operator_t, stage_t> {
+        std::forward<Executor>(executor_to_resume), &stage
+    };
+}
+
+template<typename external_async_operator_t, typename StageExecutor, size_t capacity>
+auto await_batched_external_async(extension::external_async_batcher<external_async_operator_t, StageExecutor, capacity>& stage) noexcept {
+    using E = flow_impl::inline_executor*;
+    using stage_t = extension::external_async_batcher<external_async_operator_t, StageExecutor, capacity>;
+    return flow_impl::batched_external_async_node<E, external_async_operator_t, stage_t> {
+        flow_impl::inline_executor::executor(), &stage
+    };
+}
+
+} // namespace flux_foundry
+
+#endif
@@ -113,19 +113,46 @@ struct collect_prob<OP, void_t<decltype(OP::collect)>> : conjunction<
 template<typename OP>
 constexpr bool collect_prob_v = collect_prob<OP>::value;
 
+// check OP::result_pool().recycle(result_t) noexcept; (optional)
+template<typename OP, typename = void>
+struct result_pool_prob : std::false_type {};
+
+template<typename OP>
+struct result_pool_prob<OP, void_t<decltype(OP::result_pool().recycle(std::declval<typename OP::result_t>()))>> :
+    std::integral_constant<bool, noexcept(OP::result_pool().recycle(std::declval<typename OP::result_t>()))> {};
+
+template<typename OP>
+constexpr bool result_pool_prob_v = result_pool_prob<OP>::value;
+
 } // namespace detail
 
+// frees a result with OP::free_result, or hands it back to OP::result_pool() if the operator has one
+// (see external_async_result_pool.h).
 template<typename external_async_operator_t>
 struct external_async_result_deleter {
     void operator()(typename external_async_operator_t::result_t result) noexcept {
+        release(result, std::integral_constant<bool, detail::result_pool_prob_v<external_async_operator_t>>{});
+    }
+
+private:
+    static void release(typename external_async_operator_t::result_t result, std::true_type /* pooled */) noexcept {
+        external_async_operator_t::result_pool().recycle(result);
+    }
+
+    static void release(typename external_async_operator_t::result_t result, std::false_type) noexcept {
         external_async_operator_t::free_result(result);
     }
 };
 
-template<typename external_async_operator_t>
-struct external_async_awaitable final :
+// context lifetime and result conversion shared by every awaitable over an external async operator
+// (external_async_awaitable, batched_external_async_awaitable, polled_external_async_awaitable).
+// It initializes the context from the step input, destroys it with the awaitable, and turns
+// OP::collect() into the async result in complete(). The derived awaitable only submits the
+// context and calls complete() exactly once when the operation finished.
+template<typename derived, typename external_async_operator_t>
+struct external_async_awaitable_base :
     fast_awaitable_base<
-        external_async_awaitable<external_async_operator_t>,
+        derived,
         std::unique_ptr<
             std::remove_pointer_t<typename external_async_operator_t::result_t>,
             external_async_result_deleter<external_async_operator_t>>,
@@ -153,11 +180,6 @@ struct external_async_awaitable final :
         "void external_async_operator_t::destroy_ctx(typename external_async_operator_t::context_t*) noexcept;\n"
         "which is used to destroy the context struct.\n");
 
-    static_assert(detail::submit_prob_v<external_async_operator_t>,
-        "there should be static function whose signature is like:"
-        "int external_async_operator_t::submit(typename external_async_operator_t::context_t*, external_async_callback_fp_t, external_async_callback_param_t) noexcept;\n"
-        "which is used to submit the external async operation.\n");
-
     static_assert(detail::collect_prob_v<external_async_operator_t>,
         "there should be static function whose signature is like:"
         "typename external_async_operator_t::result_t external_async_operator_t::collect(typename external_async_operator_t::context_t*) noexcept;\n"
@@ -165,7 +187,6 @@ struct external_async_awaitable final :
 
     using context_t = typename external_async_operator_t::context_t;
 
-    std::atomic_flag not_ready = ATOMIC_FLAG_INIT;
     context_t ctx{};
 
 #if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
@@ -173,12 +194,11 @@ struct external_async_awaitable final :
 #endif
 
     template<typename param_t>
-    explicit external_async_awaitable(param_t&& param)
+    explicit external_async_awaitable_base(param_t&& param)
 #if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
         noexcept
 #endif
     {
-        not_ready.test_and_set(std::memory_order_relaxed);
         static_assert(detail::context_init_ctx_prob_v<
                 external_async_operator_t,
                 typename std::decay_t<param_t>::value_type*>,
@@ -200,12 +220,12 @@ struct external_async_awaitable final :
     }
 #endif
 
-    external_async_awaitable(const external_async_awaitable&) = delete;
-    external_async_awaitable& operator=(const external_async_awaitable&) = delete;
-    external_async_awaitable(external_async_awaitable&&) = delete;
-    external_async_awaitable& operator=(external_async_awaitable&&) = delete;
+    external_async_awaitable_base(const external_async_awaitable_base&) = delete;
+    external_async_awaitable_base& operator=(const external_async_awaitable_base&) = delete;
+    external_async_awaitable_base(external_async_awaitable_base&&) = delete;
+    external_async_awaitable_base& operator=(external_async_awaitable_base&&) = delete;
 
-    ~external_async_awaitable() noexcept {
+    ~external_async_awaitable_base() noexcept {
 #if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
         if (initialized)
 #endif
@@ -214,15 +234,11 @@ struct external_async_awaitable final :
         }
     }
 
-    static void on_complete(external_async_callback_param_t param) noexcept {
-        auto self = static_cast<external_async_awaitable*>(param);
-        if (self->not_ready.test_and_set(std::memory_order_acquire)) {
-            return;
-        }
-
-        auto res = external_async_operator_t::collect(&self->ctx);
+    // collects the finished operation and resumes with it, must be called exactly once.
+    void complete() noexcept {
+        auto res = external_async_operator_t::collect(&ctx);
         LIKELY_IF(res) {
-            self->resume(async_result_type(value_tag, res, external_async_result_deleter<external_async_operator_t>{}));
+            this->resume(async_result_type(value_tag, res, external_async_result_deleter<external_async_operator_t>{}));
         } else {
 #if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
             async_result_type err(error_tag, nullptr);
@@ -231,16 +247,46 @@ struct external_async_awaitable final :
             } catch (...) {
                 err.emplace_error(std::current_exception());
             }
-            self->resume(std::move(err));
+            this->resume(std::move(err));
 #else
-            self->resume(async_result_type(error_tag, std::make_error_code(std::errc::io_error)));
+            this->resume(async_result_type(error_tag, std::make_error_code(std::errc::io_error)));
 #endif
         }
     }
+};
+
+template<typename external_async_operator_t>
+struct external_async_awaitable final :
+    external_async_awaitable_base<external_async_awaitable<external_async_operator_t>, external_async_operator_t> {
+    using base = external_async_awaitable_base<external_async_awaitable<external_async_operator_t>, external_async_operator_t>;
+
+    static_assert(detail::submit_prob_v<external_async_operator_t>,
+        "there should be static function whose signature is like:"
+        "int external_async_operator_t::submit(typename external_async_operator_t::context_t*, external_async_callback_fp_t, external_async_callback_param_t) noexcept;\n"
+        "which is used to submit the external async operation.\n");
+
+    std::atomic_flag not_ready = ATOMIC_FLAG_INIT;
+
+    template<typename param_t>
+    explicit external_async_awaitable(param_t&& param)
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+        noexcept
+#endif
+        : base(std::forward<param_t>(param)) {
+        not_ready.test_and_set(std::memory_order_relaxed);
+    }
+
+    static void on_complete(external_async_callback_param_t param) noexcept {
+        auto self = static_cast<external_async_awaitable*>(param);
+        if (self->not_ready.test_and_set(std::memory_order_acquire)) {
+            return;
+        }
+        self->complete();
+    }
 
     int submit() noexcept {
         not_ready.clear(std::memory_order_release);
-        return external_async_operator_t::submit(&ctx, on_complete, this);
+        return external_async_operator_t::submit(&this->ctx, on_complete, this);
     }
 };
 
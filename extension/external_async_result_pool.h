@@ -0,0 +1,56 @@
+#ifndef FLUX_FOUNDRY_EXTERNAL_ASYNC_RESULT_POOL_H
+#define FLUX_FOUNDRY_EXTERNAL_ASYNC_RESULT_POOL_H
+
+#include <cstddef>
+#include <memory>
+
+#include "../utility/static_stack.h"
+
+namespace flux_foundry {
+namespace extension {
+
+// external_async_result_pool: lock-free free list of result objects of an external async operation.
+//
+// Meant for results that own expensive buffers (pinned host memory, mmapped regions, ...):
+// - OP::collect() takes a retired result with acquire() and refills it, or allocates a new one
+//   when acquire() returns nullptr,
+// - an OP that provides `static external_async_result_pool<...>& OP::result_pool() noexcept`
+//   gets its results recycled here by external_async_result_deleter instead of OP::free_result.
+// At most `capacity` idle results are kept, the surplus and whatever is left on destruction
+// is freed with `Release`.
+template<typename T, size_t capacity = 16, typename Release = std::default_delete<T>>
+class external_async_result_pool {
+    static_stack<T*, capacity> idle_;
+    Release release_;
+
+public:
+    explicit external_async_result_pool(Release release = Release()) noexcept
+        : release_(std::move(release)) {
+    }
+
+    external_async_result_pool(const external_async_result_pool&) = delete;
+    external_async_result_pool& operator=(const external_async_result_pool&) = delete;
+
+    ~external_async_result_pool() noexcept {
+        for (T* p = acquire(); p; p = acquire()) {
+            release_(p);
+        }
+    }
+
+    // returns an idle result, or nullptr if there is none.
+    T* acquire() noexcept {
+        auto p = idle_.pop();
+        return p.has_value() ? p.get() : nullptr;
+    }
+
+    void recycle(T* p) noexcept {
+        UNLIKELY_IF (p && !idle_.push(p)) {
+            release_(p);
+        }
+    }
+};
+
+} // namespace extension
+} // namespace flux_foundry
+
+#endif
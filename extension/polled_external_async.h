@@ -0,0 +1,226 @@
+#ifndef FLUX_FOUNDRY_POLLED_EXTERNAL_ASYNC_H
+#define FLUX_FOUNDRY_POLLED_EXTERNAL_ASYNC_H
+
+#include <atomic>
+
+#include "external_async_awaitable.h"
+
+namespace flux_foundry {
+namespace extension {
+
+namespace detail {
+
+// check int OP::start(context_t*) noexcept;
+template<typename OP, typename = void>
+struct start_prob : std::false_type {};
+
+template<typename OP>
+struct start_prob<OP, void_t<decltype(OP::start)>> : conjunction<
+    std::is_convertible<invoke_result_t<decltype(&OP::start), typename OP::context_t*>, int>,
+    std::integral_constant<bool, noexcept(OP::start(std::declval<typename OP::context_t*>()))>> {};
+
+template<typename OP>
+constexpr bool start_prob_v = start_prob<OP>::value;
+
+// check bool OP::poll(context_t*) noexcept;
+template<typename OP, typename = void>
+struct poll_prob : std::false_type {};
+
+template<typename OP>
+struct poll_prob<OP, void_t<decltype(OP::poll)>> : conjunction<
+    std::is_convertible<invoke_result_t<decltype(&OP::poll), typename OP::context_t*>, bool>,
+    std::integral_constant<bool, noexcept(OP::poll(std::declval<typename OP::context_t*>()))>> {};
+
+template<typename OP>
+constexpr bool poll_prob_v = poll_prob<OP>::value;
+
+} // namespace detail
+
+template<typename external_async_operator_t, typename Poller>
+struct polled_external_async_awaitable;
+
+// external_async_poller: drives polled external async operations from one executor.
+//
+// The operator has no completion callback. Instead it provides
+//     int OP::start(context_t*) noexcept;     // 0 if the operation was started
+//     bool OP::poll(context_t*) noexcept;     // true once the operation completed
+// Started contexts are pushed to the poller's inbox (a lock-free intrusive stack). While any
+// context is in flight the poller keeps one tick task queued on `exec`: each tick adopts the inbox,
+// polls every in-flight context once, and collects and resumes the completed ones right there,
+// on the executor thread. The in-flight list is only touched by the tick, so completion needs
+// neither a cross-thread handoff nor an atomic flag. The tick requeues itself behind the other
+// work on `exec` and stops once nothing is in flight.
+//
+// The poller is borrowed by the blueprint, it must outlive every runner and the tick it queued.
+template<typename external_async_operator_t, typename Executor>
+class external_async_poller {
+    static_assert(flow_impl::check_executor<Executor>::value,
+        "Executor must be pointer-like and support "
+        "noexcept exec->dispatch(task_wrapper_sbo).");
+
+public:
+    using awaitable_t = polled_external_async_awaitable<external_async_operator_t, external_async_poller>;
+
+private:
+    std::atomic<awaitable_t*> inbox_{nullptr};
+    std::atomic<bool> active_{false};
+    awaitable_t* in_flight_ = nullptr;
+
+    Executor exec_;
+
+    void arm() noexcept {
+        exec_->dispatch(task_wrapper_sbo([this]() noexcept {
+            on_tick();
+        }));
+    }
+
+    void adopt() noexcept {
+        auto aw = inbox_.exchange(nullptr, std::memory_order_acquire);
+        while (aw) {
+            auto next = aw->next;
+            aw->next = in_flight_;
+            in_flight_ = aw;
+            aw = next;
+        }
+    }
+
+    void poll_in_flight() noexcept {
+        for (auto link = &in_flight_; *link;) {
+            auto aw = *link;
+            if (external_async_operator_t::poll(&aw->ctx)) {
+                *link = aw->next;
+                aw->complete();
+            } else {
+                link = &aw->next;
+            }
+        }
+    }
+
+    void on_tick() noexcept {
+        for (;;) {
+            adopt();
+            poll_in_flight();
+            LIKELY_IF (in_flight_) {
+                arm();
+                return;
+            }
+
+            // pairs with the inbox push then active_ check in enqueue().
+            active_.store(false, std::memory_order_seq_cst);
+            if (!inbox_.load(std::memory_order_seq_cst) || active_.exchange(true, std::memory_order_seq_cst)) {
+                return;
+            }
+        }
+    }
+
+public:
+    explicit external_async_poller(Executor exec) noexcept
+        : exec_(std::move(exec)) {
+    }
+
+    external_async_poller(const external_async_poller&) = delete;
+    external_async_poller& operator=(const external_async_poller&) = delete;
+
+    // called by the awaitable's submit() once OP::start() succeeded.
+    void enqueue(awaitable_t* aw) noexcept {
+        auto head = inbox_.load(std::memory_order_relaxed);
+        do {
+            aw->next = head;
+        } while (!inbox_.compare_exchange_weak(head, aw,
+            std::memory_order_seq_cst, std::memory_order_relaxed));
+
+        if (!active_.load(std::memory_order_seq_cst) && !active_.exchange(true, std::memory_order_seq_cst)) {
+            arm();
+        }
+    }
+};
+
+// same contract as external_async_awaitable, but completion is observed by an external_async_poller.
+// the poller's tick calls complete() exactly once, after OP::poll() reported completion.
+template<typename external_async_operator_t, typename Poller>
+struct polled_external_async_awaitable final :
+    external_async_awaitable_base<polled_external_async_awaitable<external_async_operator_t, Poller>, external_async_operator_t> {
+    using base = external_async_awaitable_base<polled_external_async_awaitable<external_async_operator_t, Poller>, external_async_operator_t>;
+
+    static_assert(detail::start_prob_v<external_async_operator_t>,
+        "there should be static function whose signature is like:"
+        "int external_async_operator_t::start(typename external_async_operator_t::context_t*) noexcept;\n"
+        "which is used to start the polled external async operation.\n");
+
+    static_assert(detail::poll_prob_v<external_async_operator_t>,
+        "there should be static function whose signature is like:"
+        "bool external_async_operator_t::poll(typename external_async_operator_t::context_t*) noexcept;\n"
+        "which returns true once the polled external async operation completed.\n");
+
+    Poller* poller;
+    polled_external_async_awaitable* next = nullptr;
+
+    template<typename param_t>
+    polled_external_async_awaitable(Poller* poller_, param_t&& param)
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+        noexcept
+#endif
+        : base(std::forward<param_t>(param)), poller(poller_) {
+    }
+
+    int submit() noexcept {
+        auto ec = external_async_operator_t::start(&this->ctx);
+        UNLIKELY_IF (ec != 0) {
+            return ec;
+        }
+        poller->enqueue(this);
+        return 0;
+    }
+};
+
+} // namespace extension
+
+namespace flow_impl {
+    template <typename Executor, typename external_async_operator_t, typename Poller>
+    struct polled_external_async_node {
+        static_assert(check_executor<Executor>::value,
+            "Executor must be pointer-like and support "
+            "noexcept exec->dispatch(task_wrapper_sbo).");
+
+        Executor e;
+        Poller* poller;
+    };
+
+    template <typename I, typename O, typename... Nodes, typename Executor, typename external_async_operator_t, typename Poller>
+    auto operator|(flow_blueprint<I, O, Nodes...>&& bp, polled_external_async_node<Executor, external_async_operator_t, Poller>&& a) {
+        using awaitable_t = extension::polled_external_async_awaitable<external_async_operator_t, Poller>;
+        using F_O = typename awaitable_t::async_result_type;
+        using wrapper_t = dispatch_wrapper_t<Executor>;
+        using factory_t = bound_awaitable_factory<awaitable_t, Poller>;
+
+        return std::move(bp) | flow_async_node<O, F_O, wrapper_t, identity, factory_t> {
+            wrapper_t{std::move(a.e)}, identity{}, factory_t{a.poller}
+        };
+    }
+}
+
+// Same as await_external_async<OP>(), but OP is a polled backend: completion is detected by
+// `poller` on its executor thread, see extension::external_async_poller.
+template<typename external_async_operator_t, typename Executor, typename PollExecutor,
+    std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+auto await_polled_external_async(extension::external_async_poller<external_async_operator_t, PollExecutor>& poller,
+    Executor&& executor_to_resume) noexcept {
+    using E = std::decay_t<Executor>;
+    using poller_t = extension::external_async_poller<external_async_operator_t, PollExecutor>;
+    return flow_impl::polled_external_async_node<E, external_async_operator_t, poller_t> {
+        std::forward<Executor>(executor_to_resume), &poller
+    };
+}
+
+template<typename external_async_operator_t, typename PollExecutor>
+auto await_polled_external_async(extension::external_async_poller<external_async_operator_t, PollExecutor>& poller) noexcept {
+    using E = flow_impl::inline_executor*;
+    using poller_t = extension::external_async_poller<external_async_operator_t, PollExecutor>;
+    return flow_impl::polled_external_async_node<E, external_async_operator_t, poller_t> {
+        flow_impl::inline_executor::executor(), &poller
+    };
+}
+
+} // namespace flux_foundry
+
+#endif
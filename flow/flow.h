@@ -12,7 +12,16 @@
 #include "flow_aggregator.h"
 #include "flow_awaitable.h"
 #include "flow_runner.h"
+#include "flow_any_blueprint.h"
 #include "flow_async_aggregator.h"
 #include "flow_node.h"
+#include "flow_semaphore.h"
+#include "flow_channel.h"
+#include "flow_mutex.h"
+#include "flow_stream.h"
+#include "flow_batch.h"
+#include "flow_cache.h"
+#include "flow_blocking.h"
+#include "flow_parallel.h"
 
 #endif //FLOW_H
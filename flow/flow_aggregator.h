@@ -3,58 +3,237 @@
 
 #include <cstdlib>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 
 #include "../base/inplace_base.h"
 #include "../memory/lite_ptr.h"
 #include "../memory/aligned_alloc.h"
+#include "../memory/padded_t.h"
 #include "../memory/result_t.h"
+#include "../utility/park.h"
 #include "flow_blueprint.h"
+#include "flow_node.h"
+#include "flow_wait_list.h"
 
 /**
  * flow_aggregator: Lock-free result aggregator for fork/join patterns
  *
- * Provides primitives for checking result readiness. Users decide how to wait:
+ * Provides readiness checks and waits. Pick the one that fits the waiting side:
  *
- * Example 1: Spin wait (lowest latency)
- *   while (!agg.is_all_ready()) { }
+ * Example 1: Block a thread until every slot is filled (spins briefly, then parks on a futex)
+ *   agg.wait_all();
+ *   if (!agg.wait_all_for(std::chrono::milliseconds(5))) { timed_out(); }
  *
- * Example 2: Yield wait (CPU-friendly)
- *   while (!agg.is_all_ready()) { std::this_thread::yield(); }
+ * Example 2: Block until the first slot is filled (first-wins)
+ *   agg.wait_any();
+ *   if (agg.is_slot_ready<0>()) { handle(get<0>(agg.value())); }
  *
- * Example 3: Condition variable (event-driven)
- *   std::unique_lock lock(mtx);
- *   cv.wait(lock, [&]{ return agg.is_all_ready(); });
- *   (Requires wrapping delegate to notify CV)
+ * Example 3: Resume a flow once every slot is filled, no thread waits at all
+ *   make_blueprint<void>() | await_aggregator(agg, &executor) | transform(...)
  *
  * Example 4: Async polling (event loop)
  *   if (agg.is_all_ready()) { process(agg.value()); }
  *
- * Example 5: Wait for any (first-wins)
- *   while (!agg.is_any_ready()) { yield(); }
- *   if (agg.is_slot_ready<0>()) { handle(get<0>(agg.value())); }
+ * Example 5: A wide fan-in whose producers finish together
+ *   sharded_flow_aggregator<R, R, ..., R> agg;   // or basic_flow_aggregator<sharded_slots<4>, ...>
+ *   agg.wait_all();
+ *   use(agg.result<0>());
+ *
+ * A delegate's emplace() only makes a wake-up syscall when a thread is parked on the
+ * condition it completes (the first slot for wait_any, the last one for wait_all).
  *
- * Flow provides mechanism, you provide policy.
+ * With sharded_slots, each slot's flag and result sit on their own cache line and the
+ * shared ready_count takes one increment per group of fan_in slots instead of one per slot.
  */
 
 namespace flux_foundry {
-    template <typename... Ts>
-    struct flow_aggregator {
+    // slot layouts of a flow_aggregator.
+    // - packed_slots: the results and their flags sit side by side in one block, and one counter counts the
+    //   filled slots. the smallest layout, for narrow fan-ins or results that arrive at different times.
+    // - sharded_slots<fan_in>: every result and every flag gets its own cache line, and the filled slots are
+    //   counted by a combining tree of fan_in-wide counters. for wide fan-ins whose results land together.
+    struct packed_slots {
+        static constexpr size_t fan_in = 0;
+    };
+
+    template <size_t FanIn = 8>
+    struct sharded_slots {
+        static_assert(FanIn > 1, "a combining counter needs a fan-in of at least 2");
+        static constexpr size_t fan_in = FanIn;
+    };
+
+namespace detail {
+    template <typename Layout, typename T>
+    struct aggregator_slot {
+        using type = T;
+    };
+
+    template <size_t FanIn, typename T>
+    struct aggregator_slot<sharded_slots<FanIn>, T> {
+        using type = padded_t<T, CACHE_LINE_SIZE>;
+    };
+
+    template <typename T>
+    T& unpad(T& v) noexcept {
+        return v;
+    }
+
+    template <typename T>
+    const T& unpad(const T& v) noexcept {
+        return v;
+    }
+
+    template <typename T, size_t align>
+    T& unpad(padded_t<T, align>& v) noexcept {
+        return v.get();
+    }
+
+    template <typename T, size_t align>
+    const T& unpad(const padded_t<T, align>& v) noexcept {
+        return v.get();
+    }
+
+    // the shape of a combining tree over n arrivals with `width`-wide counters.
+    constexpr size_t combining_up(size_t n, size_t width) noexcept {
+        return (n + width - 1) / width;
+    }
+
+    // levels of counters below the root.
+    constexpr size_t combining_depth(size_t n, size_t width) noexcept {
+        size_t d = 0;
+        for (; n > width; n = combining_up(n, width)) {
+            ++d;
+        }
+        return d;
+    }
+
+    // counters below the root, over every level.
+    constexpr size_t combining_nodes(size_t n, size_t width) noexcept {
+        size_t t = 0;
+        while (n > width) {
+            n = combining_up(n, width);
+            t += n;
+        }
+        return t;
+    }
+
+    // arrivals the root takes.
+    constexpr size_t combining_root(size_t n, size_t width) noexcept {
+        while (n > width) {
+            n = combining_up(n, width);
+        }
+        return n;
+    }
+
+    // combining_counter<N, fan_in>: the levels below the root of a counter of N arrivals.
+    // arrivals are grouped fan_in at a time under a padded counter, those counters fan_in at a time
+    // under the next level, until at most fan_in groups are left for the root. an arrival climbs past a
+    // counter only if it completes that counter's group, so no counter line has more than fan_in writers
+    // and the root takes one increment per top-level group. fan_in 0 means no levels: every arrival
+    // goes straight to the root, see the specialization below.
+    template <size_t N, size_t fan_in>
+    class combining_counter {
+        static constexpr size_t width = fan_in;
+        static constexpr size_t depth = combining_depth(N, width);
+        static constexpr size_t nodes = combining_nodes(N, width);
+
+        padded_t<std::atomic<std::uint32_t>, CACHE_LINE_SIZE> counters_[nodes ? nodes : 1];
+
+    public:
+        static constexpr size_t root_target = combining_root(N, width);
+
+        combining_counter() noexcept {
+            for (auto& c : counters_) {
+                c.get().store(0, std::memory_order_relaxed);
+            }
+        }
+
+        // true if this arrival completed its group on every level and has to be counted at the root.
+        bool climb(size_t slot) noexcept {
+            const size_t w = width;
+            size_t index = slot;
+            size_t base = 0;
+            size_t children = N;
+            for (size_t level = 0; level < depth; ++level) {
+                const size_t node = index / w;
+                const size_t left = children - node * w;
+                const size_t target = left < w ? left : w;
+                if (counters_[base + node].get().fetch_add(1, std::memory_order_acq_rel) + 1 != target) {
+                    return false;
+                }
+                children = combining_up(children, w);
+                base += children;
+                index = node;
+            }
+            return true;
+        }
+
+        // the filled slots, given what the root counted. exact once no arrival is in flight.
+        size_t arrived(size_t root_count) const noexcept {
+            LIKELY_IF (depth == 0) {
+                return root_count;
+            }
+            size_t sum = 0;
+            for (size_t i = 0; i < combining_up(N, width); ++i) {
+                sum += counters_[i].get().load(std::memory_order_acquire);
+            }
+            return sum;
+        }
+    };
+
+    template <size_t N>
+    class combining_counter<N, 0> {
+    public:
+        static constexpr size_t root_target = N;
+
+        bool climb(size_t) noexcept {
+            return true;
+        }
+
+        size_t arrived(size_t root_count) const noexcept {
+            return root_count;
+        }
+    };
+}
+
+    template <typename Layout, typename... Ts>
+    struct basic_flow_aggregator {
         static_assert(conjunction_v<is_result_t<Ts>...>,
             "All the types in the template param pack must be result_t<T, E>");
         constexpr static size_t N = sizeof...(Ts);
-        using storage_t = flat_storage<std::decay_t<Ts>...>;
+        using storage_t = flat_storage<typename detail::aggregator_slot<Layout, std::decay_t<Ts>>::type...>;
         using slot_state = detail::slot_state;
+
+        template <size_t I>
+        using result_type = flat_storage_element_t<I, flat_storage<std::decay_t<Ts>...>>;
     private:
+        using counter_t = detail::combining_counter<N, Layout::fan_in>;
+        using flag_t = typename detail::aggregator_slot<Layout, std::atomic<slot_state>>::type;
+
+        // ready_count, the root of the counter:
+        // | 31: thread in wait_all | 30: thread in wait_any | 29: flow waiters | 28: a slot is filled | 27 ... 0: count |
+        // with packed_slots the count is the filled slots, with sharded_slots the completed top-level groups.
+        static constexpr std::uint32_t all_waiters = std::uint32_t(1) << 31;
+        static constexpr std::uint32_t any_waiters = std::uint32_t(1) << 30;
+        static constexpr std::uint32_t flow_waiters = std::uint32_t(1) << 29;
+        static constexpr std::uint32_t any_filled = std::uint32_t(1) << 28;
+        static constexpr std::uint32_t count_mask = any_filled - 1;
+        static constexpr std::uint32_t root_target = static_cast<std::uint32_t>(counter_t::root_target);
+        static_assert(N < count_mask, "too many slots for one flow_aggregator");
+
         struct alignas(OPTIMIZED_ALIGN) Data {
-            std::atomic<size_t> ready_count;
+            std::atomic<std::uint32_t> ready_count;
+            detail::flow_wait_list waiters;
+            counter_t counter;
 
-            // Tips: if this is checked very frequently, each flag should be aligned by 64
-            std::atomic<slot_state> slot_ready[N];
+            flag_t slot_ready[N];
             storage_t val;
 
-            Data() : ready_count { 0 }, val { Ts(error_tag, typename Ts::error_type {})... } {
+            Data() : ready_count { 0 },
+                val { typename detail::aggregator_slot<Layout, Ts>::type(Ts(error_tag, typename Ts::error_type {}))... } {
                 for (size_t i = 0; i < N; ++i) {
-                    slot_ready[i].store(slot_state::empty, std::memory_order_relaxed);
+                    detail::unpad(slot_ready[i]).store(slot_state::empty, std::memory_order_relaxed);
                 }
             }
 
@@ -63,11 +242,19 @@ namespace flux_foundry {
             }
         };
 
+        static bool all_in(std::uint32_t w) noexcept {
+            return (w & count_mask) == root_target;
+        }
+
+        static bool any_in(std::uint32_t w) noexcept {
+            return (w & (count_mask | any_filled)) != 0;
+        }
+
     public:
         template <size_t I>
         struct delegate {
         private:
-            using elem_type = flat_storage_element_t<I, storage_t>;
+            using elem_type = result_type<I>;
             lite_ptr<Data> data;
              
         public:
@@ -87,13 +274,14 @@ namespace flux_foundry {
             >* = nullptr>
             bool emplace(Us&&... args) noexcept {
                 // if this slot is already used. return false;
+                auto& flag = detail::unpad(data->slot_ready[I]);
                 slot_state expected = slot_state::empty;
-                if (!data->slot_ready[I].compare_exchange_strong(expected, slot_state::occupied,
-                                                                std::memory_order_release, std::memory_order_relaxed)) {
+                if (!flag.compare_exchange_strong(expected, slot_state::occupied,
+                                                  std::memory_order_release, std::memory_order_relaxed)) {
                     return false;
                 }
 
-                elem_type& e = get<I>(data->val);
+                elem_type& e = detail::unpad(get<I>(data->val));
 #if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
                 try {
 #endif
@@ -104,37 +292,89 @@ namespace flux_foundry {
                 }
 #endif
 
-                data->slot_ready[I].store(slot_state::full, std::memory_order_release);
-                data->ready_count.fetch_add(1, std::memory_order_release);
+                flag.store(slot_state::full, std::memory_order_release);
+                arrive(*data, I);
                 return true;
             }
         };
         
-        flow_aggregator() : 
+        basic_flow_aggregator() :
             data(Data::make_shared()) {
 #if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
             assert(data && "failed to allocate aggregator data.");
 #endif
         }
 
-        flow_aggregator(const flow_aggregator&) = default;
-        flow_aggregator& operator=(const flow_aggregator&) = default;
-        flow_aggregator(flow_aggregator&&) = default;
-        flow_aggregator& operator=(flow_aggregator&&) = default;
-        ~flow_aggregator() noexcept = default;
+        basic_flow_aggregator(const basic_flow_aggregator&) = default;
+        basic_flow_aggregator& operator=(const basic_flow_aggregator&) = default;
+        basic_flow_aggregator(basic_flow_aggregator&&) = default;
+        basic_flow_aggregator& operator=(basic_flow_aggregator&&) = default;
+        ~basic_flow_aggregator() noexcept = default;
 
         bool is_any_ready() const noexcept {
-            return this->data->ready_count.load(std::memory_order_acquire) != 0;
+            return any_in(this->data->ready_count.load(std::memory_order_acquire));
         }
 
         bool is_all_ready() const noexcept {
-            return this->data->ready_count.load(std::memory_order_acquire) == N;
+            return all_in(this->data->ready_count.load(std::memory_order_acquire));
+        }
+
+        // block the calling thread: spin briefly, then park on ready_count.
+        void wait_all() const noexcept {
+            wait_until_word(all_waiters, all_in);
+        }
+
+        void wait_any() const noexcept {
+            wait_until_word(any_waiters, any_in);
+        }
+
+        // returns false on timeout.
+        template <typename Rep, typename Period>
+        bool wait_all_for(const std::chrono::duration<Rep, Period>& timeout) const noexcept {
+            return wait_all_until(std::chrono::steady_clock::now() + timeout);
+        }
+
+        template <typename Clock, typename Duration>
+        bool wait_all_until(const std::chrono::time_point<Clock, Duration>& deadline) const noexcept {
+            if (spin_until([this]() noexcept { return is_all_ready(); })) {
+                return true;
+            }
+
+            auto& word = this->data->ready_count;
+            std::uint32_t w = word.fetch_or(all_waiters, std::memory_order_acq_rel) | all_waiters;
+            while (!all_in(w)) {
+                const auto now = Clock::now();
+                if (now >= deadline) {
+                    return false;
+                }
+                park_on_for(word, w, deadline - now);
+                w = word.load(std::memory_order_acquire);
+            }
+            return true;
+        }
+
+        // ready: every slot is already filled, w is not queued.
+        // otherwise w is queued and w->wake(w) is called by the emplace() that fills the last slot.
+        bool ready_or_park(detail::flow_waiter* w) noexcept {
+            detail::flow_wait_list_guard g(this->data->waiters);
+            const std::uint32_t prev = this->data->ready_count.fetch_or(flow_waiters, std::memory_order_acq_rel);
+            if (all_in(prev)) {
+                return true;
+            }
+            this->data->waiters.push_back(w);
+            return false;
+        }
+
+        // returns false if w has already been popped to be woken.
+        bool cancel_park(detail::flow_waiter* w) noexcept {
+            detail::flow_wait_list_guard g(this->data->waiters);
+            return this->data->waiters.erase(w);
         }
         
         template <size_t I>
         bool is_slot_ready() const noexcept {
             static_assert(I < N, "flow_aggregator index out of range");
-            return this->data->slot_ready[I].load(std::memory_order_acquire) == slot_state::full;
+            return detail::unpad(this->data->slot_ready[I]).load(std::memory_order_acquire) == slot_state::full;
         }
         
         // You should only create a delegate for each slot once
@@ -145,9 +385,23 @@ namespace flux_foundry {
         }
         
         size_t value_got() const noexcept {
-            return this->data->ready_count.load(std::memory_order_acquire);
+            return this->data->counter.arrived(this->data->ready_count.load(std::memory_order_acquire) & count_mask);
         }
-        
+
+        // the result of slot I, whatever the layout.
+        template <size_t I>
+        result_type<I>& result() noexcept {
+            static_assert(I < N, "flow_aggregator index out of range");
+            return detail::unpad(get<I>(this->data->val));
+        }
+
+        template <size_t I>
+        const result_type<I>& result() const noexcept {
+            static_assert(I < N, "flow_aggregator index out of range");
+            return detail::unpad(get<I>(this->data->val));
+        }
+
+        // with sharded_slots the elements are padded_t<result>, see result<I>().
         storage_t& value() & noexcept {
             return this->data->val;
         }
@@ -161,8 +415,67 @@ namespace flux_foundry {
         }
     private:
         lite_ptr<Data> data;
+
+        template <typename Pred>
+        void wait_until_word(std::uint32_t waiter_bit, Pred done) const noexcept {
+            auto& word = this->data->ready_count;
+            if (spin_until([&word, done]() noexcept { return done(word.load(std::memory_order_acquire)); })) {
+                return;
+            }
+
+            std::uint32_t w = word.fetch_or(waiter_bit, std::memory_order_acq_rel) | waiter_bit;
+            while (!done(w)) {
+                park_on(word, w);
+                w = word.load(std::memory_order_acquire);
+            }
+        }
+
+        static void arrive(Data& d, size_t slot) noexcept {
+            std::uint32_t prev;
+            const bool counted = d.counter.climb(slot);
+            LIKELY_IF (counted) {
+                prev = d.ready_count.fetch_add(1, std::memory_order_acq_rel);
+            } else {
+                // a group below the root is still open, only the first arrival marks the root.
+                LIKELY_IF (d.ready_count.load(std::memory_order_relaxed) & any_filled) {
+                    return;
+                }
+                prev = d.ready_count.fetch_or(any_filled, std::memory_order_acq_rel);
+            }
+            UNLIKELY_IF (prev & (all_waiters | any_waiters | flow_waiters)) {
+                notify(d, prev, counted);
+            }
+        }
+
+        // prev is ready_count before the arrival that calls this.
+        static void notify(Data& d, std::uint32_t prev, bool counted) noexcept {
+            const bool first = !any_in(prev);
+            const bool last = counted && (prev & count_mask) + 1 == root_target;
+            if (((prev & any_waiters) && first) || ((prev & all_waiters) && last)) {
+                unpark_all(d.ready_count);
+            }
+            if ((prev & flow_waiters) && last) {
+                detail::flow_waiter* w;
+                {
+                    detail::flow_wait_list_guard g(d.waiters);
+                    w = d.waiters.take_all();
+                }
+                while (w) {
+                    auto next = w->next;
+                    w->next = nullptr;
+                    w->wake(w);
+                    w = next;
+                }
+            }
+        }
     };
 
+    template <typename... Ts>
+    using flow_aggregator = basic_flow_aggregator<packed_slots, Ts...>;
+
+    template <typename... Ts>
+    using sharded_flow_aggregator = basic_flow_aggregator<sharded_slots<>, Ts...>;
+
     template <typename ... BPs>
     auto make_aggregator(const BPs&...) {
         static_assert(conjunction_v<flow_impl::is_blueprint<BPs>...>,
@@ -175,6 +488,118 @@ namespace flux_foundry {
         static_assert(conjunction_v<flow_impl::is_blueprint<BPs>...>, "BPs should be blueprints");
         return flow_aggregator<typename BPs::O_t...>();
     }
+
+    template <typename ... BPs>
+    auto make_sharded_aggregator(const BPs&...) {
+        static_assert(conjunction_v<flow_impl::is_blueprint<BPs>...>,
+            "you can only use this function with blueprints as input.");
+        return sharded_flow_aggregator<typename BPs::O_t...>();
+    }
+
+    template <typename... BPs>
+    auto make_sharded_aggregator_t() {
+        static_assert(conjunction_v<flow_impl::is_blueprint<BPs>...>, "BPs should be blueprints");
+        return sharded_flow_aggregator<typename BPs::O_t...>();
+    }
+
+namespace detail {
+    // outputs the aggregator once every slot is filled. the input value is dropped,
+    // an error input passes through without waiting.
+    template <typename Agg, typename R>
+    struct aggregator_awaitable final
+        : awaitable_base<aggregator_awaitable<Agg, R>, Agg, typename R::error_type> {
+        using async_result_type = result_t<Agg, typename R::error_type>;
+
+        Agg agg;
+        flow_waiter waiter;
+        R in;
+
+        aggregator_awaitable(const Agg& agg_, R&& in_)
+            noexcept(std::is_nothrow_copy_constructible<Agg>::value && std::is_nothrow_move_constructible<R>::value)
+            : agg(agg_), in(std::move(in_)) {
+            waiter.wake = on_wake;
+            waiter.owner = this;
+        }
+
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+        bool available() const noexcept {
+            return true;
+        }
+#endif
+
+        static void on_wake(flow_waiter* w) noexcept {
+            auto self = static_cast<aggregator_awaitable*>(w->owner);
+            self->resume(async_result_type(value_tag, self->agg));
+            self->release();
+        }
+
+        int submit() noexcept {
+            UNLIKELY_IF (!in.has_value()) {
+                this->resume(async_result_type(error_tag, std::move(in).error()));
+                return 0;
+            }
+
+            // reference held by the aggregator while parked
+            this->retain();
+            if (agg.ready_or_park(&waiter)) {
+                this->release();
+                this->resume(async_result_type(value_tag, agg));
+            }
+            return 0;
+        }
+
+        void cancel() noexcept {
+            LIKELY_IF (agg.cancel_park(&waiter)) {
+                this->release();
+            }
+        }
+    };
+}
+
+namespace flow_impl {
+    template <typename Executor, typename Agg>
+    struct aggregator_node {
+        static_assert(check_executor<Executor>::value,
+            "Executor must be pointer-like and support "
+            "noexcept exec->dispatch(task_wrapper_sbo).");
+
+        Executor e;
+        Agg agg;
+    };
+
+    template <typename I, typename O, typename... Nodes, typename Executor, typename Agg>
+    auto operator|(flow_blueprint<I, O, Nodes...>&& bp, aggregator_node<Executor, Agg>&& a) {
+        using awaitable_t = detail::aggregator_awaitable<Agg, O>;
+        using F_O = typename awaitable_t::async_result_type;
+        using wrapper_t = dispatch_wrapper_t<Executor>;
+        using factory_t = bound_awaitable_factory<awaitable_t, Agg, Agg>;
+
+        return std::move(bp) | flow_async_node<O, F_O, wrapper_t, identity, factory_t> {
+            wrapper_t{std::move(a.e)}, identity{}, factory_t{std::move(a.agg)}
+        };
+    }
+}
+
+    // Suspends the flow until every slot of agg is filled, then outputs a copy of agg
+    // (a handle sharing the same slots), so the next step reads the results from value().
+    // The current output is dropped, an error passes through without waiting.
+    // A canceled flow is unlinked from agg and never resumed. The blueprint holds its own handle
+    // to agg's slots, so it may outlive the `agg` object it was built from.
+    template <typename Layout, typename... Ts, typename Executor,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto await_aggregator(basic_flow_aggregator<Layout, Ts...>& agg, Executor&& executor_to_resume) noexcept {
+        using E = std::decay_t<Executor>;
+        using agg_t = basic_flow_aggregator<Layout, Ts...>;
+        return flow_impl::aggregator_node<E, agg_t> { std::forward<Executor>(executor_to_resume), agg };
+    }
+
+    // resume on the thread whose emplace() fills the last slot.
+    template <typename Layout, typename... Ts>
+    auto await_aggregator(basic_flow_aggregator<Layout, Ts...>& agg) noexcept {
+        using E = flow_impl::inline_executor*;
+        using agg_t = basic_flow_aggregator<Layout, Ts...>;
+        return flow_impl::aggregator_node<E, agg_t> { flow_impl::inline_executor::executor(), agg };
+    }
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,218 @@
+#ifndef FLUX_FOUNDRY_FLOW_ANY_BLUEPRINT_H
+#define FLUX_FOUNDRY_FLOW_ANY_BLUEPRINT_H
+
+#include <utility>
+
+#include "../base/traits.h"
+#include "../base/type_erase_base.h"
+#include "../memory/lite_ptr.h"
+#include "flow_blueprint.h"
+#include "flow_receiver.h"
+#include "flow_runner.h"
+
+namespace flux_foundry {
+    // Type erasure for pipelines picked at runtime (per config, per venue, ...).
+    // All three wrappers reuse raw_type_erase_base, the same vtable-free SBO layout as callable_wrapper:
+    // a single hot-path function pointer next to the inline storage. Everything behind it stays static,
+    // so an any_runner pays one indirect call to start a run and one to deliver the result,
+    // the nodes in between run exactly like in a plain flow_runner.
+    constexpr static size_t any_receiver_sbo_size = 2 * sizeof(void*);
+    // fits flow_runner<bp, any_receiver<O>>: blueprint, receiver and controller pointers.
+    constexpr static size_t any_runner_sbo_size = 6 * sizeof(void*);
+
+    // any_receiver<O>: type-erased receiver of result O, stored inline.
+    // receivers are nothrow copyable handles by contract (check_receiver), so they must fit the buffer
+    // without an allocation, keep larger state behind a shared handle.
+    template <typename O>
+    class any_receiver :
+        public raw_type_erase_base<any_receiver<O>, any_receiver_sbo_size,
+            alignof(void*), void(void*, O&&)> {
+        using base = raw_type_erase_base<any_receiver<O>, any_receiver_sbo_size,
+            alignof(void*), void(void*, O&&)>;
+
+        template <typename T, bool sbo_enabled>
+        struct receiver_vfns {
+            static void call(void* p, O&& r) noexcept {
+                tr_ptr<T, sbo_enabled>(p)->emplace(std::move(r));
+            }
+        };
+
+        // an empty receiver drops the result, like stub_receiver.
+        static void stub(void*, O&&) noexcept {
+        }
+
+        friend struct raw_type_erase_base<any_receiver<O>, any_receiver_sbo_size,
+            alignof(void*), void(void*, O&&)>;
+    public:
+        using value_type = O;
+
+        any_receiver() noexcept = default;
+
+        // the stored receiver is nothrow copyable and never spills, so copying cannot fail.
+        any_receiver(const any_receiver& rhs) noexcept
+            : base(rhs) {
+        }
+
+        any_receiver(any_receiver&&) noexcept = default;
+
+        any_receiver& operator=(const any_receiver& rhs) noexcept {
+            base::operator=(rhs);
+            return *this;
+        }
+
+        any_receiver& operator=(any_receiver&&) noexcept = default;
+
+        template <typename R,
+            typename R_t = std::decay_t<R>,
+            typename = std::enable_if_t<conjunction_v<
+                negation<is_self_constructing<any_receiver, R_t>>,
+                std::integral_constant<bool, check_receiver_v<R_t>>,
+                is_receiver_compatible<O, R_t>>>>
+        any_receiver(R&& r) noexcept {
+            static_assert(detail::can_enable_sbo<R_t, any_receiver_sbo_size, alignof(void*)>::value,
+                "the receiver is too large for any_receiver, store its state behind a shared handle.");
+            base::template emplace<R_t>(std::forward<R>(r));
+        }
+
+        template <typename T, bool sbo_enabled>
+        void do_customize() noexcept {
+            this->invoker_ = receiver_vfns<T, sbo_enabled>::call;
+            this->manager_ = &life_span_manager<T, sbo_enabled>::vtable;
+        }
+
+        void emplace(O&& r) noexcept {
+            this->invoker_(this->data_, std::move(r));
+        }
+    };
+
+    // any_runner<I, O>: type-erased flow_runner over a blueprint with input I and output O.
+    // same contract as flow_runner: not thread-safe, do not call operator() concurrently.
+    template <typename I, typename O>
+    class any_runner :
+        public raw_type_erase_base<any_runner<I, O>, any_runner_sbo_size,
+            alignof(std::max_align_t), void(void*, I&&)> {
+        template <typename T, bool sbo_enabled>
+        struct runner_vfns {
+            static void call(void* p, I&& in) noexcept {
+                (*tr_ptr<T, sbo_enabled>(p))(std::move(in));
+            }
+        };
+
+        // running an empty runner is a no-op, like a flow_runner without a blueprint.
+        static void stub(void*, I&&) noexcept {
+        }
+
+        friend struct raw_type_erase_base<any_runner<I, O>, any_runner_sbo_size,
+            alignof(std::max_align_t), void(void*, I&&)>;
+    public:
+        using I_t = I;
+        using O_t = O;
+
+        any_runner() noexcept = default;
+
+        template <typename T, bool sbo_enabled>
+        void do_customize() noexcept {
+            this->invoker_ = runner_vfns<T, sbo_enabled>::call;
+            this->manager_ = &life_span_manager<T, sbo_enabled>::vtable;
+        }
+
+        void operator()(I_t&& param) noexcept {
+            this->invoker_(this->data_, std::move(param));
+        }
+
+        void operator()(const I_t& param)
+            noexcept(std::is_nothrow_copy_constructible<I_t>::value) {
+            this->invoker_(this->data_, I_t(param));
+        }
+
+        template <typename ... Args,
+            std::enable_if_t<std::is_constructible<typename I_t::value_type, Args&& ...>::value>* = nullptr>
+        void operator()(Args&& ... params) noexcept {
+            this->invoker_(this->data_, I_t(value_tag, std::forward<Args>(params)...));
+        }
+    };
+
+    // any_blueprint<I, O>: type-erased lite_ptr<bp> plus the factory for its runner.
+    // copies share the blueprint, as copies of the lite_ptr do.
+    template <typename I, typename O>
+    class any_blueprint :
+        public raw_type_erase_base<any_blueprint<I, O>, sizeof(void*), alignof(void*),
+            void(const void*, any_runner<I, O>&, any_receiver<O>&&)> {
+        template <typename T, bool sbo_enabled>
+        struct blueprint_vfns {
+            static void make_runner(const void* p, any_runner<I, O>& out, any_receiver<O>&& receiver) {
+                using bp_t = typename T::element_type;
+                using runner_t = flow_runner<bp_t, any_receiver<O>>;
+                static_assert(detail::can_enable_sbo<runner_t, any_runner_sbo_size, alignof(std::max_align_t)>::value,
+                    "flow_runner does not fit any_runner inline storage");
+                out.template emplace<runner_t>(
+                    *tr_ptr<T, sbo_enabled>(p), lite_ptr<flow_controller>(), std::move(receiver));
+            }
+        };
+
+        // an empty blueprint makes an empty runner.
+        static void stub(const void*, any_runner<I, O>&, any_receiver<O>&&) {
+        }
+
+        friend struct raw_type_erase_base<any_blueprint<I, O>, sizeof(void*), alignof(void*),
+            void(const void*, any_runner<I, O>&, any_receiver<O>&&)>;
+    public:
+        using I_t = I;
+        using O_t = O;
+
+        any_blueprint() noexcept = default;
+
+        template <typename bp_t>
+        any_blueprint(lite_ptr<bp_t> bp) noexcept {
+            static_assert(flow_impl::is_blueprint_v<bp_t>, "bp_t must be a flow_blueprint");
+            static_assert(std::is_same<typename bp_t::I_t, I>::value && std::is_same<typename bp_t::O_t, O>::value,
+                "the blueprint's input and output must match any_blueprint<I, O>");
+            this->template emplace<lite_ptr<bp_t>>(std::move(bp));
+        }
+
+        template <typename T, bool sbo_enabled>
+        void do_customize() noexcept {
+            this->invoker_ = blueprint_vfns<T, sbo_enabled>::make_runner;
+            this->manager_ = &life_span_manager<T, sbo_enabled>::vtable;
+        }
+
+        any_runner<I, O> make_runner(any_receiver<O> receiver) const {
+            any_runner<I, O> runner;
+            this->invoker_(this->data_, runner, std::move(receiver));
+            return runner;
+        }
+    };
+
+    template <typename bp_t>
+    auto make_any_blueprint(lite_ptr<bp_t> bp) noexcept {
+        static_assert(flow_impl::is_blueprint_v<bp_t>, "bp_t must be a flow_blueprint");
+        return any_blueprint<typename bp_t::I_t, typename bp_t::O_t>(std::move(bp));
+    }
+
+    template <typename bp_t, typename = std::enable_if_t<flow_impl::is_blueprint_v<std::decay_t<bp_t>>>>
+    auto make_any_blueprint(bp_t&& bp) {
+        using bp_decay = std::decay_t<bp_t>;
+        return make_any_blueprint(make_lite_ptr<bp_decay>(std::forward<bp_t>(bp)));
+    }
+
+    template <typename I, typename O>
+    auto make_runner(const any_blueprint<I, O>& bp) {
+        return bp.make_runner(any_receiver<O>());
+    }
+
+    template <typename I, typename O, typename receiver_t>
+    auto make_runner(const any_blueprint<I, O>& bp, receiver_t receiver) {
+        static_assert(check_receiver_v<receiver_t>,
+            "a valid receiver should:\n"
+            "1. be nothrow move constructible.\n"
+            "2. be nothrow copy constructible.\n"
+            "in order to fully enable non-alloc in pipeline running, please make your receiver shared handle");
+        static_assert(is_receiver_compatible<O, receiver_t>::value,
+            "the provided receiver isn't compatible with the current bp's output, A valid receiver should: "
+            "1. has member:: typename value_type, which should be a result_t<T, E>, represents the result it receives\n"
+            "2. has member function, whose signature is [ void emplace(result_t<T, E>&&) noexcept ]\n");
+        return bp.make_runner(any_receiver<O>(std::move(receiver)));
+    }
+}
+
+#endif // FLUX_FOUNDRY_FLOW_ANY_BLUEPRINT_H
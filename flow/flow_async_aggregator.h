@@ -110,9 +110,13 @@ namespace detail {
         padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> fired;
         padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> failed;
         std::array<flow_controller, sizeof...(Ts)> controllers;
+        // parent of the launched branch controllers, linked below the controller of the runner that
+        // submitted the aggregator. nested aggregators link their own group below a branch controller,
+        // so one cancel() from the outermost runner walks the whole tree.
+        flow_controller group;
 
         flow_when_all_state() noexcept
-                : data{Ts(error_tag, typename Ts::error_type{})...}, fired(0), failed(sizeof...(Ts)), controllers{} {
+                : data{Ts(error_tag, typename Ts::error_type{})...}, fired(0), failed(sizeof...(Ts)), controllers{}, group{} {
         }
 
         struct result_delegate {
@@ -150,6 +154,7 @@ namespace detail {
                 Awaitable *owner_raw = owner.get();
                 auto &state = owner_raw->state_;
                 value_type &e = get<I>(state.data);
+                state.controllers[I].detach();
 #if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
                 try {
 #endif
@@ -160,9 +165,7 @@ namespace detail {
                 }
 #endif
                 UNLIKELY_IF (e.has_error()) {
-                    for (size_t i = 0; i < sizeof...(Ts); ++i) {
-                        state.controllers[i].cancel(true);
-                    }
+                    state.group.cancel(true);
 
                     size_t exp = sizeof...(Ts);
                     state.failed.get().compare_exchange_strong(exp, I,
@@ -176,6 +179,7 @@ namespace detail {
                              detail::successfully_finished) {
                     std::atomic_thread_fence(std::memory_order_acquire);
 #endif
+                    state.group.detach();
                     auto i = state.failed.get().load(std::memory_order_relaxed);
                     LIKELY_IF (i == sizeof...(Ts)) {
                         owner_raw->resume(result_type(value_tag, typename state_t::result_delegate(owner)));
@@ -220,9 +224,7 @@ namespace detail {
         template<size_t I>
         int launch() {
             auto on_error = [this]() noexcept {
-                for (size_t i = 0; i < I; ++i) {
-                    state_.controllers[i].cancel(true);
-                }
+                state_.group.cancel(true);
                 state_.fired.get().fetch_sub(detail::epoch, std::memory_order_relaxed);
                 state_.fired.get().fetch_or(detail::launch_failed_msk, std::memory_order_acq_rel);
             };
@@ -237,6 +239,7 @@ namespace detail {
                 using bp_t = typename bp_ptr_t::element_type;
                 using receiver_t = typename state_t::template delegate<I>;
                 auto controller = &state_.controllers[I];
+                state_.group.attach_child(controller);
 
                 using runner_t = flow_runner<bp_t, receiver_t, decltype(controller)>;
                 runner_t runner(get<I>(this->packs).first(), controller, receiver_t(this));
@@ -284,6 +287,7 @@ namespace detail {
         int submit() noexcept {
             // when_all requires every blueprint to be present.
             UNLIKELY_IF (!all_bps_present(std::index_sequence_for<BPs...>{})) {
+                state_.group.detach();
                 return -1;
             }
 
@@ -292,6 +296,7 @@ namespace detail {
 #endif
                 auto ret = this->submit(std::index_sequence_for<BPs...>{});
                 UNLIKELY_IF (ret) {
+                    state_.group.detach();
                     return -1;
                 }
 
@@ -301,6 +306,7 @@ namespace detail {
                 UNLIKELY_IF (state_.fired.get().fetch_or(detail::launch_success_msk, std::memory_order_release) == 0) {
                     std::atomic_thread_fence(std::memory_order_acquire);
 #endif
+                    state_.group.detach();
                     auto i = state_.failed.get().load(std::memory_order_relaxed);
                     LIKELY_IF (i == N) {
                         this->resume(result_type(value_tag, result_delegate(this)));
@@ -311,20 +317,19 @@ namespace detail {
 
 #if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
             } catch (...) {
+                state_.group.detach();
                 return -1;
             }
 #endif
             return 0;
         }
 
-        void cancel() noexcept {
-            UNLIKELY_IF (state_.fired.get().load(std::memory_order_acquire) & detail::launch_failed_msk) {
-                return;
-            }
+        void attach_cancel_scope(flow_controller* parent) noexcept {
+            parent->attach_child(&state_.group);
+        }
 
-            for (size_t i = 0; i < N; ++i) {
-                state_.controllers[i].cancel(true);
-            }
+        // the group is linked below the runner's controller, whose cancel() walks it right after this.
+        void cancel() noexcept {
         }
     };
 
@@ -544,9 +549,11 @@ namespace detail {
         padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> fired;
         padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> winner;
         std::array<flow_controller, sizeof...(Ts)> controllers;
+        // parent of the launched branch controllers, see flow_when_all_state.
+        flow_controller group;
 
         flow_when_any_state() noexcept
-                : data{Ts(error_tag, typename Ts::error_type{})...}, fired(0), winner(sizeof...(Ts)), controllers{} {
+                : data{Ts(error_tag, typename Ts::error_type{})...}, fired(0), winner(sizeof...(Ts)), controllers{}, group{} {
         }
 
         struct result_delegate {
@@ -591,6 +598,7 @@ namespace detail {
                 auto *owner_raw = owner.get();
                 auto &state = owner_raw->state_;
                 value_type &e = get<I>(state.data);
+                state.controllers[I].detach();
 #if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
                 try {
 #endif
@@ -608,10 +616,9 @@ namespace detail {
                                                                           std::memory_order_relaxed)) {
                         i_won = true;
 
+                        state.group.detach();
                         owner_raw->resume(result_type(value_tag, typename state_t::result_delegate(owner)));
-                        for (size_t i = 0; i < sizeof...(Ts); ++i) {
-                            state.controllers[i].cancel(true);
-                        }
+                        state.group.cancel(true);
                     }
                 }
 
@@ -624,6 +631,7 @@ namespace detail {
 #endif
                     // nobody won and I am the last one. I have to tell the suspending runner we all failed.
                     UNLIKELY_IF (!i_won && state.winner.get().load(std::memory_order_acquire) == sizeof...(Ts)) {
+                        state.group.detach();
                         owner_raw->resume(result_type(error_tag, async_all_failed_error<flow_async_agg_err_t>::make()));
                         return;
                     }
@@ -865,6 +873,7 @@ namespace detail {
                 using bp_t = typename bp_ptr_t::element_type;
                 using receiver_t = typename state_t::template delegate<I>;
                 auto controller = &state_.controllers[I];
+                state_.group.attach_child(controller);
 
                 using runner_t = flow_runner<bp_t, receiver_t, decltype(controller)>;
                 runner_t runner(bp, controller, receiver_t(this));
@@ -915,6 +924,7 @@ namespace detail {
             auto ret = this->submit(std::index_sequence_for<BPs...>{});
 
             UNLIKELY_IF (ret == 0) {
+                state_.group.detach();
                 state_.fired.get().fetch_or(detail::launch_failed_msk, std::memory_order_release);
                 return -1;
             }
@@ -926,6 +936,7 @@ namespace detail {
                 std::atomic_thread_fence(std::memory_order_acquire);
 #endif
                 UNLIKELY_IF (state_.winner.get().load(std::memory_order_relaxed) == N) {
+                    state_.group.detach();
                     this->resume(result_type(error_tag, async_all_failed_error<flow_async_agg_err_t>::make()));
                 }
             }
@@ -933,14 +944,12 @@ namespace detail {
             return 0;
         }
 
-        void cancel() noexcept {
-            UNLIKELY_IF (state_.fired.get().load(std::memory_order_acquire) & detail::launch_failed_msk) {
-                return;
-            }
+        void attach_cancel_scope(flow_controller* parent) noexcept {
+            parent->attach_child(&state_.group);
+        }
 
-            for (size_t i = 0; i < N; ++i) {
-                state_.controllers[i].cancel(true);
-            }
+        // the group is linked below the runner's controller, whose cancel() walks it right after this.
+        void cancel() noexcept {
         }
     };
 
@@ -15,6 +15,12 @@
 #include "flow_def.h"
 
 namespace flux_foundry {
+    struct flow_controller;
+
+    // the continuation a runner hands to an awaitable, sized by FLUX_FOUNDRY_NEXT_STEP_SBO_SIZE.
+    template <typename R>
+    using awaitable_next_step_t = callable_wrapper<void(R&&), FLUX_FOUNDRY_NEXT_STEP_SBO_SIZE>;
+
     // Contract: Awaitables in flux_foundry MUST NOT start any side effects before submit_async() is called.
     template <typename derived, typename T, typename E>
     struct awaitable_base : public pooling_base<derived, FLUX_FOUNDRY_AWAITABLE_POOL_SLOT_COUNT> {
@@ -30,7 +36,7 @@ namespace flux_foundry {
             done, // Operation done, callback not run yet
         };
 
-        using next_step_t = callable_wrapper<void(result_t<T, E>&&)>;
+        using next_step_t = awaitable_next_step_t<result_t<T, E>>;
         std::atomic<wait_state> status;
         std::atomic<size_t> refcount;
         next_step_t next_step;
@@ -104,9 +110,26 @@ namespace flux_foundry {
                 self->retain();
             }
 
+            // an awaitable that runs flows of its own (when_all/when_any) links their controllers
+            // below `parent`, the controller of the runner submitting it. a no-op for the others.
+            void attach_cancel_scope(flow_controller* parent) noexcept {
+                attach_scope(static_cast<derived*>(self), parent, 0);
+            }
+
             void release() noexcept {
                 self->release();
             }
+
+        private:
+            template <typename D>
+            static auto attach_scope(D* d, flow_controller* parent, int) noexcept
+                -> decltype(d->attach_cancel_scope(parent), void()) {
+                d->attach_cancel_scope(parent);
+            }
+
+            template <typename D>
+            static void attach_scope(D*, flow_controller*, ...) noexcept {
+            }
         };
 
         // NEVER EVER CALL THIS BY HAND
@@ -150,6 +173,22 @@ namespace flux_foundry {
             do_resume(std::move(io_result));
         }
 
+        // resume() split in two, for awaitables whose completion consumes something that cancel
+        // would otherwise lose (e.g. a value popped from a channel):
+        // try_claim() wins the waiting -> done transition before anything is consumed,
+        // resume_claimed() then delivers the result. if try_claim() returns false the awaitable
+        // has already been canceled and the resource must be left untouched.
+        // the rules of resume() apply to resume_claimed() as well.
+        bool try_claim() noexcept {
+            auto expected = waiting;
+            return status.compare_exchange_strong(expected, done,
+                std::memory_order_acq_rel, std::memory_order_acquire);
+        }
+
+        void resume_claimed(result_t<T, E>&& io_result) noexcept {
+            do_resume(std::move(io_result));
+        }
+
         awaitable_base() noexcept
             : status{ idle }, refcount(1) {
         }
@@ -173,7 +212,7 @@ namespace flux_foundry {
     template <typename derived, typename T, typename E>
     struct fast_awaitable_base : public pooling_base<derived, FLUX_FOUNDRY_AWAITABLE_POOL_SLOT_COUNT> {
     private:
-        using next_step_t = callable_wrapper<void(result_t<T, E>&&)>;
+        using next_step_t = awaitable_next_step_t<result_t<T, E>>;
         std::atomic<size_t> refcount;
         next_step_t next_step;
 
@@ -347,12 +386,61 @@ namespace flux_foundry {
         }
     };
 
+    // same as awaitable_factory, but the awaitable is created with a context pointer
+    // (a semaphore, a channel ...) in front of the upstream output.
+    // the context is borrowed, it must outlive every runner of the blueprint. a Bound other than
+    // Context* is held by value instead (a shared handle such as a flow_aggregator).
+    template <typename awaitable, typename Context, typename Bound = Context*>
+    struct bound_awaitable_factory {
+        static_assert(is_awaitable_v<awaitable> || is_fast_awaitable_v<awaitable>,
+            "Awaitable must be a valid awaitable (inherits awaitable_base) "
+            "or fast_awaitable (inherits fast_awaitable_base).");
+
+        using node_error_t = typename awaitable::async_result_type::error_type;
+        using awaitable_t = awaitable;
+
+        Bound ctx;
+
+        template <typename A = awaitable, typename ... Args,
+#if FLUX_FOUNDRY_HAS_EXCEPTIONS
+            std::enable_if_t<std::is_constructible<A, Bound&, Args&&...>::value>* = nullptr
+#else
+            std::enable_if_t<std::is_nothrow_constructible<A, Bound&, Args&&...>::value>* = nullptr
+#endif
+        >
+        result_t<typename awaitable::access_delegate, node_error_t> operator()(Args&& ... param) noexcept {
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+            try {
+                auto aw = new awaitable(ctx, std::forward<Args>(param)...);
+                return result_t<typename awaitable::access_delegate, node_error_t>(value_tag, aw->delegate());
+            } catch (...) {
+                return result_t<typename awaitable::access_delegate, node_error_t>(error_tag, std::current_exception());
+            }
+#else
+            auto aw = new (std::nothrow) awaitable(ctx, std::forward<Args>(param)...);
+            UNLIKELY_IF (!aw) {
+                return result_t<typename awaitable::access_delegate, node_error_t>(error_tag, awaitable_creating_error<node_error_t>::make());
+            }
+
+            UNLIKELY_IF(!aw->available()) {
+                aw->release();
+                return result_t<typename awaitable::access_delegate, node_error_t>(error_tag, awaitable_creating_error<node_error_t>::make());
+            }
+
+            return result_t<typename awaitable::access_delegate, node_error_t>(value_tag, aw->delegate());
+#endif
+        }
+    };
+
     template <typename T>
     struct is_awaitable_factory : std::false_type {};
 
     template <typename awaitable>
     struct is_awaitable_factory<awaitable_factory<awaitable>> : std::true_type {};
 
+    template <typename awaitable, typename Context, typename Bound>
+    struct is_awaitable_factory<bound_awaitable_factory<awaitable, Context, Bound>> : std::true_type {};
+
     template <typename T>
     constexpr bool is_awaitable_factory_v = is_awaitable_factory<T>::value;
 
@@ -0,0 +1,269 @@
+#ifndef FLUX_FOUNDRY_FLOW_BATCH_H
+#define FLUX_FOUNDRY_FLOW_BATCH_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <new>
+
+#include "../base/inplace_base.h"
+#include "../memory/lite_ptr.h"
+#include "../memory/pooling.h"
+#include "../utility/back_off.h"
+#include "flow_runner.h"
+#include "flow_node.h"
+
+namespace flux_foundry {
+    // fixed-capacity buffer of up to N results, allocated from the pooling allocator,
+    // so a flushed batch returns its block to the (thread-local) pool cache when it is dropped.
+    template <typename R, size_t N>
+    class flow_batch final : public pooling_base<flow_batch<R, N>> {
+        static_assert(is_result_t<R>::value, "R must be a result_t");
+        static_assert(N > 0, "N must be greater than 0");
+        static_assert(conjunction_v<std::is_nothrow_move_constructible<R>, std::is_nothrow_destructible<R>>,
+            "R should be nothrow move constructible and nothrow destructible.");
+
+        raw_inplace_storage_base<R> items_[N];
+        size_t size_ = 0;
+
+    public:
+        using value_type = R;
+        static constexpr size_t capacity = N;
+
+        flow_batch() noexcept = default;
+
+        flow_batch(const flow_batch&) = delete;
+        flow_batch& operator=(const flow_batch&) = delete;
+
+        ~flow_batch() noexcept {
+            clear();
+        }
+
+        size_t size() const noexcept {
+            return size_;
+        }
+
+        bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        bool full() const noexcept {
+            return size_ == N;
+        }
+
+        R& operator[](size_t i) noexcept {
+            return *items_[i].ptr();
+        }
+
+        const R& operator[](size_t i) const noexcept {
+            return *items_[i].ptr();
+        }
+
+        // requires !full().
+        void push_back(R&& r) noexcept {
+            items_[size_++].construct(std::move(r));
+        }
+
+        void clear() noexcept {
+            while (size_) {
+                items_[--size_].destroy();
+            }
+        }
+    };
+
+    template <typename R, size_t N>
+    using batch_ptr = std::unique_ptr<flow_batch<R, N>>;
+
+namespace flow_impl {
+    template <typename T>
+    struct batch_ptr_traits : std::false_type {
+    };
+
+    template <typename R, size_t N>
+    struct batch_ptr_traits<batch_ptr<R, N>> : std::true_type {
+        using item_t = R;
+        static constexpr size_t capacity = N;
+    };
+}
+
+    // flow_batcher: fan-in point that groups the results of many flows into one batch.
+    //
+    // - push() appends a result to the open batch. the batch is flushed once it holds `limit`
+    //   items, or on the first push()/poll() after `max_delay` elapsed since its first item.
+    // - a flushed batch is handed, as result_t<batch_ptr<R, N>, E>, to a fresh runner of the sink
+    //   blueprint, dispatched on the flush executor; the first node of the sink is typically
+    //   the batched await (DB write, kernel launch, ...).
+    // - there is no timer in here: call poll() periodically (e.g. from the flush executor)
+    //   to bound the latency of a batch that stops filling up.
+    template <typename Executor, typename SinkBp, typename SinkReceiver>
+    class flow_batcher {
+        using sink_in_t = typename SinkBp::I_t;
+        using batch_traits = flow_impl::batch_ptr_traits<typename sink_in_t::value_type>;
+        static_assert(batch_traits::value, "the sink blueprint must take a batch_ptr<R, N> as its input.");
+
+    public:
+        using value_type = typename batch_traits::item_t;
+        using error_type = typename value_type::error_type;
+        using batch_t = flow_batch<value_type, batch_traits::capacity>;
+        using clock = std::chrono::steady_clock;
+
+    private:
+        std::atomic<bool> locked_ { false };
+        batch_ptr<value_type, batch_traits::capacity> open_;
+        clock::time_point opened_at_;
+
+        size_t limit_;
+        clock::duration max_delay_;
+        Executor exec_;
+        lite_ptr<SinkBp> sink_;
+        SinkReceiver receiver_;
+
+        void lock() noexcept {
+            for (backoff_strategy<> backoff;; backoff.yield()) {
+                if (!locked_.load(std::memory_order_relaxed)
+                    && !locked_.exchange(true, std::memory_order_acquire)) {
+                    return;
+                }
+            }
+        }
+
+        void unlock() noexcept {
+            locked_.store(false, std::memory_order_release);
+        }
+
+        void dispatch(batch_ptr<value_type, batch_traits::capacity>&& b) noexcept {
+            exec_->dispatch(task_wrapper_sbo([sink = sink_, receiver = receiver_, b = std::move(b)]() mutable noexcept {
+                auto runner = make_runner(std::move(sink), std::move(receiver));
+                runner(sink_in_t(value_tag, std::move(b)));
+            }));
+        }
+
+    public:
+        flow_batcher(size_t limit, clock::duration max_delay, Executor exec,
+            lite_ptr<SinkBp> sink, SinkReceiver receiver) noexcept
+            : limit_(limit == 0 || limit > batch_t::capacity ? batch_t::capacity : limit),
+              max_delay_(max_delay), exec_(std::move(exec)),
+              sink_(std::move(sink)), receiver_(std::move(receiver)) {
+        }
+
+        flow_batcher(const flow_batcher&) = delete;
+        flow_batcher& operator=(const flow_batcher&) = delete;
+
+        // the open batch is flushed, no item is dropped.
+        ~flow_batcher() noexcept {
+            flush();
+        }
+
+        // returns false if no batch could be allocated, r is dropped in that case.
+        bool push(value_type&& r) noexcept {
+            batch_ptr<value_type, batch_traits::capacity> ready;
+            {
+                lock();
+                const auto now = clock::now();
+                UNLIKELY_IF (!open_) {
+                    open_.reset(new (std::nothrow) batch_t());
+                    UNLIKELY_IF (!open_) {
+                        unlock();
+                        return false;
+                    }
+                    opened_at_ = now;
+                }
+
+                open_->push_back(std::move(r));
+                UNLIKELY_IF (open_->size() >= limit_ || now - opened_at_ >= max_delay_) {
+                    ready = std::move(open_);
+                }
+                unlock();
+            }
+
+            UNLIKELY_IF (ready) {
+                dispatch(std::move(ready));
+            }
+            return true;
+        }
+
+        // flushes the open batch if it is older than max_delay. returns true if a batch was flushed.
+        bool poll() noexcept {
+            batch_ptr<value_type, batch_traits::capacity> ready;
+            lock();
+            if (open_ && clock::now() - opened_at_ >= max_delay_) {
+                ready = std::move(open_);
+            }
+            unlock();
+
+            if (ready) {
+                dispatch(std::move(ready));
+                return true;
+            }
+            return false;
+        }
+
+        // flushes the open batch regardless of its size and age.
+        bool flush() noexcept {
+            batch_ptr<value_type, batch_traits::capacity> ready;
+            lock();
+            ready = std::move(open_);
+            unlock();
+
+            if (ready) {
+                dispatch(std::move(ready));
+                return true;
+            }
+            return false;
+        }
+    };
+
+    template <typename Executor, typename SinkBp, typename SinkReceiver,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto make_batcher(size_t limit, std::chrono::steady_clock::duration max_delay, Executor&& exec,
+        lite_ptr<SinkBp> sink, SinkReceiver receiver) {
+        static_assert(check_receiver_v<SinkReceiver>,
+            "a valid receiver should:\n"
+            "1. be nothrow move constructible.\n"
+            "2. be nothrow copy constructible.\n"
+            "in order to fully enable non-alloc in pipeline running, please make your receiver shared handle");
+        using batcher_t = flow_batcher<std::decay_t<Executor>, SinkBp, SinkReceiver>;
+        return make_lite_ptr<batcher_t>(limit, max_delay, std::forward<Executor>(exec), std::move(sink), std::move(receiver));
+    }
+
+    template <typename Executor, typename SinkBp,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto make_batcher(size_t limit, std::chrono::steady_clock::duration max_delay, Executor&& exec,
+        lite_ptr<SinkBp> sink) {
+        return make_batcher(limit, max_delay, std::forward<Executor>(exec), std::move(sink),
+            stub_receiver<typename SinkBp::O_t>());
+    }
+
+namespace flow_impl {
+    template <typename Batcher>
+    struct batch_node {
+        lite_ptr<Batcher> b;
+    };
+
+    template <typename I, typename O, typename... Nodes, typename Batcher>
+    auto operator|(flow_blueprint<I, O, Nodes...>&& bp, batch_node<Batcher>&& a) {
+        static_assert(std::is_same<O, typename Batcher::value_type>::value,
+            "the current output does not match the batcher's item type");
+
+        using E = typename O::error_type;
+        using F_O = result_t<void, E>;
+        auto wrapper = [b = std::move(a.b)](O&& in) noexcept {
+            LIKELY_IF (b->push(std::move(in))) {
+                return F_O(value_tag);
+            }
+            return F_O(error_tag, async_submission_failed_error<E>::make());
+        };
+
+        return std::move(bp) | flow_calc_node<O, F_O, decltype(wrapper)>(std::move(wrapper));
+    }
+}
+
+    // Hands the current result (value or error) to batcher b and outputs result_t<void, E>
+    // once it is queued; the batch itself continues in b's sink blueprint.
+    template <typename Batcher>
+    auto batch(lite_ptr<Batcher> b) noexcept {
+        return flow_impl::batch_node<Batcher> { std::move(b) };
+    }
+}
+
+#endif // FLUX_FOUNDRY_FLOW_BATCH_H
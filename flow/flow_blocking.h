@@ -0,0 +1,149 @@
+#ifndef FLUX_FOUNDRY_FLOW_BLOCKING_H
+#define FLUX_FOUNDRY_FLOW_BLOCKING_H
+
+#include "flow_awaitable.h"
+#include "flow_node.h"
+
+namespace flux_foundry {
+namespace detail {
+    template <typename F, typename T>
+    struct blocking_call_result {
+        using type = invoke_result_t<F&, T>;
+    };
+
+    template <typename F>
+    struct blocking_call_result<F, void> {
+        using type = invoke_result_t<F&>;
+    };
+
+    // runs f on the blocking pool, then resumes the flow from the pool thread
+    // (the node's executor hops back to where the flow should continue).
+    // an error input skips f and the pool hop.
+    template <typename F, typename Pool, typename T, typename E>
+    struct blocking_call_awaitable final : fast_awaitable_base<
+        blocking_call_awaitable<F, Pool, T, E>, typename blocking_call_result<F, T>::type, E> {
+        using F_O = typename blocking_call_result<F, T>::type;
+        using async_result_type = result_t<F_O, E>;
+
+        Pool pool;
+        F f;
+        result_t<T, E> in;
+
+        blocking_call_awaitable(Pool pool_, const F& f_, result_t<T, E>&& in_)
+            noexcept(conjunction_v<std::is_nothrow_copy_constructible<F>, std::is_nothrow_move_constructible<result_t<T, E>>>)
+            : pool(std::move(pool_)), f(f_), in(std::move(in_)) {
+        }
+
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+        bool available() noexcept {
+            return true;
+        }
+#endif
+
+        void run(std::false_type /* non-void input */) noexcept {
+            this->resume(flow_impl::call<F_O, E, F>(std::is_void<F_O>{}, std::false_type{}, f, std::move(in).value()));
+        }
+
+        void run(std::true_type /* void input */) noexcept {
+            this->resume(flow_impl::call<F_O, E, F>(std::is_void<F_O>{}, std::true_type{}, f, std::move(in)));
+        }
+
+        int submit() noexcept {
+            UNLIKELY_IF (in.has_error()) {
+                this->resume(async_result_type(error_tag, std::move(in).error()));
+                return 0;
+            }
+
+            pool->dispatch(task_wrapper_sbo([this]() noexcept {
+                run(std::is_void<T>{});
+            }));
+            return 0;
+        }
+    };
+
+    // holds the callable by value, every awaitable gets its own copy.
+    template <typename awaitable, typename F, typename Pool>
+    struct blocking_awaitable_factory {
+        using node_error_t = typename awaitable::async_result_type::error_type;
+        using awaitable_t = awaitable;
+
+        F f;
+        Pool pool;
+
+        template <typename Arg>
+        result_t<typename awaitable::access_delegate, node_error_t> operator()(Arg&& in) noexcept {
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+            try {
+                auto aw = new awaitable(pool, f, std::forward<Arg>(in));
+                return result_t<typename awaitable::access_delegate, node_error_t>(value_tag, aw->delegate());
+            } catch (...) {
+                return result_t<typename awaitable::access_delegate, node_error_t>(error_tag, std::current_exception());
+            }
+#else
+            auto aw = new (std::nothrow) awaitable(pool, f, std::forward<Arg>(in));
+            UNLIKELY_IF (!aw) {
+                return result_t<typename awaitable::access_delegate, node_error_t>(error_tag, awaitable_creating_error<node_error_t>::make());
+            }
+            return result_t<typename awaitable::access_delegate, node_error_t>(value_tag, aw->delegate());
+#endif
+        }
+    };
+}
+
+namespace flow_impl {
+    template <typename Executor, typename F, typename Pool>
+    struct blocking_node {
+        static_assert(check_executor<Executor>::value,
+            "Executor must be pointer-like and support "
+            "noexcept exec->dispatch(task_wrapper_sbo).");
+        static_assert(check_executor<Pool>::value,
+            "Pool must be pointer-like and support "
+            "noexcept pool->dispatch(task_wrapper_sbo).");
+
+        Executor e;
+        F f;
+        Pool pool;
+    };
+
+    template <typename I, typename O, typename... Nodes, typename Executor, typename F, typename Pool>
+    auto operator|(flow_blueprint<I, O, Nodes...>&& bp, blocking_node<Executor, F, Pool>&& a) {
+        using T = typename O::value_type;
+        using E = typename O::error_type;
+        static_assert(is_nothrow_invocable_with<F&, T>::value,
+            "The callable F is not compatible with current blueprint, "
+            "and must be nothrow-invocable.");
+
+        using awaitable_t = detail::blocking_call_awaitable<F, Pool, T, E>;
+        using F_O = typename awaitable_t::async_result_type;
+        using wrapper_t = dispatch_wrapper_t<Executor>;
+        using factory_t = detail::blocking_awaitable_factory<awaitable_t, F, Pool>;
+
+        return std::move(bp) | flow_async_node<O, F_O, wrapper_t, identity, factory_t> {
+            wrapper_t{std::move(a.e)}, identity{}, factory_t{std::move(a.f), std::move(a.pool)}
+        };
+    }
+}
+
+    // Runs `f` (called like a transform step) on `pool`, typically a blocking_pool, so blocking
+    // calls never occupy the executor the flow runs on, then resumes on `executor_to_resume`.
+    // `f` is copied into every in-flight call.
+    template <typename F, typename Pool, typename Executor,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto await_blocking(F&& f, Pool&& pool, Executor&& executor_to_resume) noexcept {
+        using E = std::decay_t<Executor>;
+        return flow_impl::blocking_node<E, std::decay_t<F>, std::decay_t<Pool>> {
+            std::forward<Executor>(executor_to_resume), std::forward<F>(f), std::forward<Pool>(pool)
+        };
+    }
+
+    // resumes on the pool thread that ran `f`.
+    template <typename F, typename Pool>
+    auto await_blocking(F&& f, Pool&& pool) noexcept {
+        using E = flow_impl::inline_executor*;
+        return flow_impl::blocking_node<E, std::decay_t<F>, std::decay_t<Pool>> {
+            flow_impl::inline_executor::executor(), std::forward<F>(f), std::forward<Pool>(pool)
+        };
+    }
+}
+
+#endif // FLUX_FOUNDRY_FLOW_BLOCKING_H
@@ -5,6 +5,7 @@
 
 #include "../memory/flat_storage.h"
 #include "../task/task_wrapper.h"
+#include "../executor/current_executor.h"
 #include "../base/traits.h"
 
 #include "flow_def.h"
@@ -22,6 +23,64 @@ namespace flux_foundry {
             }
         };
 
+        // the task type a dispatcher builds continuations in. An executor holding a larger task_wrapper
+        // publishes it as `task_type`, so a continuation capturing a runner and its result is built
+        // there directly instead of spilling out of task_wrapper_sbo.
+        template <typename D, typename = void>
+        struct dispatcher_task {
+            using type = task_wrapper_sbo;
+        };
+
+        template <typename D>
+        struct dispatcher_task<D, void_t<typename D::task_type>> {
+            using type = typename D::task_type;
+        };
+
+        template <typename D>
+        using dispatcher_task_t = typename dispatcher_task<std::decay_t<D>>::type;
+
+        // nesting depth of the continuations currently running inline on this thread.
+        inline size_t& inline_hop_depth() noexcept {
+            thread_local size_t depth = 0;
+            return depth;
+        }
+
+        // dispatcher of await_sticky(): resumes on the executor that ran the step submitting the
+        // awaitable. The blueprint holds an unbound one, the runner binds it at submit time with
+        // bind_dispatcher(). Outside of any executor the continuation runs inline.
+        struct sticky_dispatcher_t {
+            using executor_t = executor_ref;
+            executor_ref bound;
+
+            void operator()(task_wrapper_sbo&& sbo) noexcept {
+                auto exec = bound ? bound : executor_ref::current();
+                if (!exec) {
+                    sbo();
+                    return;
+                }
+
+                // already there, same budget as the coalesced hops of dispatch_wrapper_t.
+                auto& depth = inline_hop_depth();
+                if (exec == executor_ref::current() && depth < exec.inline_hop_budget()) {
+                    ++depth;
+                    sbo();
+                    --depth;
+                    return;
+                }
+                exec->dispatch(std::move(sbo));
+            }
+        };
+
+        // the dispatcher a pending async step captures for its resume.
+        template <typename Dispatcher>
+        const Dispatcher& bind_dispatcher(const Dispatcher& dispatcher) noexcept {
+            return dispatcher;
+        }
+
+        inline sticky_dispatcher_t bind_dispatcher(const sticky_dispatcher_t&) noexcept {
+            return sticky_dispatcher_t{executor_ref::current()};
+        }
+
         template <typename T, size_t... I, typename ... Ts>
         auto flat_storage_prepend_impl(T&& n, flat_storage<Ts...>&& t, std::index_sequence<I...>) {
             return flat_storage<std::decay_t<T>, Ts...>(std::forward<T>(n), get<I>(std::move(t))...);
@@ -88,50 +147,83 @@ namespace flux_foundry {
             constexpr static bool value = decltype(detect<G>(0))::value;
         };
 
+        // applies callables I..Last of a fused chain, each one to the result of the previous.
+        // every level is a one-line forwarder over a flat index, so the optimizer flattens the whole
+        // chain into straight-line code. it is deliberately not FORCE_INLINE: forcing it spends the
+        // inliner budget on the forwarders and leaves the step bodies out of line.
+        template <size_t I, size_t Last>
+        struct fused_invoke {
+            template <typename S, typename X>
+            static auto apply(S &fs, X &&x)
+            noexcept(noexcept(fused_invoke<I + 1, Last>::apply(fs, get<I>(fs)(std::forward<X>(x)))))
+            -> decltype(fused_invoke<I + 1, Last>::apply(fs, get<I>(fs)(std::forward<X>(x)))) {
+                return fused_invoke<I + 1, Last>::apply(fs, get<I>(fs)(std::forward<X>(x)));
+            }
+        };
+
+        template <size_t Last>
+        struct fused_invoke<Last, Last> {
+            template <typename S, typename X>
+            static auto apply(S &fs, X &&x)
+            noexcept(noexcept(get<Last>(fs)(std::forward<X>(x))))
+            -> decltype(get<Last>(fs)(std::forward<X>(x))) {
+                return get<Last>(fs)(std::forward<X>(x));
+            }
+        };
+
         // this only for private use
-        template <typename F, typename G>
-        struct zipped_callable {
-        public:
-            using F_T = std::decay_t<F>;
-            using G_T = std::decay_t<G>;
+        // a run of consecutive calc steps kept side by side in one flat_storage.
+        // appending a step yields fused_callable<Fs..., G>, the chain never nests.
+        template <typename... Fs>
+        struct fused_callable {
+            static_assert(sizeof...(Fs) >= 2, "fused_callable holds at least two callables");
 
-            zipped_callable() = delete;
+            using storage_type = flat_storage<Fs...>;
+            using invoke_type = fused_invoke<0, sizeof...(Fs) - 1>;
 
-            template <typename F_T_ = F_T, typename G_T_ = G_T>
-            zipped_callable(F_T_ &&f_, G_T_ &&g_)
-            noexcept(conjunction_v<std::is_nothrow_constructible<F_T, F_T_ &&>,
-                    std::is_nothrow_constructible<G_T, G_T_ &&>>)
-                    : fg(std::forward<F_T_>(f_), std::forward<G_T_>(g_)) {
+            storage_type fs;
+
+            fused_callable() = delete;
+
+            template <typename... Args,
+                    typename = std::enable_if_t<sizeof...(Args) == sizeof...(Fs)>>
+            explicit fused_callable(Args &&... args)
+            noexcept(std::is_nothrow_constructible<storage_type, Args &&...>::value)
+                    : fs(std::forward<Args>(args)...) {
             }
 
             template <typename X>
             auto operator()(X &&x)
-            noexcept(noexcept(std::declval<G_T &>()(std::declval<F_T &>()(std::forward<X>(x))))) {
-                return fg.second()(fg.first()(std::forward<X>(x)));
+            noexcept(noexcept(invoke_type::apply(std::declval<storage_type &>(), std::forward<X>(x)))) {
+                return invoke_type::apply(fs, std::forward<X>(x));
             }
 
             template <typename X>
             auto operator()(X &&x) const
-            noexcept(noexcept(std::declval<const G_T &>()(std::declval<const F_T &>()(std::forward<X>(x))))) {
-                return fg.second()(fg.first()(std::forward<X>(x)));
+            noexcept(noexcept(invoke_type::apply(std::declval<const storage_type &>(), std::forward<X>(x)))) {
+                return invoke_type::apply(fs, std::forward<X>(x));
             }
-
-        private:
-            compressed_pair<F_T, G_T> fg;
         };
 
+        template <typename... Fs, typename G, size_t... I>
+        auto fuse_callables_impl(fused_callable<Fs...> &&f, G &&g, std::index_sequence<I...>)
+        noexcept(std::is_nothrow_constructible<fused_callable<Fs..., std::decay_t<G>>,
+                Fs &&..., G &&>::value) {
+            return fused_callable<Fs..., std::decay_t<G>>(get<I>(std::move(f.fs))..., std::forward<G>(g));
+        }
+
         template <typename F, typename G>
-        auto zip_callables(F &&f, G &&g)
+        auto fuse_callables(F &&f, G &&g)
         noexcept(std::is_nothrow_constructible<
-                zipped_callable<std::decay_t<F>, std::decay_t<G>>, F &&, G &&>::value) {
-            return zipped_callable<std::decay_t<F>, std::decay_t<G>>(
-                    std::forward<F>(f), std::forward<G>(g)
-            );
+                fused_callable<std::decay_t<F>, std::decay_t<G>>, F &&, G &&>::value) {
+            return fused_callable<std::decay_t<F>, std::decay_t<G>>(std::forward<F>(f), std::forward<G>(g));
         }
 
-        template <typename F, typename G, typename... Os>
-        auto zip_callables(F &&f, G &&g, Os &&... os) {
-            return zip_callables(zip_callables(std::forward<F>(f), std::forward<G>(g)), std::forward<Os>(os)...);
+        // appending to an existing chain moves its callables into a one-longer flat list.
+        template <typename... Fs, typename G>
+        auto fuse_callables(fused_callable<Fs...> &&f, G &&g)
+        noexcept(noexcept(fuse_callables_impl(std::move(f), std::forward<G>(g), std::index_sequence_for<Fs...>{}))) {
+            return fuse_callables_impl(std::move(f), std::forward<G>(g), std::index_sequence_for<Fs...>{});
         }
 
         using node_tag_unknown = std::integral_constant<size_t, 0>;
@@ -167,9 +259,9 @@ namespace flux_foundry {
         template <typename F_I, typename F_O, typename F, size_t F_N,
                 typename G_I, typename G_O, typename G>
         auto operator|(flow_calc_node<F_I, F_O, F, F_N> a, flow_calc_node<G_I, G_O, G> b)
-        noexcept(noexcept(zip_callables(std::move(a.f), std::move(b.f)))) {
-            using zipped_t = decltype(zip_callables(std::declval<F>(), std::declval<G>()));
-            return flow_calc_node<F_I, G_O, zipped_t, F_N + 1>(zip_callables(std::move(a.f), std::move(b.f)));
+        noexcept(noexcept(fuse_callables(std::move(a.f), std::move(b.f)))) {
+            using fused_t = decltype(fuse_callables(std::declval<F>(), std::declval<G>()));
+            return flow_calc_node<F_I, G_O, fused_t, F_N + 1>(fuse_callables(std::move(a.f), std::move(b.f)));
         }
 
         // flow control
@@ -363,6 +455,8 @@ namespace flux_foundry {
         template <typename P_I, typename P_O, typename P,
                 typename I, typename O, typename F, typename F_I, typename F_O, size_t N, typename... Others>
         auto operator|(flow_blueprint<I, O, flow_calc_node<F_I, F_O, F, N>, Others...>&& bp, flow_via_node<P_I, P_O, P>&& b) {
+            static_assert(!is_borrowed<typename O::value_type>::value,
+                "a borrowed input cannot cross a via step, transform it into an owned value first");
             return flow_blueprint<I, O, flow_via_node<P_I, P_O, P>, flow_calc_node<F_I, F_O, F, N>, Others...>(
                     flat_storage_prepend(std::move(b), std::move(bp.nodes_))
             );
@@ -375,6 +469,8 @@ namespace flux_foundry {
         {
             static_assert(is_invocable_with<A_DF, O>::value,
                 "async node's delegate factory doesn't accept with the current blueprint's output type");
+            static_assert(!is_borrowed<typename O::value_type>::value,
+                "a borrowed input cannot cross an async step, transform it into an owned value first");
             return flow_blueprint<I, A_O, flow_async_node<A_I, A_O, A_E, A_A, A_DF>, flow_calc_node<F_I, F_O, F, N>, Others...>(
                 flat_storage_prepend(std::move(b), std::move(bp.nodes_)));
         }
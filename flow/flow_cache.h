@@ -0,0 +1,542 @@
+#ifndef FLUX_FOUNDRY_FLOW_CACHE_H
+#define FLUX_FOUNDRY_FLOW_CACHE_H
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+#include "../memory/padded_t.h"
+#include "../memory/inplace_t.h"
+#include "../utility/back_off.h"
+#include "flow_node.h"
+
+namespace flux_foundry {
+namespace detail {
+    // a flow parked on a key whose value is being computed.
+    // `wake` is invoked exactly once, outside the shard lock, with the result of the fill.
+    template <typename R>
+    struct cache_waiter {
+        using wake_t = void (*)(cache_waiter*, const R&);
+
+        cache_waiter* prev { nullptr };
+        cache_waiter* next { nullptr };
+        wake_t wake { nullptr };
+        void* owner { nullptr };
+        bool linked { false };
+    };
+}
+
+    struct flow_cache_stats {
+        size_t hits;
+        size_t misses;
+        size_t coalesced;
+        size_t evictions;
+    };
+
+    // flow_cache: concurrent, bounded result cache for flows, see cached<Awaitable>(...).
+    //
+    // - keys are spread over `Shards` shards, each guarded by its own test-and-test-and-set lock.
+    // - every shard owns capacity / Shards value slots, recycled with CLOCK (second chance):
+    //   a hit sets the slot's reference bit, the eviction hand clears it once before evicting.
+    // - a value older than `ttl` is a miss, its slot is freed on the spot.
+    // - only successful results are cached. the first miss on a key becomes the leader and
+    //   computes the value, concurrent misses on the same key park on it (coalesced) and all
+    //   resume from that single result, errors included.
+    template <typename K, typename V, typename E = std::exception_ptr,
+        size_t Shards = 16, typename Hash = std::hash<K>>
+    class flow_cache {
+        static_assert(Shards > 0 && (Shards & (Shards - 1)) == 0, "Shards must be power of 2");
+        static_assert(conjunction_v<std::is_nothrow_copy_constructible<V>, std::is_nothrow_destructible<V>>,
+            "V should be nothrow copy constructible and nothrow destructible, every hit copies it out.");
+
+    public:
+        using key_type = K;
+        using value_type = V;
+        using error_type = E;
+        using result_type = result_t<V, E>;
+        using waiter_t = detail::cache_waiter<result_type>;
+        using clock = std::chrono::steady_clock;
+
+        enum class lookup_status {
+            hit,       // the value is copied out.
+            joined,    // the key is being computed, w is parked.
+            lead,      // the key is missing, w is parked and the caller must compute it and fill().
+            bypass,    // the index could not grow, compute the value without caching it.
+        };
+
+    private:
+        static constexpr size_t npos = ~size_t(0);
+
+        struct entry {
+            const K* key { nullptr };
+            size_t slot { npos };
+            waiter_t* head { nullptr };
+            waiter_t* tail { nullptr };
+            bool filling { false };
+        };
+
+        struct slot_t {
+            entry* owner { nullptr };
+            clock::time_point stored_at;
+            bool referenced { false };
+            inplace_t<V> value;
+        };
+
+        struct shard {
+            std::atomic<bool> locked { false };
+            std::unordered_map<K, entry, Hash> index;
+            std::unique_ptr<slot_t[]> slots;
+            size_t used = 0;
+            size_t hand = 0;
+
+            void lock() noexcept {
+                for (backoff_strategy<> backoff;; backoff.yield()) {
+                    if (!locked.load(std::memory_order_relaxed)
+                        && !locked.exchange(true, std::memory_order_acquire)) {
+                        return;
+                    }
+                }
+            }
+
+            void unlock() noexcept {
+                locked.store(false, std::memory_order_release);
+            }
+        };
+
+        struct shard_guard {
+            shard& s;
+
+            explicit shard_guard(shard& s_) noexcept : s(s_) {
+                s.lock();
+            }
+
+            ~shard_guard() noexcept {
+                s.unlock();
+            }
+
+            shard_guard(const shard_guard&) = delete;
+            shard_guard& operator=(const shard_guard&) = delete;
+        };
+
+        padded_t<shard, CACHE_LINE_SIZE> shards_[Shards];
+        size_t shard_cap_;
+        clock::duration ttl_;
+        Hash hash_;
+
+        padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> hits_ { 0 };
+        padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> misses_ { 0 };
+        padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> coalesced_ { 0 };
+        padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> evictions_ { 0 };
+
+        shard& shard_of(const K& key) noexcept {
+            auto h = static_cast<size_t>(hash_(key));
+            // the low bits pick the bucket inside the shard, use the high ones here.
+            h ^= h >> 17;
+            h *= size_t(0x9E3779B97F4A7C15ull);
+            return shards_[(h >> (sizeof(size_t) * 8 - 8)) & (Shards - 1)].get();
+        }
+
+        static void link(entry& e, waiter_t* w) noexcept {
+            w->next = nullptr;
+            w->prev = e.tail;
+            w->linked = true;
+            if (e.tail) {
+                e.tail->next = w;
+            } else {
+                e.head = w;
+            }
+            e.tail = w;
+        }
+
+        static void free_slot(shard& s, entry& e) noexcept {
+            auto& sl = s.slots[e.slot];
+            sl.value.destroy();
+            sl.owner = nullptr;
+            sl.referenced = false;
+            e.slot = npos;
+        }
+
+        // CLOCK: take a never used slot, or sweep until an empty or unreferenced one shows up.
+        size_t take_slot(shard& s) noexcept {
+            LIKELY_IF (s.used < shard_cap_) {
+                return s.used++;
+            }
+
+            for (;;) {
+                auto i = s.hand;
+                s.hand = s.hand + 1 == shard_cap_ ? 0 : s.hand + 1;
+
+                auto& sl = s.slots[i];
+                if (!sl.owner) {
+                    return i;
+                }
+                if (sl.referenced) {
+                    sl.referenced = false;
+                    continue;
+                }
+
+                auto victim = sl.owner;
+                free_slot(s, *victim);
+                s.index.erase(s.index.find(*victim->key));
+                evictions_.get().fetch_add(1, std::memory_order_relaxed);
+                return i;
+            }
+        }
+
+    public:
+        // capacity is the total number of cached values, split evenly across the shards.
+        explicit flow_cache(size_t capacity, clock::duration ttl = clock::duration::max())
+            : shard_cap_(capacity > Shards ? (capacity + Shards - 1) / Shards : 1), ttl_(ttl) {
+            for (auto& s : shards_) {
+                s.get().slots.reset(new slot_t[shard_cap_]);
+            }
+        }
+
+        flow_cache(const flow_cache&) = delete;
+        flow_cache& operator=(const flow_cache&) = delete;
+
+        // looks key up. on a hit the value is emplaced into out.
+        // otherwise w is parked on the key, and its wake is called once the value is filled.
+        lookup_status lookup_or_join(const K& key, waiter_t* w, inplace_t<V>& out) noexcept {
+            auto& s = shard_of(key);
+            shard_guard g(s);
+
+            entry* e = nullptr;
+            auto it = s.index.find(key);
+            if (it != s.index.end()) {
+                e = &it->second;
+                LIKELY_IF (e->slot != npos) {
+                    auto& sl = s.slots[e->slot];
+                    LIKELY_IF (clock::now() - sl.stored_at < ttl_) {
+                        sl.referenced = true;
+                        out.emplace(sl.value.get());
+                        hits_.get().fetch_add(1, std::memory_order_relaxed);
+                        return lookup_status::hit;
+                    }
+                    free_slot(s, *e);
+                } else if (e->filling) {
+                    link(*e, w);
+                    coalesced_.get().fetch_add(1, std::memory_order_relaxed);
+                    return lookup_status::joined;
+                }
+            } else {
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+                try {
+#endif
+                    it = s.index.emplace(key, entry{}).first;
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+                } catch (...) {
+                    misses_.get().fetch_add(1, std::memory_order_relaxed);
+                    return lookup_status::bypass;
+                }
+#endif
+                e = &it->second;
+                e->key = &it->first;
+            }
+
+            e->filling = true;
+            link(*e, w);
+            misses_.get().fetch_add(1, std::memory_order_relaxed);
+            return lookup_status::lead;
+        }
+
+        // unparks w. returns false if w has already been taken by fill().
+        bool leave(const K& key, waiter_t* w) noexcept {
+            auto& s = shard_of(key);
+            shard_guard g(s);
+            UNLIKELY_IF (!w->linked) {
+                return false;
+            }
+
+            auto& e = s.index.find(key)->second;
+            if (w->prev) {
+                w->prev->next = w->next;
+            } else {
+                e.head = w->next;
+            }
+            if (w->next) {
+                w->next->prev = w->prev;
+            } else {
+                e.tail = w->prev;
+            }
+            w->next = w->prev = nullptr;
+            w->linked = false;
+            return true;
+        }
+
+        // the leader publishes the result of key: a value is cached, an error is not.
+        // every flow parked on key is resumed with r, on the calling thread.
+        void fill(const K& key, const result_type& r) noexcept {
+            auto& s = shard_of(key);
+            waiter_t* w = nullptr;
+            {
+                shard_guard g(s);
+                auto it = s.index.find(key);
+                auto& e = it->second;
+                w = e.head;
+                for (auto p = w; p; p = p->next) {
+                    p->prev = nullptr;
+                    p->linked = false;
+                }
+                e.head = e.tail = nullptr;
+                e.filling = false;
+
+                LIKELY_IF (r.has_value()) {
+                    auto i = take_slot(s);
+                    auto& sl = s.slots[i];
+                    sl.owner = &e;
+                    sl.stored_at = clock::now();
+                    sl.referenced = false;
+                    sl.value.emplace(r.value());
+                    e.slot = i;
+                } else {
+                    s.index.erase(it);
+                }
+            }
+
+            while (w) {
+                auto next = w->next;
+                w->next = nullptr;
+                w->wake(w, r);
+                w = next;
+            }
+        }
+
+        // drops the cached value of key, a fill in progress is not affected.
+        void invalidate(const K& key) noexcept {
+            auto& s = shard_of(key);
+            shard_guard g(s);
+            auto it = s.index.find(key);
+            // a key being filled has no slot, it is left alone.
+            if (it != s.index.end() && it->second.slot != npos) {
+                free_slot(s, it->second);
+                s.index.erase(it);
+            }
+        }
+
+        flow_cache_stats stats() const noexcept {
+            return flow_cache_stats {
+                hits_.get().load(std::memory_order_relaxed),
+                misses_.get().load(std::memory_order_relaxed),
+                coalesced_.get().load(std::memory_order_relaxed),
+                evictions_.get().load(std::memory_order_relaxed),
+            };
+        }
+    };
+
+namespace detail {
+    // looks the key of its input up in the cache. the leader of a miss creates the wrapped
+    // Awaitable from the input and submits it, its result is filled into the cache.
+    // the fill is never canceled: a canceled flow only leaves the waiter list, the others
+    // (and the cache) still get the value.
+    template <typename Awaitable, typename Cache, typename KeyFn, typename I>
+    struct cached_awaitable final
+        : awaitable_base<cached_awaitable<Awaitable, Cache, KeyFn, I>,
+            typename Cache::value_type, typename Cache::error_type> {
+        using async_result_type = typename Cache::result_type;
+        using error_type = typename Cache::error_type;
+        using key_type = typename Cache::key_type;
+        using waiter_t = typename Cache::waiter_t;
+
+        static_assert(std::is_same<typename Awaitable::async_result_type, async_result_type>::value,
+            "the awaitable's async result must be result_t<V, E> of the cache");
+        static_assert(std::is_same<typename I::error_type, error_type>::value,
+            "the current error type does not match the cache's error type");
+
+        Cache* cache;
+        waiter_t waiter;
+        inplace_t<key_type> key;
+        I in;
+
+        cached_awaitable(Cache* cache_, const KeyFn& key_fn, I&& in_)
+            noexcept(noexcept(key_type(key_fn(std::declval<const typename I::value_type&>()))))
+            : cache(cache_), in(std::move(in_)) {
+            waiter.wake = on_wake;
+            waiter.owner = this;
+            LIKELY_IF (in.has_value()) {
+                key.emplace(key_fn(static_cast<const I&>(in).value()));
+            }
+        }
+
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+        bool available() const noexcept {
+            return true;
+        }
+#endif
+
+        static void on_wake(waiter_t* w, const async_result_type& r) noexcept {
+            auto self = static_cast<cached_awaitable*>(w->owner);
+            self->resume(async_result_type(r));
+            self->release();
+        }
+
+        // the fill step of the wrapped awaitable, it outlives this awaitable.
+        struct fill_step {
+            Cache* cache;
+            key_type key;
+
+            void operator()(async_result_type&& r) noexcept {
+                cache->fill(key, r);
+            }
+        };
+
+        // bypass: nothing is cached, the result goes straight to this flow.
+        struct direct_step {
+            cached_awaitable* self;
+
+            void operator()(async_result_type&& r) noexcept {
+                self->resume(std::move(r));
+                self->release();
+            }
+        };
+
+        // starts the wrapped awaitable with step as its continuation.
+        // returns false if it could not be created or submitted, step is dropped and err holds the reason.
+        template <typename Step>
+        bool launch(Step&& step, inplace_t<error_type>& err) noexcept {
+            auto made = awaitable_factory<Awaitable>{}(std::move(in));
+            UNLIKELY_IF (!made.has_value()) {
+                err.emplace(std::move(made.error()));
+                return false;
+            }
+
+            auto& inner = made.value();
+            inner.emplace_nextstep(awaitable_next_step_t<async_result_type>(std::forward<Step>(step)));
+            UNLIKELY_IF (inner.submit_async() != 0) {
+                inner.release();
+                err.emplace(async_submission_failed_error<error_type>::make());
+                return false;
+            }
+            return true;
+        }
+
+        int submit() noexcept {
+            UNLIKELY_IF (!in.has_value()) {
+                this->resume(async_result_type(error_tag, std::move(in.error())));
+                return 0;
+            }
+
+            // reference held by the cache (or the bypassed awaitable) until this flow is resumed
+            this->retain();
+            inplace_t<typename Cache::value_type> hit;
+            inplace_t<error_type> err;
+            switch (cache->lookup_or_join(key.get(), &waiter, hit)) {
+                case Cache::lookup_status::hit:
+                    this->release();
+                    this->resume(async_result_type(value_tag, std::move(hit.get())));
+                    break;
+                case Cache::lookup_status::lead:
+                    UNLIKELY_IF (!launch(fill_step{ cache, key.get() }, err)) {
+                        cache->fill(key.get(), async_result_type(error_tag, std::move(err.get())));
+                    }
+                    break;
+                case Cache::lookup_status::bypass:
+                    UNLIKELY_IF (!launch(direct_step{ this }, err)) {
+                        this->release();
+                        this->resume(async_result_type(error_tag, std::move(err.get())));
+                    }
+                    break;
+                default:
+                    break;
+            }
+            return 0;
+        }
+
+        void cancel() noexcept {
+            // bypassed: the wrapped awaitable still resumes (and drops) us later.
+            LIKELY_IF (key.has_value() && cache->leave(key.get(), &waiter)) {
+                this->release();
+            }
+        }
+    };
+
+    template <typename awaitable, typename Cache, typename KeyFn>
+    struct cached_awaitable_factory {
+        using node_error_t = typename awaitable::async_result_type::error_type;
+        using awaitable_t = awaitable;
+
+        Cache* cache;
+        KeyFn key_fn;
+
+        template <typename I>
+        result_t<typename awaitable::access_delegate, node_error_t> operator()(I&& in) noexcept {
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+            try {
+                auto aw = new awaitable(cache, key_fn, std::forward<I>(in));
+                return result_t<typename awaitable::access_delegate, node_error_t>(value_tag, aw->delegate());
+            } catch (...) {
+                return result_t<typename awaitable::access_delegate, node_error_t>(error_tag, std::current_exception());
+            }
+#else
+            auto aw = new (std::nothrow) awaitable(cache, key_fn, std::forward<I>(in));
+            UNLIKELY_IF (!aw) {
+                return result_t<typename awaitable::access_delegate, node_error_t>(error_tag, awaitable_creating_error<node_error_t>::make());
+            }
+            return result_t<typename awaitable::access_delegate, node_error_t>(value_tag, aw->delegate());
+#endif
+        }
+    };
+}
+
+namespace flow_impl {
+    template <typename Executor, typename Awaitable, typename Cache, typename KeyFn>
+    struct cached_node {
+        static_assert(check_executor<Executor>::value,
+            "Executor must be pointer-like and support "
+            "noexcept exec->dispatch(task_wrapper_sbo).");
+
+        static_assert(is_awaitable_v<Awaitable> || is_fast_awaitable_v<Awaitable>,
+            "Awaitable must be an valid awaitable(see flux_foundry::awaitable_base)\n"
+            "or a valid fast_awaitable(see flux_foundry::fast_awaitable_base)");
+
+        Executor e;
+        Cache* cache;
+        KeyFn key_fn;
+    };
+
+    template <typename I, typename O, typename... Nodes, typename Executor, typename Awaitable, typename Cache, typename KeyFn>
+    auto operator|(flow_blueprint<I, O, Nodes...>&& bp, cached_node<Executor, Awaitable, Cache, KeyFn>&& a) {
+        static_assert(std::is_constructible<Awaitable, O&&>::value,
+            "awaitable must could be constructible with the current output.");
+        static_assert(std::is_convertible<decltype(std::declval<const KeyFn&>()(std::declval<const typename O::value_type&>())),
+            typename Cache::key_type>::value, "key_fn must map the current value to the cache's key_type");
+
+        using awaitable_t = detail::cached_awaitable<Awaitable, Cache, KeyFn, O>;
+        using F_O = typename awaitable_t::async_result_type;
+        using wrapper_t = dispatch_wrapper_t<Executor>;
+        using factory_t = detail::cached_awaitable_factory<awaitable_t, Cache, KeyFn>;
+
+        return std::move(bp) | flow_async_node<O, F_O, wrapper_t, identity, factory_t> {
+            wrapper_t{std::move(a.e)}, identity{}, factory_t{a.cache, std::move(a.key_fn)}
+        };
+    }
+}
+
+    // Same as await<Awaitable>(...), memoized in cache under key_fn(current value).
+    // - hit: the cached value is forwarded without creating the Awaitable.
+    // - miss: the Awaitable is created from the current output and submitted once per key,
+    //   concurrent misses on that key wait for the same result.
+    // - error inputs pass through. the cache is borrowed, it must outlive every runner of the blueprint.
+    template <typename Awaitable, typename Cache, typename KeyFn, typename Executor,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto cached(Cache& cache, KeyFn&& key_fn, Executor&& executor_to_resume) noexcept {
+        using E = std::decay_t<Executor>;
+        return flow_impl::cached_node<E, Awaitable, Cache, std::decay_t<KeyFn>> {
+            std::forward<Executor>(executor_to_resume), &cache, std::forward<KeyFn>(key_fn)
+        };
+    }
+
+    // resume on the thread that completes the fill (or the submitting thread on a hit).
+    template <typename Awaitable, typename Cache, typename KeyFn>
+    auto cached(Cache& cache, KeyFn&& key_fn) noexcept {
+        using E = flow_impl::inline_executor*;
+        return flow_impl::cached_node<E, Awaitable, Cache, std::decay_t<KeyFn>> {
+            flow_impl::inline_executor::executor(), &cache, std::forward<KeyFn>(key_fn)
+        };
+    }
+}
+
+#endif // FLUX_FOUNDRY_FLOW_CACHE_H
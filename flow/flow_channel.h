@@ -0,0 +1,322 @@
+#ifndef FLUX_FOUNDRY_FLOW_CHANNEL_H
+#define FLUX_FOUNDRY_FLOW_CHANNEL_H
+
+#include <atomic>
+#include "../memory/inplace_t.h"
+#include "../utility/concurrent_queues.h"
+#include "flow_semaphore.h"
+
+namespace flux_foundry {
+    // async_channel: bounded MPMC hand-off between flows.
+    //
+    // two semaphores account for the ring buffer: `slots` (free capacity) and `items` (ready values).
+    // a sender takes a slot permit, pushes into the mpmc_queue and hands an item permit to the next
+    // receiver, a receiver does the reverse. holding a permit guarantees the queue operation succeeds,
+    // so neither side ever spins on a full/empty ring; they park on the semaphore instead.
+    //
+    // close():
+    // - parked and future senders fail with closed_error<E>.
+    // - receivers keep draining the buffered values, then fail with closed_error<E> (end of stream).
+    template <typename T, size_t capacity>
+    class async_channel {
+        static_assert(conjunction_v<std::is_nothrow_move_constructible<T>, std::is_nothrow_destructible<T>>,
+            "T should be nothrow move constructible and nothrow destructible.");
+
+        mpmc_queue<T, capacity> q_;
+        async_semaphore slots_;
+        async_semaphore items_;
+
+    public:
+        using value_type = T;
+
+        async_channel() noexcept
+            : q_(), slots_(capacity), items_(0) {
+        }
+
+        async_channel(const async_channel&) = delete;
+        async_channel& operator=(const async_channel&) = delete;
+
+        bool try_send(T&& v) noexcept {
+            UNLIKELY_IF (is_closed() || !slots_.try_acquire()) {
+                return false;
+            }
+            push(std::move(v));
+            return true;
+        }
+
+        inplace_t<T> try_recv() noexcept {
+            inplace_t<T> res;
+            LIKELY_IF (items_.try_acquire()) {
+                res.emplace(pop());
+            }
+            return res;
+        }
+
+        void close() noexcept {
+            slots_.close();
+            items_.close();
+        }
+
+        bool is_closed() const noexcept {
+            return slots_.is_closed();
+        }
+
+        // number of buffered values, for diagnostics only.
+        size_t size() const noexcept {
+            return items_.available();
+        }
+
+        // the functions below require a permit of the matching semaphore.
+        async_semaphore& slots() noexcept {
+            return slots_;
+        }
+
+        async_semaphore& items() noexcept {
+            return items_;
+        }
+
+        void push(T&& v) noexcept {
+            q_.wait_and_emplace(std::move(v));
+            items_.release();
+        }
+
+        T pop() noexcept {
+            T v = q_.wait_and_pop();
+            slots_.release();
+            return v;
+        }
+    };
+
+namespace detail {
+    template <typename Channel, typename R>
+    struct channel_send_awaitable final
+        : awaitable_base<channel_send_awaitable<Channel, R>, void, typename R::error_type> {
+        using error_type = typename R::error_type;
+        using async_result_type = result_t<void, error_type>;
+
+        Channel* ch;
+        flow_waiter waiter;
+        R in;
+
+        channel_send_awaitable(Channel* ch_, R&& in_)
+            noexcept(std::is_nothrow_move_constructible<R>::value)
+            : ch(ch_), in(std::move(in_)) {
+            waiter.wake = on_wake;
+            waiter.owner = this;
+        }
+
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+        bool available() const noexcept {
+            return true;
+        }
+#endif
+
+        // called with a slot permit held. the value is only published once the awaitable is claimed,
+        // a canceled send passes the permit on instead.
+        void send_and_resume() noexcept {
+            UNLIKELY_IF (!this->try_claim()) {
+                ch->slots().release();
+                return;
+            }
+            ch->push(typename Channel::value_type(std::move(in).value()));
+            this->resume_claimed(async_result_type(value_tag));
+        }
+
+        static void on_wake(flow_waiter* w) noexcept {
+            auto self = static_cast<channel_send_awaitable*>(w->owner);
+            UNLIKELY_IF (w->closed) {
+                self->resume(async_result_type(error_tag, closed_error<error_type>::make()));
+            } else {
+                self->send_and_resume();
+            }
+            self->release();
+        }
+
+        int submit() noexcept {
+            UNLIKELY_IF (!in.has_value()) {
+                this->resume(async_result_type(error_tag, std::move(in).error()));
+                return 0;
+            }
+
+            UNLIKELY_IF (ch->is_closed()) {
+                this->resume(async_result_type(error_tag, closed_error<error_type>::make()));
+                return 0;
+            }
+
+            // reference held by the channel while parked
+            this->retain();
+            switch (ch->slots().acquire_or_park(&waiter)) {
+                case async_semaphore::acquire_status::acquired:
+                    this->release();
+                    send_and_resume();
+                    break;
+                case async_semaphore::acquire_status::closed:
+                    this->release();
+                    this->resume(async_result_type(error_tag, closed_error<error_type>::make()));
+                    break;
+                default:
+                    break;
+            }
+            return 0;
+        }
+
+        // the status is already done here: if the waiter has been popped, on_wake() fails to claim
+        // the awaitable and hands the permit back itself.
+        void cancel() noexcept {
+            LIKELY_IF (ch->slots().cancel_park(&waiter)) {
+                this->release();
+            }
+        }
+    };
+
+    template <typename Channel, typename R>
+    struct channel_recv_awaitable final
+        : awaitable_base<channel_recv_awaitable<Channel, R>, typename Channel::value_type, typename R::error_type> {
+        using error_type = typename R::error_type;
+        using async_result_type = result_t<typename Channel::value_type, error_type>;
+
+        Channel* ch;
+        flow_waiter waiter;
+        error_type upstream_error;
+        bool upstream_failed;
+
+        channel_recv_awaitable(Channel* ch_, R&& in_)
+            noexcept(std::is_nothrow_move_constructible<error_type>::value
+                && std::is_nothrow_default_constructible<error_type>::value)
+            : ch(ch_), upstream_error(), upstream_failed(!in_.has_value()) {
+            UNLIKELY_IF (upstream_failed) {
+                upstream_error = std::move(in_).error();
+            }
+            waiter.wake = on_wake;
+            waiter.owner = this;
+        }
+
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+        bool available() const noexcept {
+            return true;
+        }
+#endif
+
+        // called with an item permit held. the value is only popped once the awaitable is claimed,
+        // on a canceled receive it stays buffered and the permit is passed on.
+        void recv_and_resume() noexcept {
+            UNLIKELY_IF (!this->try_claim()) {
+                ch->items().release();
+                return;
+            }
+            this->resume_claimed(async_result_type(value_tag, ch->pop()));
+        }
+
+        static void on_wake(flow_waiter* w) noexcept {
+            auto self = static_cast<channel_recv_awaitable*>(w->owner);
+            UNLIKELY_IF (w->closed) {
+                self->resume(async_result_type(error_tag, closed_error<error_type>::make()));
+            } else {
+                self->recv_and_resume();
+            }
+            self->release();
+        }
+
+        int submit() noexcept {
+            UNLIKELY_IF (upstream_failed) {
+                this->resume(async_result_type(error_tag, std::move(upstream_error)));
+                return 0;
+            }
+
+            // reference held by the channel while parked
+            this->retain();
+            switch (ch->items().acquire_or_park(&waiter)) {
+                case async_semaphore::acquire_status::acquired:
+                    this->release();
+                    recv_and_resume();
+                    break;
+                case async_semaphore::acquire_status::closed:
+                    this->release();
+                    this->resume(async_result_type(error_tag, closed_error<error_type>::make()));
+                    break;
+                default:
+                    break;
+            }
+            return 0;
+        }
+
+        // see channel_send_awaitable::cancel().
+        void cancel() noexcept {
+            LIKELY_IF (ch->items().cancel_park(&waiter)) {
+                this->release();
+            }
+        }
+    };
+}
+
+namespace flow_impl {
+    template <typename Executor, typename Channel, bool Send>
+    struct channel_node {
+        static_assert(check_executor<Executor>::value,
+            "Executor must be pointer-like and support "
+            "noexcept exec->dispatch(task_wrapper_sbo).");
+
+        Executor e;
+        Channel* ch;
+    };
+
+    template <typename I, typename O, typename... Nodes, typename Executor, typename Channel>
+    auto operator|(flow_blueprint<I, O, Nodes...>&& bp, channel_node<Executor, Channel, true>&& a) {
+        static_assert(std::is_constructible<typename Channel::value_type, typename O::value_type&&>::value,
+            "the current output can not be converted into the channel's value_type");
+
+        using awaitable_t = detail::channel_send_awaitable<Channel, O>;
+        using F_O = typename awaitable_t::async_result_type;
+        using wrapper_t = dispatch_wrapper_t<Executor>;
+        using factory_t = bound_awaitable_factory<awaitable_t, Channel>;
+
+        return std::move(bp) | flow_async_node<O, F_O, wrapper_t, identity, factory_t> {
+            wrapper_t{std::move(a.e)}, identity{}, factory_t{a.ch}
+        };
+    }
+
+    template <typename I, typename O, typename... Nodes, typename Executor, typename Channel>
+    auto operator|(flow_blueprint<I, O, Nodes...>&& bp, channel_node<Executor, Channel, false>&& a) {
+        using awaitable_t = detail::channel_recv_awaitable<Channel, O>;
+        using F_O = typename awaitable_t::async_result_type;
+        using wrapper_t = dispatch_wrapper_t<Executor>;
+        using factory_t = bound_awaitable_factory<awaitable_t, Channel>;
+
+        return std::move(bp) | flow_async_node<O, F_O, wrapper_t, identity, factory_t> {
+            wrapper_t{std::move(a.e)}, identity{}, factory_t{a.ch}
+        };
+    }
+}
+
+    // Moves the current output into ch, parking while the channel is full.
+    // Outputs result_t<void, E>; fails with closed_error<E> once ch is closed.
+    template <typename T, size_t capacity, typename Executor,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto await_send(async_channel<T, capacity>& ch, Executor&& executor_to_resume) noexcept {
+        using E = std::decay_t<Executor>;
+        return flow_impl::channel_node<E, async_channel<T, capacity>, true> { std::forward<Executor>(executor_to_resume), &ch };
+    }
+
+    template <typename T, size_t capacity>
+    auto await_send(async_channel<T, capacity>& ch) noexcept {
+        using E = flow_impl::inline_executor*;
+        return flow_impl::channel_node<E, async_channel<T, capacity>, true> { flow_impl::inline_executor::executor(), &ch };
+    }
+
+    // Replaces the current output with the next value of ch, parking while the channel is empty.
+    // The upstream value is only a trigger; fails with closed_error<E> once ch is closed and drained.
+    template <typename T, size_t capacity, typename Executor,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto await_recv(async_channel<T, capacity>& ch, Executor&& executor_to_resume) noexcept {
+        using E = std::decay_t<Executor>;
+        return flow_impl::channel_node<E, async_channel<T, capacity>, false> { std::forward<Executor>(executor_to_resume), &ch };
+    }
+
+    template <typename T, size_t capacity>
+    auto await_recv(async_channel<T, capacity>& ch) noexcept {
+        using E = flow_impl::inline_executor*;
+        return flow_impl::channel_node<E, async_channel<T, capacity>, false> { flow_impl::inline_executor::executor(), &ch };
+    }
+}
+
+#endif // FLUX_FOUNDRY_FLOW_CHANNEL_H
@@ -5,20 +5,53 @@
 #include <cstdint>
 #include <cstdio>
 #include <stdexcept>
+#include <type_traits>
+
+#include "../base/traits.h"
 
 namespace flux_foundry {
 namespace flow_impl {
-#if defined(__clang__)
-    static constexpr size_t MAX_ZIP_N = 2;
-#elif defined(__GNUC__)
-    static constexpr size_t MAX_ZIP_N = 2;
-#elif defined(_MSC_VER)
-    static constexpr size_t MAX_ZIP_N = 8;
-#else
-    static constexpr size_t MAX_ZIP_N = 2;
-#endif
+    static constexpr size_t MAX_ZIP_N = FLUX_FOUNDRY_MAX_ZIP_N;
+    static_assert(MAX_ZIP_N >= 2, "FLUX_FOUNDRY_MAX_ZIP_N must allow at least two fused calc steps");
 }
 
+// borrowed<T>: view of caller-owned input, see make_borrowing_blueprint().
+// the referenced object must outlive the synchronous part of the run: until the receiver fires,
+// or until the flow reaches its first via/async step. the blueprint refuses to carry a borrowed value
+// across such a step, so a calc step has to turn it into an owned value before that.
+template <typename T>
+class borrowed {
+    const T* p_;
+
+public:
+    using element_type = T;
+
+    borrowed(const T& v) noexcept
+        : p_(&v) {
+    }
+
+    // a temporary would be gone before the first node runs.
+    borrowed(const T&&) = delete;
+
+    const T& get() const noexcept {
+        return *p_;
+    }
+
+    operator const T&() const noexcept {
+        return *p_;
+    }
+
+    const T* operator->() const noexcept {
+        return p_;
+    }
+};
+
+template <typename T>
+struct is_borrowed : std::false_type { };
+
+template <typename T>
+struct is_borrowed<borrowed<T>> : std::true_type { };
+
 enum class cancel_kind {
     soft,
     hard,
@@ -144,6 +177,29 @@ struct async_any_failed_error {
     };
 #endif
 
+template <typename E>
+struct closed_error {
+    static E make() {
+        static_assert(sizeof(E) == 0,
+            "flux_foundry::closed_error<E> is not specialized for this error type E. "
+            "Please provide `template<> struct flux_foundry::closed_error<E>` "
+            "with a static `E make()` member.");
+    }
+};
+
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+template <>
+struct closed_error<std::exception_ptr> {
+    static std::exception_ptr make() noexcept {
+        try {
+            return std::make_exception_ptr(std::logic_error("async primitive is closed (end of stream)"));
+        } catch (...) {
+            return std::current_exception();
+        }
+    }
+};
+#endif
+
 namespace detail {
     using flow_async_cancel_handler_t = void (*)(void*, cancel_kind);
     using flow_async_notify_handler_dropped_t = void(*)(void*);
@@ -0,0 +1,440 @@
+#ifndef FLUX_FOUNDRY_FLOW_MUTEX_H
+#define FLUX_FOUNDRY_FLOW_MUTEX_H
+
+#include <atomic>
+#include "../memory/padded_t.h"
+#include "flow_wait_list.h"
+#include "flow_semaphore.h"
+
+namespace flux_foundry {
+    // async_mutex: exclusive lock whose owner may cross async boundaries.
+    // it is a single-permit async_semaphore, so an uncontended lock/unlock is one CAS each.
+    class async_mutex {
+        async_semaphore sem_;
+
+    public:
+        async_mutex() noexcept : sem_(1) {
+        }
+
+        async_mutex(const async_mutex&) = delete;
+        async_mutex& operator=(const async_mutex&) = delete;
+
+        bool try_lock() noexcept {
+            return sem_.try_acquire();
+        }
+
+        void unlock() noexcept {
+            sem_.release();
+        }
+
+        // returns true if the lock is taken immediately, otherwise w is parked.
+        bool lock_or_park(detail::flow_waiter* w, bool /* shared */) noexcept {
+            return sem_.acquire_or_park(w) == async_semaphore::acquire_status::acquired;
+        }
+
+        bool cancel_park(detail::flow_waiter* w) noexcept {
+            return sem_.cancel_park(w);
+        }
+    };
+
+    // async_shared_mutex: reader/writer lock with FIFO hand-off.
+    //
+    // | 63 ... 2 | 1 | 0 |
+    // | -------- | -- | -- |
+    // | readers  | writer? | has parked waiters? |
+    //
+    // - lock()/lock_shared()/unlock()/unlock_shared() are a single CAS while nobody is parked.
+    // - once somebody is parked, new lockers queue behind it (no writer starvation),
+    //   and the unlocking side grants the head of the queue: one writer, or every consecutive reader.
+    class async_shared_mutex {
+        static constexpr size_t waiters_flag = size_t(1) << 0;
+        static constexpr size_t writer_flag = size_t(1) << 1;
+        static constexpr size_t reader_unit = size_t(1) << 2;
+
+        padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> state_;
+        detail::flow_wait_list waiters_;
+
+        // must hold the list lock. the returned chain is linked through `next`.
+        detail::flow_waiter* grant_locked() noexcept {
+            auto& state = state_.get();
+            auto s = state.load(std::memory_order_relaxed);
+            // nobody is parked, fast paths may be racing on the state word.
+            UNLIKELY_IF (!(s & waiters_flag)) {
+                return nullptr;
+            }
+
+            detail::flow_waiter* head = nullptr;
+            detail::flow_waiter* tail = nullptr;
+            for (auto w = waiters_.front(); w; w = waiters_.front()) {
+                if (w->shared) {
+                    if (s & writer_flag) {
+                        break;
+                    }
+                    s += reader_unit;
+                } else {
+                    if ((s & writer_flag) || s >= reader_unit) {
+                        break;
+                    }
+                    s |= writer_flag;
+                }
+
+                waiters_.pop_front();
+                if (tail) {
+                    tail->next = w;
+                } else {
+                    head = w;
+                }
+                tail = w;
+
+                if (!w->shared) {
+                    break;
+                }
+            }
+
+            if (waiters_.empty()) {
+                s &= ~waiters_flag;
+            }
+            state.store(s, std::memory_order_release);
+            return head;
+        }
+
+        static void wake_chain(detail::flow_waiter* w) noexcept {
+            while (w) {
+                auto next = w->next;
+                w->next = nullptr;
+                w->wake(w);
+                w = next;
+            }
+        }
+
+    public:
+        async_shared_mutex() noexcept : state_(0) {
+        }
+
+        async_shared_mutex(const async_shared_mutex&) = delete;
+        async_shared_mutex& operator=(const async_shared_mutex&) = delete;
+
+        bool try_lock() noexcept {
+            size_t exp = 0;
+            return state_.get().compare_exchange_strong(exp, writer_flag,
+                std::memory_order_acquire, std::memory_order_relaxed);
+        }
+
+        bool try_lock_shared() noexcept {
+            auto& state = state_.get();
+            auto exp = state.load(std::memory_order_relaxed);
+            while (!(exp & (waiters_flag | writer_flag))) {
+                if (state.compare_exchange_weak(exp, exp + reader_unit,
+                    std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void unlock() noexcept {
+            auto& state = state_.get();
+            size_t exp = writer_flag;
+            LIKELY_IF (state.compare_exchange_strong(exp, 0,
+                std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+
+            detail::flow_waiter* chain;
+            {
+                detail::flow_wait_list_guard g(waiters_);
+                state.fetch_and(~writer_flag, std::memory_order_release);
+                chain = grant_locked();
+            }
+            wake_chain(chain);
+        }
+
+        void unlock_shared() noexcept {
+            auto& state = state_.get();
+            auto exp = state.load(std::memory_order_relaxed);
+            while (!(exp & waiters_flag)) {
+                if (state.compare_exchange_weak(exp, exp - reader_unit,
+                    std::memory_order_release, std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+
+            detail::flow_waiter* chain;
+            {
+                detail::flow_wait_list_guard g(waiters_);
+                state.fetch_sub(reader_unit, std::memory_order_release);
+                chain = grant_locked();
+            }
+            wake_chain(chain);
+        }
+
+        // returns true if the lock is taken immediately, otherwise w is parked.
+        bool lock_or_park(detail::flow_waiter* w, bool shared) noexcept {
+            LIKELY_IF (shared ? try_lock_shared() : try_lock()) {
+                return true;
+            }
+
+            auto& state = state_.get();
+            detail::flow_wait_list_guard g(waiters_);
+            auto exp = state.load(std::memory_order_relaxed);
+            while (!(exp & waiters_flag)) {
+                const bool compatible = shared ? !(exp & writer_flag) : exp == 0;
+                if (compatible) {
+                    if (state.compare_exchange_weak(exp, shared ? exp + reader_unit : writer_flag,
+                        std::memory_order_acquire, std::memory_order_relaxed)) {
+                        return true;
+                    }
+                    continue;
+                }
+
+                if (state.compare_exchange_weak(exp, exp | waiters_flag,
+                    std::memory_order_relaxed, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+
+            w->shared = shared;
+            waiters_.push_back(w);
+            return false;
+        }
+
+        // returns true if w was still parked and has been unlinked.
+        bool cancel_park(detail::flow_waiter* w) noexcept {
+            detail::flow_waiter* chain;
+            {
+                detail::flow_wait_list_guard g(waiters_);
+                UNLIKELY_IF (!waiters_.erase(w)) {
+                    return false;
+                }
+                // w may have been the writer blocking the readers behind it.
+                chain = grant_locked();
+            }
+            wake_chain(chain);
+            return true;
+        }
+    };
+
+    // RAII ownership of an async_mutex/async_shared_mutex, movable across flow steps.
+    template <typename Mutex, bool Shared>
+    class basic_async_lock {
+        Mutex* m_;
+
+    public:
+        basic_async_lock() noexcept : m_(nullptr) {
+        }
+
+        // adopts a lock that is already held.
+        explicit basic_async_lock(Mutex* m) noexcept : m_(m) {
+        }
+
+        basic_async_lock(const basic_async_lock&) = delete;
+        basic_async_lock& operator=(const basic_async_lock&) = delete;
+
+        basic_async_lock(basic_async_lock&& rhs) noexcept : m_(rhs.m_) {
+            rhs.m_ = nullptr;
+        }
+
+        basic_async_lock& operator=(basic_async_lock&& rhs) noexcept {
+            if (this != &rhs) {
+                unlock();
+                m_ = rhs.m_;
+                rhs.m_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~basic_async_lock() noexcept {
+            unlock();
+        }
+
+        // the next waiter may be resumed inline, detach first.
+        void unlock() noexcept {
+            if (m_) {
+                auto m = m_;
+                m_ = nullptr;
+                do_unlock(m, std::integral_constant<bool, Shared>{});
+            }
+        }
+
+        bool owns_lock() const noexcept {
+            return m_ != nullptr;
+        }
+
+        explicit operator bool() const noexcept {
+            return owns_lock();
+        }
+
+        Mutex* mutex() const noexcept {
+            return m_;
+        }
+
+    private:
+        static void do_unlock(Mutex* m, std::false_type) noexcept {
+            m->unlock();
+        }
+
+        static void do_unlock(Mutex* m, std::true_type) noexcept {
+            m->unlock_shared();
+        }
+    };
+
+    template <typename Mutex>
+    using async_unique_lock = basic_async_lock<Mutex, false>;
+
+    template <typename Mutex>
+    using async_shared_lock = basic_async_lock<Mutex, true>;
+
+    // output of await_lock/await_lock_shared: the lock travels together with the upstream value.
+    template <typename Lock, typename T>
+    struct locked_value {
+        Lock lock;
+        T value;
+
+        T& get() & noexcept {
+            return value;
+        }
+
+        T&& get() && noexcept {
+            return std::move(value);
+        }
+    };
+
+    template <typename Lock>
+    struct locked_value<Lock, void> {
+        Lock lock;
+    };
+
+namespace detail {
+    template <typename Mutex, bool Shared, typename R>
+    struct mutex_lock_awaitable final
+        : awaitable_base<mutex_lock_awaitable<Mutex, Shared, R>,
+            locked_value<basic_async_lock<Mutex, Shared>, typename R::value_type>, typename R::error_type> {
+        using error_type = typename R::error_type;
+        using lock_type = basic_async_lock<Mutex, Shared>;
+        using value_type = locked_value<lock_type, typename R::value_type>;
+        using async_result_type = result_t<value_type, error_type>;
+
+        Mutex* m;
+        flow_waiter waiter;
+        R in;
+
+        mutex_lock_awaitable(Mutex* m_, R&& in_)
+            noexcept(std::is_nothrow_move_constructible<R>::value)
+            : m(m_), in(std::move(in_)) {
+            waiter.wake = on_wake;
+            waiter.owner = this;
+        }
+
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+        bool available() const noexcept {
+            return true;
+        }
+#endif
+
+        template <typename R_ = R, std::enable_if_t<!std::is_void<typename R_::value_type>::value>* = nullptr>
+        async_result_type make_locked() noexcept {
+            return async_result_type(value_tag, value_type{lock_type(m), std::move(in).value()});
+        }
+
+        template <typename R_ = R, std::enable_if_t<std::is_void<typename R_::value_type>::value>* = nullptr>
+        async_result_type make_locked() noexcept {
+            return async_result_type(value_tag, value_type{lock_type(m)});
+        }
+
+        static void on_wake(flow_waiter* w) noexcept {
+            auto self = static_cast<mutex_lock_awaitable*>(w->owner);
+            // if cancel() won the race, resume() drops the result and the lock inside unlocks.
+            self->resume(self->make_locked());
+            self->release();
+        }
+
+        int submit() noexcept {
+            UNLIKELY_IF (!in.has_value()) {
+                this->resume(async_result_type(error_tag, std::move(in).error()));
+                return 0;
+            }
+
+            // reference held by the mutex while parked
+            this->retain();
+            LIKELY_IF (m->lock_or_park(&waiter, Shared)) {
+                this->release();
+                this->resume(make_locked());
+            }
+            return 0;
+        }
+
+        void cancel() noexcept {
+            LIKELY_IF (m->cancel_park(&waiter)) {
+                this->release();
+            }
+        }
+    };
+}
+
+namespace flow_impl {
+    template <typename Executor, typename Mutex, bool Shared>
+    struct lock_node {
+        static_assert(check_executor<Executor>::value,
+            "Executor must be pointer-like and support "
+            "noexcept exec->dispatch(task_wrapper_sbo).");
+
+        Executor e;
+        Mutex* m;
+    };
+
+    template <typename I, typename O, typename... Nodes, typename Executor, typename Mutex, bool Shared>
+    auto operator|(flow_blueprint<I, O, Nodes...>&& bp, lock_node<Executor, Mutex, Shared>&& a) {
+        using awaitable_t = detail::mutex_lock_awaitable<Mutex, Shared, O>;
+        using F_O = typename awaitable_t::async_result_type;
+        using wrapper_t = dispatch_wrapper_t<Executor>;
+        using factory_t = bound_awaitable_factory<awaitable_t, Mutex>;
+
+        return std::move(bp) | flow_async_node<O, F_O, wrapper_t, identity, factory_t> {
+            wrapper_t{std::move(a.e)}, identity{}, factory_t{a.m}
+        };
+    }
+}
+
+    // Suspends the flow until m is locked exclusively, then outputs
+    // locked_value<async_unique_lock<Mutex>, T>. The lock is released when that payload is destroyed
+    // (or by calling .lock.unlock()), so it may be carried across later async steps.
+    // A canceled waiter is unlinked from the queue and never takes the lock.
+    template <typename Executor,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto await_lock(async_mutex& m, Executor&& executor_to_resume) noexcept {
+        using E = std::decay_t<Executor>;
+        return flow_impl::lock_node<E, async_mutex, false> { std::forward<Executor>(executor_to_resume), &m };
+    }
+
+    inline auto await_lock(async_mutex& m) noexcept {
+        using E = flow_impl::inline_executor*;
+        return flow_impl::lock_node<E, async_mutex, false> { flow_impl::inline_executor::executor(), &m };
+    }
+
+    template <typename Executor,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto await_lock(async_shared_mutex& m, Executor&& executor_to_resume) noexcept {
+        using E = std::decay_t<Executor>;
+        return flow_impl::lock_node<E, async_shared_mutex, false> { std::forward<Executor>(executor_to_resume), &m };
+    }
+
+    inline auto await_lock(async_shared_mutex& m) noexcept {
+        using E = flow_impl::inline_executor*;
+        return flow_impl::lock_node<E, async_shared_mutex, false> { flow_impl::inline_executor::executor(), &m };
+    }
+
+    // Same as await_lock but takes m in shared mode, outputs locked_value<async_shared_lock<...>, T>.
+    template <typename Executor,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto await_lock_shared(async_shared_mutex& m, Executor&& executor_to_resume) noexcept {
+        using E = std::decay_t<Executor>;
+        return flow_impl::lock_node<E, async_shared_mutex, true> { std::forward<Executor>(executor_to_resume), &m };
+    }
+
+    inline auto await_lock_shared(async_shared_mutex& m) noexcept {
+        using E = flow_impl::inline_executor*;
+        return flow_impl::lock_node<E, async_shared_mutex, true> { flow_impl::inline_executor::executor(), &m };
+    }
+}
+
+#endif // FLUX_FOUNDRY_FLOW_MUTEX_H
@@ -8,12 +8,50 @@
 
 namespace flux_foundry {
     namespace flow_impl {
+        // continuation coalescing: an executor opts in with
+        //     bool running_in_this_thread() const noexcept;
+        // a via() hop or an async resume targeting it from one of its own threads then runs inline
+        // instead of taking a queue round-trip, up to `budget` nested hops (see inline_hop_budget_of).
+        template <typename Executor, typename = void>
+        struct inline_hop_traits {
+            static constexpr size_t budget = 0;
+        };
+
+        template <typename Executor>
+        struct inline_hop_traits<Executor, std::enable_if_t<
+            noexcept(std::declval<const Executor&>()->running_in_this_thread())>> {
+            static constexpr size_t budget =
+                inline_hop_budget_of<std::decay_t<decltype(*std::declval<const Executor&>())>>::value;
+        };
+
         template <typename Executor>
         struct dispatch_wrapper_t {
             using executor_t = Executor;
+            using task_type = typename dispatcher_task<std::decay_t<decltype(*std::declval<Executor&>())>>::type;
             Executor exec;
-            void operator()(task_wrapper_sbo&& sbo) noexcept {
-                exec->dispatch(std::move(sbo));
+
+            template <typename task_t>
+            void operator()(task_t&& sbo) noexcept {
+                dispatch(std::forward<task_t>(sbo), std::integral_constant<bool, inline_hop_traits<Executor>::budget != 0>{});
+            }
+
+        private:
+            template <typename task_t>
+            void dispatch(task_t&& sbo, std::false_type /* coalescing? */) noexcept {
+                exec->dispatch(std::forward<task_t>(sbo));
+            }
+
+            template <typename task_t>
+            void dispatch(task_t&& sbo, std::true_type /* coalescing? */) noexcept {
+                auto& depth = inline_hop_depth();
+                if (depth >= inline_hop_traits<Executor>::budget || !exec->running_in_this_thread()) {
+                    exec->dispatch(std::forward<task_t>(sbo));
+                    return;
+                }
+
+                ++depth;
+                sbo();
+                --depth;
             }
         };
 
@@ -427,6 +465,29 @@ namespace flux_foundry {
             return std::move(bp) | async_node<Executor, Awaitable>::template make<O, F_O>(std::move(a));
         }
 
+        // sticky async
+        template <typename Awaitable>
+        struct sticky_async_node {
+            static_assert(is_awaitable_v<Awaitable> || is_fast_awaitable_v<Awaitable>,
+                "Awaitable must be an valid awaitable(see flux_foundry::awaitable_base)\n"
+                "or a valid fast_awaitable(see flux_foundry::fast_awaitable_base)");
+        };
+
+        template <typename I, typename O, typename... Nodes, typename Awaitable>
+        auto operator|(flow_blueprint<I, O, Nodes...>&& bp, sticky_async_node<Awaitable>&&) {
+            using F_O = typename Awaitable::async_result_type;
+
+            static_assert(is_result_t_v<F_O>,
+                "Awaitable must provide a result_t<T, E> as it's async result");
+
+            static_assert(std::is_constructible<Awaitable, O&&>::value,
+                "awaitable must could be constructible with the current output.");
+
+            return std::move(bp) | flow_async_node<O, F_O, sticky_dispatcher_t, identity, awaitable_factory<Awaitable>> {
+                sticky_dispatcher_t{}, identity{}, awaitable_factory<Awaitable>{}
+            };
+        }
+
         // when_all_node
         template <typename Executor, typename F, typename G, bool Fast, typename ... BPs>
         struct when_all_node {
@@ -562,7 +623,7 @@ namespace flux_foundry {
             template <typename F_I>
             static auto make(end_node&&) noexcept {
                 auto wrapper = [](F_I&& in) noexcept {
-                    return in;
+                    return std::move(in);
                 };
                 return flow_end_node<F_I, F_I, decltype(wrapper)>(std::move(wrapper));
             }
@@ -611,6 +672,15 @@ namespace flux_foundry {
         );
     }
 
+    // a blueprint whose input is a borrowed<T> view into caller-owned memory.
+    // `runner(obj)` then starts the run without copying obj, and the first calc steps read it in place
+    // (a step may take `const T&`). the view is valid until the receiver fires or the first via/async step,
+    // which the blueprint only accepts once the value has been turned into an owned one.
+    template <typename T, typename E = std::exception_ptr>
+    auto make_borrowing_blueprint() noexcept {
+        return make_blueprint<borrowed<T>, E>();
+    }
+
     template <typename F>
     auto transform(F&& f) noexcept {
         return flow_impl::transform_node<std::decay_t<F>> { std::forward<F>(f) };
@@ -658,6 +728,15 @@ namespace flux_foundry {
         return flow_impl::async_node<E, Awaitable> { std::forward<Executor>(executor_to_resume) };
     }
 
+    // CRITICAL: Max payload size is controlled by the SBO buffer (e.g., 64 bytes).
+    // Ensure that the async result(result_t) does not exceed the remaining buffer space.(OR it will trigger heap alloc)
+    // resume on the executor that ran the step submitting the awaitable (see executor_ref::current()),
+    // keeping the flow's state in that core's caches; inline when it was not submitted from an executor.
+    template <typename Awaitable>
+    auto await_sticky() noexcept {
+        return flow_impl::sticky_async_node<Awaitable>{};
+    }
+
     template <typename Executor, typename F, typename G, typename ... BPs,
         std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
     auto await_when_all(Executor&& executor_to_resume, F&& on_success, G&& on_error, lite_ptr<BPs> ... bps) noexcept {
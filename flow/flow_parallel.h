@@ -0,0 +1,280 @@
+#ifndef FLUX_FOUNDRY_FLOW_PARALLEL_H
+#define FLUX_FOUNDRY_FLOW_PARALLEL_H
+
+#include <thread>
+
+#include "../task/parallel_for.h"
+#include "flow_awaitable.h"
+#include "flow_blocking.h"
+#include "flow_node.h"
+
+namespace flux_foundry {
+namespace detail {
+    template <typename F, typename A, typename = void>
+    struct is_nothrow_loop_body : std::false_type {};
+
+    template <typename F, typename A>
+    struct is_nothrow_loop_body<F, A, void_t<decltype(std::declval<F&>()(std::declval<A>(), std::declval<size_t>()))>>
+        : std::integral_constant<bool, noexcept(std::declval<F&>()(std::declval<A>(), std::declval<size_t>()))> {};
+
+    template <typename Count, typename F>
+    struct parallel_for_spec {
+        Count count;
+        F f;
+        size_t concurrency;
+    };
+
+    template <typename Count, typename R, typename Map, typename Combine>
+    struct parallel_reduce_spec {
+        Count count;
+        R identity;
+        Map map;
+        Combine combine;
+        size_t concurrency;
+    };
+
+    // every worker of the loop runs as a task on the pool, none on the flow's executor.
+    template <typename Body, typename Local, typename Pool, typename Self>
+    bool start_parallel_loop(Pool& pool, size_t n, size_t concurrency, const Local& init, Self* self) noexcept {
+        using state_t = parallel_detail::loop_state<Body, Local>;
+        concurrency = concurrency ? concurrency : 1;
+        const size_t grain = parallel_detail::auto_grain(n, concurrency);
+        auto s = state_t::create(0, n, grain, parallel_detail::loop_workers(n, grain, concurrency), init, Body{self});
+        UNLIKELY_IF (!s) {
+            return false;
+        }
+        s->spawn(pool, 0);
+        s->release();
+        return true;
+    }
+
+    // calls f(in, i) for i in [0, count(in)) on the pool, then resumes the flow with `in`
+    // from the worker that finished the last chunk. an error input skips the loop.
+    template <typename Count, typename F, typename Pool, typename T, typename E>
+    struct parallel_for_awaitable final : fast_awaitable_base<parallel_for_awaitable<Count, F, Pool, T, E>, T, E> {
+        using async_result_type = result_t<T, E>;
+        using spec_t = parallel_for_spec<Count, F>;
+
+        struct body_t {
+            parallel_for_awaitable* self;
+
+            void run(size_t begin, size_t end, parallel_detail::no_local&) noexcept {
+                T& v = self->in.value();
+                for (size_t i = begin; i < end; ++i) {
+                    self->spec.f(v, i);
+                }
+            }
+
+            template <typename State>
+            void finish(State&) noexcept {
+                self->resume(std::move(self->in));
+            }
+        };
+
+        Pool pool;
+        spec_t spec;
+        result_t<T, E> in;
+
+        parallel_for_awaitable(Pool pool_, const spec_t& spec_, result_t<T, E>&& in_)
+            noexcept(conjunction_v<std::is_nothrow_copy_constructible<spec_t>, std::is_nothrow_move_constructible<result_t<T, E>>>)
+            : pool(std::move(pool_)), spec(spec_), in(std::move(in_)) {
+        }
+
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+        bool available() noexcept {
+            return true;
+        }
+#endif
+
+        int submit() noexcept {
+            UNLIKELY_IF (in.has_error()) {
+                this->resume(async_result_type(error_tag, std::move(in).error()));
+                return 0;
+            }
+
+            const size_t n = spec.count(static_cast<const T&>(in.value()));
+            UNLIKELY_IF (n == 0) {
+                this->resume(std::move(in));
+                return 0;
+            }
+
+            UNLIKELY_IF (!start_parallel_loop<body_t>(pool, n, spec.concurrency, parallel_detail::no_local{}, this)) {
+                this->resume(async_result_type(error_tag, awaitable_creating_error<E>::make()));
+            }
+            return 0;
+        }
+    };
+
+    // folds map(in, i) for i in [0, count(in)) with combine on the pool, then resumes the flow with the
+    // result. the worker that finished the last chunk folds the per-worker partials in worker order.
+    template <typename Count, typename R, typename Map, typename Combine, typename Pool, typename T, typename E>
+    struct parallel_reduce_awaitable final : fast_awaitable_base<
+        parallel_reduce_awaitable<Count, R, Map, Combine, Pool, T, E>, R, E> {
+        using async_result_type = result_t<R, E>;
+        using spec_t = parallel_reduce_spec<Count, R, Map, Combine>;
+
+        struct body_t {
+            parallel_reduce_awaitable* self;
+
+            void run(size_t begin, size_t end, R& local) noexcept {
+                const T& v = self->in.value();
+                for (size_t i = begin; i < end; ++i) {
+                    local = self->spec.combine(std::move(local), self->spec.map(v, i));
+                }
+            }
+
+            template <typename State>
+            void finish(State& s) noexcept {
+                R acc(self->spec.identity);
+                for (size_t w = 0; w < s.workers(); ++w) {
+                    acc = self->spec.combine(std::move(acc), std::move(s.local(w)));
+                }
+                self->resume(async_result_type(value_tag, std::move(acc)));
+            }
+        };
+
+        Pool pool;
+        spec_t spec;
+        result_t<T, E> in;
+
+        parallel_reduce_awaitable(Pool pool_, const spec_t& spec_, result_t<T, E>&& in_)
+            noexcept(conjunction_v<std::is_nothrow_copy_constructible<spec_t>, std::is_nothrow_move_constructible<result_t<T, E>>>)
+            : pool(std::move(pool_)), spec(spec_), in(std::move(in_)) {
+        }
+
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+        bool available() noexcept {
+            return true;
+        }
+#endif
+
+        int submit() noexcept {
+            UNLIKELY_IF (in.has_error()) {
+                this->resume(async_result_type(error_tag, std::move(in).error()));
+                return 0;
+            }
+
+            const size_t n = spec.count(static_cast<const T&>(in.value()));
+            UNLIKELY_IF (n == 0) {
+                this->resume(async_result_type(value_tag, spec.identity));
+                return 0;
+            }
+
+            UNLIKELY_IF (!start_parallel_loop<body_t>(pool, n, spec.concurrency, spec.identity, this)) {
+                this->resume(async_result_type(error_tag, awaitable_creating_error<E>::make()));
+            }
+            return 0;
+        }
+    };
+}
+
+namespace flow_impl {
+    template <typename Executor, typename Spec, typename Pool>
+    struct parallel_node {
+        static_assert(check_executor<Executor>::value,
+            "Executor must be pointer-like and support "
+            "noexcept exec->dispatch(task_wrapper_sbo).");
+        static_assert(check_executor<Pool>::value,
+            "Pool must be pointer-like and support "
+            "noexcept pool->dispatch(task_wrapper_sbo).");
+
+        Executor e;
+        Spec spec;
+        Pool pool;
+    };
+
+    template <typename I, typename O, typename... Nodes, typename Executor, typename Count, typename F, typename Pool>
+    auto operator|(flow_blueprint<I, O, Nodes...>&& bp,
+        parallel_node<Executor, detail::parallel_for_spec<Count, F>, Pool>&& a) {
+        using T = typename O::value_type;
+        using E = typename O::error_type;
+        static_assert(!std::is_void<T>::value, "await_parallel_for needs a value to loop over.");
+        static_assert(is_nothrow_invocable_with<Count&, const T&>::value,
+            "count must be nothrow-invocable with the current value.");
+        static_assert(detail::is_nothrow_loop_body<F, T&>::value,
+            "f must be nothrow-invocable as f(T&, size_t).");
+
+        using spec_t = detail::parallel_for_spec<Count, F>;
+        using awaitable_t = detail::parallel_for_awaitable<Count, F, Pool, T, E>;
+        using F_O = typename awaitable_t::async_result_type;
+        using wrapper_t = dispatch_wrapper_t<Executor>;
+        using factory_t = detail::blocking_awaitable_factory<awaitable_t, spec_t, Pool>;
+
+        return std::move(bp) | flow_async_node<O, F_O, wrapper_t, identity, factory_t> {
+            wrapper_t{std::move(a.e)}, identity{}, factory_t{std::move(a.spec), std::move(a.pool)}
+        };
+    }
+
+    template <typename I, typename O, typename... Nodes, typename Executor,
+        typename Count, typename R, typename Map, typename Combine, typename Pool>
+    auto operator|(flow_blueprint<I, O, Nodes...>&& bp,
+        parallel_node<Executor, detail::parallel_reduce_spec<Count, R, Map, Combine>, Pool>&& a) {
+        using T = typename O::value_type;
+        using E = typename O::error_type;
+        static_assert(!std::is_void<T>::value, "await_parallel_reduce needs a value to loop over.");
+        static_assert(is_nothrow_invocable_with<Count&, const T&>::value,
+            "count must be nothrow-invocable with the current value.");
+        static_assert(detail::is_nothrow_loop_body<Map, const T&>::value,
+            "map must be nothrow-invocable as map(const T&, size_t).");
+        static_assert(noexcept(std::declval<Combine&>()(std::declval<R&&>(), std::declval<R&&>())),
+            "combine must be nothrow-invocable as combine(R&&, R&&).");
+
+        using spec_t = detail::parallel_reduce_spec<Count, R, Map, Combine>;
+        using awaitable_t = detail::parallel_reduce_awaitable<Count, R, Map, Combine, Pool, T, E>;
+        using F_O = typename awaitable_t::async_result_type;
+        using wrapper_t = dispatch_wrapper_t<Executor>;
+        using factory_t = detail::blocking_awaitable_factory<awaitable_t, spec_t, Pool>;
+
+        return std::move(bp) | flow_async_node<O, F_O, wrapper_t, identity, factory_t> {
+            wrapper_t{std::move(a.e)}, identity{}, factory_t{std::move(a.spec), std::move(a.pool)}
+        };
+    }
+}
+
+    // Runs f(value, i) for every i in [0, count(value)) as a parallel_for on `pool`, then resumes
+    // the flow with the value on `executor_to_resume`. The flow's own executor is not occupied while
+    // the loop runs. `count` and `f` are copied into every in-flight loop.
+    template <typename Pool, typename Count, typename F, typename Executor,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto await_parallel_for(Pool&& pool, Count&& count, F&& f, Executor&& executor_to_resume) noexcept {
+        using spec_t = detail::parallel_for_spec<std::decay_t<Count>, std::decay_t<F>>;
+        return flow_impl::parallel_node<std::decay_t<Executor>, spec_t, std::decay_t<Pool>> {
+            std::forward<Executor>(executor_to_resume),
+            spec_t{std::forward<Count>(count), std::forward<F>(f), std::thread::hardware_concurrency()},
+            std::forward<Pool>(pool)
+        };
+    }
+
+    // resumes on the pool thread that finished the last chunk.
+    template <typename Pool, typename Count, typename F>
+    auto await_parallel_for(Pool&& pool, Count&& count, F&& f) noexcept {
+        return await_parallel_for(std::forward<Pool>(pool), std::forward<Count>(count), std::forward<F>(f),
+            flow_impl::inline_executor::executor());
+    }
+
+    // Folds map(value, i) for every i in [0, count(value)) with combine, starting from identity, as a
+    // parallel_reduce on `pool`, and resumes the flow with the result on `executor_to_resume`.
+    // combine must be associative and commutative, see parallel_reduce.
+    template <typename Pool, typename Count, typename R, typename Map, typename Combine, typename Executor,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto await_parallel_reduce(Pool&& pool, Count&& count, R&& identity, Map&& map, Combine&& combine,
+        Executor&& executor_to_resume) noexcept {
+        using spec_t = detail::parallel_reduce_spec<std::decay_t<Count>, std::decay_t<R>,
+            std::decay_t<Map>, std::decay_t<Combine>>;
+        return flow_impl::parallel_node<std::decay_t<Executor>, spec_t, std::decay_t<Pool>> {
+            std::forward<Executor>(executor_to_resume),
+            spec_t{std::forward<Count>(count), std::forward<R>(identity), std::forward<Map>(map),
+                std::forward<Combine>(combine), std::thread::hardware_concurrency()},
+            std::forward<Pool>(pool)
+        };
+    }
+
+    // resumes on the pool thread that finished the last chunk.
+    template <typename Pool, typename Count, typename R, typename Map, typename Combine>
+    auto await_parallel_reduce(Pool&& pool, Count&& count, R&& identity, Map&& map, Combine&& combine) noexcept {
+        return await_parallel_reduce(std::forward<Pool>(pool), std::forward<Count>(count), std::forward<R>(identity),
+            std::forward<Map>(map), std::forward<Combine>(combine), flow_impl::inline_executor::executor());
+    }
+}
+
+#endif // FLUX_FOUNDRY_FLOW_PARALLEL_H
@@ -2,6 +2,7 @@
 #define FLUX_FOUNDRY_FLOW_RUNNER_H
 
 #include <atomic>
+#include <cassert>
 #include <type_traits>
 #include <utility>
 
@@ -66,6 +67,69 @@ namespace flux_foundry {
         detail::flow_async_notify_handler_dropped_t notify_handler_dropped { drop_sub };
         detail::flow_async_cancel_param_t cancel_param { nullptr };
 
+        // cancellation tree, see attach_child(). the sibling links of a child and the children_ head
+        // are guarded by the parent's tree_lock_, a test-and-test-and-set lock like flow_wait_list's.
+        // a lock-free intrusive list does not fit here: a child that finishes first has to unlink
+        // itself from the middle in O(1), and detach() must not race with a parent that is being
+        // torn down. the lock is only held for an O(1) link/unlink, and it is only contended by
+        // children of the same parent finishing at the same time, or by a concurrent cancel().
+        // together with the cancel handlers they share the cache line after state_.
+        std::atomic<bool> tree_lock_{ false };
+        std::atomic<flow_controller*> parent_{ nullptr };
+        flow_controller* children_ = nullptr;
+        flow_controller* prev_sibling_ = nullptr;
+        flow_controller* next_sibling_ = nullptr;
+
+        void lock_tree() noexcept {
+            for (backoff_strategy<> backoff;; backoff.yield()) {
+                if (!tree_lock_.load(std::memory_order_relaxed)
+                    && !tree_lock_.exchange(true, std::memory_order_acquire)) {
+                    return;
+                }
+            }
+        }
+
+        void unlock_tree() noexcept {
+            tree_lock_.store(false, std::memory_order_release);
+        }
+
+        // called with tree_lock_ held.
+        void unlink_child(flow_controller* child) noexcept {
+            if (child->prev_sibling_) {
+                child->prev_sibling_->next_sibling_ = child->next_sibling_;
+            } else {
+                children_ = child->next_sibling_;
+            }
+            if (child->next_sibling_) {
+                child->next_sibling_->prev_sibling_ = child->prev_sibling_;
+            }
+            child->prev_sibling_ = nullptr;
+            child->next_sibling_ = nullptr;
+            child->parent_.store(nullptr, std::memory_order_relaxed);
+        }
+
+        // the state is already canceled, so nothing is linked behind the children taken here.
+        // each child is unlinked before it is canceled, the lock is never held across a cancel().
+        // tree locks are only ever nested child before parent, see detach().
+        void cancel_children(bool force) noexcept {
+            for (;;) {
+                lock_tree();
+                auto child = children_;
+                if (child) {
+                    unlink_child(child);
+                }
+                unlock_tree();
+
+                if (!child) {
+                    return;
+                }
+                // waits out a detach() of the child that read this controller before the unlink.
+                child->lock_tree();
+                child->unlock_tree();
+                child->cancel(force);
+            }
+        }
+
         // never ever call this
         auto lock_and_set_cancel_handler(detail::flow_async_cancel_handler_t new_cancel_handler,
             detail::flow_async_notify_handler_dropped_t new_notify_handler_dropped,
@@ -141,6 +205,7 @@ namespace flux_foundry {
         // cancel() is thread-safe and may be called from external threads.
         // Internal handler/state transitions are coordinated with runner via lock bits + epoch.
         ~flow_controller() noexcept {
+            assert(!children_ && !parent_.load(std::memory_order_relaxed) && "a linked flow_controller is destroyed");
             reset_cancel_handler();
         }
 
@@ -159,11 +224,14 @@ namespace flux_foundry {
                 auto target = exp | kind;
                 if (state.compare_exchange_weak(exp, target, std::memory_order_acquire, std::memory_order_relaxed)) {
                     cancel_handler(cancel_param, force ? cancel_kind::hard : cancel_kind::soft);
+                    // the pending awaitable keeps what it linked below this controller alive until
+                    // it is told its handler is dropped, so the children are walked before that.
+                    cancel_children(force);
                     notify_handler_dropped(cancel_param);
                     this->notify_handler_dropped = drop_sub;
                     this->cancel_handler = cancel_stub;
                     this->cancel_param = nullptr;
-                    break;
+                    return;
                 }
 
                 if ((exp & runner_cancel::msk) == runner_cancel::soft 
@@ -173,6 +241,47 @@ namespace flux_foundry {
             }
         }
 
+        // links `child` below this controller, cancel() then reaches it with the same kind in the
+        // same walk. a child attached after this controller was canceled is canceled right away.
+        // the child calls detach() once it is done, before it is destroyed. a child taken by a
+        // running cancel() is already unlinked, its owner keeps it alive until that cancel() returns.
+        void attach_child(flow_controller* child) noexcept {
+            lock_tree();
+            UNLIKELY_IF (is_canceled()) {
+                unlock_tree();
+                child->cancel(is_force_canceled());
+                return;
+            }
+
+            child->next_sibling_ = children_;
+            if (children_) {
+                children_->prev_sibling_ = child;
+            }
+            children_ = child;
+            child->parent_.store(this, std::memory_order_relaxed);
+            unlock_tree();
+        }
+
+        // unlinks this controller from its parent, if it is still linked.
+        // the own tree_lock_ is held while the parent is touched: a parent that took this child in
+        // cancel_children() waits for it before it returns, so the parent can't go away under us.
+        void detach() noexcept {
+            LIKELY_IF (!parent_.load(std::memory_order_acquire)) {
+                return;
+            }
+
+            lock_tree();
+            auto parent = parent_.load(std::memory_order_acquire);
+            if (parent) {
+                parent->lock_tree();
+                if (parent_.load(std::memory_order_relaxed) == parent) {
+                    parent->unlink_child(this);
+                }
+                parent->unlock_tree();
+            }
+            unlock_tree();
+        }
+
         bool is_force_canceled() const noexcept {
             auto& state = state_.get();
             return (state.load(std::memory_order_acquire) & runner_cancel::msk) == runner_cancel::hard;
@@ -190,6 +299,10 @@ namespace flux_foundry {
         }
     };
 
+    static_assert(sizeof(flow_controller) <= 2 * CACHE_LINE_SIZE,
+        "flow_controller must fit in two cache lines: state_ padded to the first one, the cancel handlers "
+        "and the cancellation tree links in the second");
+
     // Concurrency contract:
     // - flow_runner object is NOT thread-safe.
     // - do not call operator() concurrently on the same runner instance.
@@ -377,13 +490,15 @@ namespace flux_foundry {
             template <typename dispatcher_t, typename param_t>
             static void dispatch_impl(dispatcher_t& dispatcher, flow_runner& self, param_t&& in,
                                       std::false_type /* inline executor? */) noexcept {
+                // runner state and the result are moved with a memcpy when they are all relocatable.
+                constexpr bool relocatable = all_trivially_relocatable<decltype(self.data), controller_ptr, param_t>::value;
                 dispatcher(
-                    task_wrapper_sbo([data = self.data,
+                    flow_impl::dispatcher_task_t<dispatcher_t>(relocatable_if<relocatable>([data = self.data,
                                       controller = std::move(self.controller),
                                       in = std::forward<param_t>(in)]() mutable noexcept {
                         flow_runner next_runner(std::move(data.first()), std::move(controller), std::move(data.second()));
                         ipc<I - 1>::run(next_runner, std::move(in));
-                    })
+                    }))
                 );
             }
 
@@ -406,36 +521,40 @@ namespace flux_foundry {
 
             // no cancel 
             template <typename resume_param_t, typename bp_ptr, typename dispatcher_t, typename adaptor_t, typename controller_t>
-            static callable_wrapper<void(resume_param_t&&)> make_async_next_step(const bp_ptr& data, const dispatcher_t& dispatcher, 
+            static awaitable_next_step_t<resume_param_t> make_async_next_step(const bp_ptr& data, const dispatcher_t& dispatcher, 
                 const adaptor_t& adaptor, controller_t&& controller, std::true_type) noexcept {
-                return [data = data, adaptor = adaptor,
+                constexpr bool next_relocatable = all_trivially_relocatable<bp_ptr, controller_t, adaptor_t>::value;
+                return relocatable_if<next_relocatable>([data = data, adaptor = adaptor,
                         controller = std::forward<controller_t>(controller)](resume_param_t&& in) mutable noexcept {
                     flow_runner next_runner(std::move(data.first()), std::move(controller), std::move(data.second()));
                     ipc<I - 1>::run(next_runner, adaptor(std::move(in)));
-                };
+                });
             }
 
             template <typename resume_param_t, typename bp_ptr, typename dispatcher_t, typename adaptor_t, typename controller_t>
-            static callable_wrapper<void(resume_param_t&&)> make_async_next_step(const bp_ptr& data, const dispatcher_t& dispatcher, 
+            static awaitable_next_step_t<resume_param_t> make_async_next_step(const bp_ptr& data, const dispatcher_t& dispatcher, 
                 const adaptor_t& adaptor, controller_t&& controller, std::false_type) noexcept {
-                return [data = data, dispatcher = dispatcher,
+                constexpr bool relocatable = all_trivially_relocatable<bp_ptr, controller_t, adaptor_t, resume_param_t>::value;
+                constexpr bool next_relocatable = all_trivially_relocatable<bp_ptr, controller_t, adaptor_t, decltype(flow_impl::bind_dispatcher(dispatcher))>::value;
+                return relocatable_if<next_relocatable>([data = data, dispatcher = flow_impl::bind_dispatcher(dispatcher),
                         adaptor = adaptor, controller = std::forward<controller_t>(controller)] (resume_param_t&& in) mutable noexcept {
-                    dispatcher(task_wrapper_sbo([data = std::move(data),
+                    dispatcher(flow_impl::dispatcher_task_t<dispatcher_t>(relocatable_if<relocatable>([data = std::move(data),
                                          controller = std::move(controller),
                                          adaptor = std::move(adaptor),
                                          in = std::move(in)]() mutable noexcept {
                             flow_runner next_runner(std::move(data.first()), std::move(controller), std::move(data.second()));
                             ipc<I - 1>::run(next_runner, adaptor(std::move(in)));
-                        })
+                        }))
                     );
-                };
+                });
             }
 
             // with cancel
             template <typename resume_param_t, typename bp_ptr, typename dispatcher_t, typename adaptor_t, typename controller_t>
-            static callable_wrapper<void(resume_param_t&&)> make_async_next_step(const bp_ptr& data, const dispatcher_t& dispatcher, 
+            static awaitable_next_step_t<resume_param_t> make_async_next_step(const bp_ptr& data, const dispatcher_t& dispatcher, 
                 const adaptor_t& adaptor, controller_t&& controller, size_t token, std::true_type) noexcept {
-                return [data = data, adaptor = adaptor, state = token,
+                constexpr bool next_relocatable = all_trivially_relocatable<bp_ptr, controller_t, adaptor_t>::value;
+                return relocatable_if<next_relocatable>([data = data, adaptor = adaptor, state = token,
                         controller = std::forward<controller_t>(controller)]
                         (resume_param_t&& in) mutable noexcept {
                     auto& cs = controller->state_.get();
@@ -454,16 +573,18 @@ namespace flux_foundry {
 
                     flow_runner next_runner(std::move(data.first()), std::move(controller), std::move(data.second()));
                     ipc<I - 1>::run(next_runner, adaptor(std::move(in)));
-                };
+                });
             }
 
             template <typename resume_param_t, typename bp_ptr, typename dispatcher_t, typename adaptor_t, typename controller_t>
-            static callable_wrapper<void(resume_param_t&&)> make_async_next_step(const bp_ptr& data, const dispatcher_t& dispatcher, 
+            static awaitable_next_step_t<resume_param_t> make_async_next_step(const bp_ptr& data, const dispatcher_t& dispatcher, 
                 const adaptor_t& adaptor, controller_t&& controller, size_t token, std::false_type) noexcept {
-                return [data = data, state = token, adaptor = adaptor, 
-                        controller = std::forward<controller_t>(controller), dispatcher = dispatcher] 
+                constexpr bool relocatable = all_trivially_relocatable<bp_ptr, controller_t, adaptor_t, resume_param_t>::value;
+                constexpr bool next_relocatable = all_trivially_relocatable<bp_ptr, controller_t, adaptor_t, decltype(flow_impl::bind_dispatcher(dispatcher))>::value;
+                return relocatable_if<next_relocatable>([data = data, state = token, adaptor = adaptor, 
+                        controller = std::forward<controller_t>(controller), dispatcher = flow_impl::bind_dispatcher(dispatcher)] 
                         (resume_param_t&& in) mutable noexcept {
-                    dispatcher(task_wrapper_sbo([data = std::move(data),
+                    dispatcher(flow_impl::dispatcher_task_t<dispatcher_t>(relocatable_if<relocatable>([data = std::move(data),
                                              controller = std::move(controller),
                                              adaptor = std::move(adaptor),
                                              state = state,
@@ -483,9 +604,9 @@ namespace flux_foundry {
 
                             flow_runner next_runner(std::move(data.first()), std::move(controller), std::move(data.second()));
                                 ipc<I - 1>::run(next_runner, adaptor(std::move(in)));
-                        })
+                        }))
                     );
-                };
+                });
             }
 
             template <typename node_t, typename param_t, size_t I_ = I>
@@ -567,6 +688,7 @@ namespace flux_foundry {
                 };
 
                 guard g{ controller_raw_ptr(controller), state };
+                awaitable.attach_cancel_scope(g.controller);
                 using resume_param_t = typename node_t::Df_t::awaitable_t::async_result_type;
                 awaitable.emplace_nextstep(make_async_next_step<resume_param_t>(self.data, dispatcher, adaptor, 
                     std::move(controller), state, is_inline_executor_t{})
@@ -727,6 +849,15 @@ namespace flux_foundry {
         };
     }
 
+    // both own the blueprint through a lite_ptr.
+    template <typename flow_bp>
+    struct is_trivially_relocatable<fast_runner_impl::bp_storage<lite_ptr<flow_bp>>> : std::true_type {
+    };
+
+    template <typename flow_bp>
+    struct is_trivially_relocatable<fast_runner_impl::bp_storage<flow_bp&&>> : std::true_type {
+    };
+
     template <typename flow_bp_storage, typename receiver_type>
     struct flow_fast_runner {
         static constexpr std::size_t node_count = flow_bp_storage::node_count;
@@ -835,12 +966,13 @@ namespace flux_foundry {
 
             template <typename dispatcher_t, typename param_t>
             static void dispatch_impl(dispatcher_t& dispatcher, flow_fast_runner& self, param_t&& in, std::false_type) noexcept {
+                constexpr bool relocatable = all_trivially_relocatable<decltype(self.data), param_t>::value;
                 dispatcher(
-                    task_wrapper_sbo([data = self.data,
+                    flow_impl::dispatcher_task_t<dispatcher_t>(relocatable_if<relocatable>([data = self.data,
                                       in = std::forward<param_t>(in)]() mutable noexcept {
                         flow_fast_runner next_runner(std::move(data.first()), std::move(data.second()));
                         ipc<I - 1>::run(next_runner, std::move(in));
-                    })
+                    }))
                 );
             }
 
@@ -853,26 +985,29 @@ namespace flux_foundry {
 
             // no cancel 
             template <typename resume_param_t, typename bp_ptr, typename dispatcher_t, typename adaptor_t>
-            static callable_wrapper<void(resume_param_t&&)> make_async_next_step(const bp_ptr& data, const dispatcher_t& dispatcher, 
+            static awaitable_next_step_t<resume_param_t> make_async_next_step(const bp_ptr& data, const dispatcher_t& dispatcher, 
                 const adaptor_t& adaptor, std::true_type) noexcept {
-                return [data = data, adaptor = adaptor](resume_param_t&& in) mutable noexcept {
+                constexpr bool next_relocatable = all_trivially_relocatable<bp_ptr, adaptor_t>::value;
+                return relocatable_if<next_relocatable>([data = data, adaptor = adaptor](resume_param_t&& in) mutable noexcept {
                     flow_fast_runner next_runner(std::move(data.first()), std::move(data.second()));
                     ipc<I - 1>::run(next_runner, adaptor(std::move(in)));
-                };
+                });
             }
 
             template <typename resume_param_t, typename bp_ptr, typename dispatcher_t, typename adaptor_t>
-            static callable_wrapper<void(resume_param_t&&)> make_async_next_step(const bp_ptr& data, const dispatcher_t& dispatcher, 
+            static awaitable_next_step_t<resume_param_t> make_async_next_step(const bp_ptr& data, const dispatcher_t& dispatcher, 
                 const adaptor_t& adaptor, std::false_type) noexcept {
-                return [data = data, dispatcher = dispatcher, adaptor = adaptor] (resume_param_t&& in) mutable noexcept {
-                    dispatcher(task_wrapper_sbo([data = std::move(data),
+                constexpr bool relocatable = all_trivially_relocatable<bp_ptr, adaptor_t, resume_param_t>::value;
+                constexpr bool next_relocatable = all_trivially_relocatable<bp_ptr, adaptor_t, decltype(flow_impl::bind_dispatcher(dispatcher))>::value;
+                return relocatable_if<next_relocatable>([data = data, dispatcher = flow_impl::bind_dispatcher(dispatcher), adaptor = adaptor] (resume_param_t&& in) mutable noexcept {
+                    dispatcher(flow_impl::dispatcher_task_t<dispatcher_t>(relocatable_if<relocatable>([data = std::move(data),
                                          adaptor = std::move(adaptor),
                                          in = std::move(in)]() mutable noexcept {
                             flow_fast_runner next_runner(std::move(data.first()), std::move(data.second()));
                             ipc<I - 1>::run(next_runner, adaptor(std::move(in)));
-                        })
+                        }))
                     );
-                };
+                });
             }
 
             template <typename node_t, typename param_t, size_t I_ = I, std::enable_if_t<I_ != 0>* = nullptr>
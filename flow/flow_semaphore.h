@@ -0,0 +1,288 @@
+#ifndef FLUX_FOUNDRY_FLOW_SEMAPHORE_H
+#define FLUX_FOUNDRY_FLOW_SEMAPHORE_H
+
+#include <atomic>
+#include "../memory/padded_t.h"
+#include "flow_wait_list.h"
+#include "flow_node.h"
+
+namespace flux_foundry {
+    // async_semaphore: admission control for flows.
+    //
+    // | 63 ... 2 | 1 | 0 |
+    // | -------- | -- | -- |
+    // | permits  | closed? | has parked waiters? |
+    //
+    // - try_acquire()/release() are a single CAS on the state word while nobody is parked.
+    // - once the waiter bit is set, permits stay at 0 and release() hands each permit
+    //   directly to the oldest parked waiter (FIFO). newcomers queue up behind them.
+    // - a waiter is resumed outside the list lock, on the thread calling release(),
+    //   unless the await_acquire node is given an executor to resume on.
+    // - close() wakes every parked waiter without a permit. afterwards the remaining permits
+    //   can still be acquired, but acquirers fail instead of parking once they run out.
+    class async_semaphore {
+        static constexpr size_t waiters_flag = size_t(1) << 0;
+        static constexpr size_t closed_flag = size_t(1) << 1;
+        static constexpr size_t permit_unit = size_t(1) << 2;
+
+        padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> state_;
+        detail::flow_wait_list waiters_;
+
+    public:
+        enum class acquire_status {
+            acquired,
+            parked,
+            closed,
+        };
+
+        explicit async_semaphore(size_t permits) noexcept
+            : state_(permits * permit_unit) {
+        }
+
+        async_semaphore(const async_semaphore&) = delete;
+        async_semaphore& operator=(const async_semaphore&) = delete;
+
+        bool try_acquire() noexcept {
+            auto& state = state_.get();
+            auto exp = state.load(std::memory_order_relaxed);
+            while ((exp & waiters_flag) == 0 && exp >= permit_unit) {
+                if (state.compare_exchange_weak(exp, exp - permit_unit,
+                    std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void release(size_t n = 1) noexcept {
+            auto& state = state_.get();
+            auto exp = state.load(std::memory_order_relaxed);
+            while (n) {
+                LIKELY_IF ((exp & waiters_flag) == 0) {
+                    if (state.compare_exchange_weak(exp, exp + n * permit_unit,
+                        std::memory_order_release, std::memory_order_relaxed)) {
+                        return;
+                    }
+                    continue;
+                }
+
+                detail::flow_waiter* w = nullptr;
+                {
+                    detail::flow_wait_list_guard g(waiters_);
+                    // the waiter bit can only be cleared under the lock, re-check it here.
+                    if (state.load(std::memory_order_relaxed) & waiters_flag) {
+                        w = waiters_.pop_front();
+                        if (waiters_.empty()) {
+                            state.fetch_and(~waiters_flag, std::memory_order_relaxed);
+                        }
+                    }
+                }
+
+                if (w) {
+                    --n;
+                    w->wake(w);
+                }
+                exp = state.load(std::memory_order_relaxed);
+            }
+        }
+
+        void close() noexcept {
+            detail::flow_waiter* w = nullptr;
+            {
+                detail::flow_wait_list_guard g(waiters_);
+                w = waiters_.take_all();
+                for (auto p = w; p; p = p->next) {
+                    p->closed = true;
+                }
+                auto exp = state_.get().load(std::memory_order_relaxed);
+                while (!state_.get().compare_exchange_weak(exp, (exp | closed_flag) & ~waiters_flag,
+                    std::memory_order_release, std::memory_order_relaxed)) {
+                }
+            }
+
+            while (w) {
+                auto next = w->next;
+                w->next = nullptr;
+                w->wake(w);
+                w = next;
+            }
+        }
+
+        bool is_closed() const noexcept {
+            return (state_.get().load(std::memory_order_acquire) & closed_flag) != 0;
+        }
+
+        size_t available() const noexcept {
+            return state_.get().load(std::memory_order_relaxed) / permit_unit;
+        }
+
+        // acquired: a permit is taken immediately.
+        // parked: w is queued and w->wake(w) will be called once a permit is handed to it,
+        //         or with w->closed set if the semaphore is closed first.
+        // closed: no permit left and the semaphore is closed.
+        acquire_status acquire_or_park(detail::flow_waiter* w) noexcept {
+            LIKELY_IF (try_acquire()) {
+                return acquire_status::acquired;
+            }
+
+            auto& state = state_.get();
+            detail::flow_wait_list_guard g(waiters_);
+            auto exp = state.load(std::memory_order_relaxed);
+            for (;;) {
+                if (exp & waiters_flag) {
+                    break;
+                }
+
+                if (exp >= permit_unit) {
+                    if (state.compare_exchange_weak(exp, exp - permit_unit,
+                        std::memory_order_acquire, std::memory_order_relaxed)) {
+                        return acquire_status::acquired;
+                    }
+                    continue;
+                }
+
+                if (exp & closed_flag) {
+                    return acquire_status::closed;
+                }
+
+                if (state.compare_exchange_weak(exp, waiters_flag,
+                    std::memory_order_relaxed, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+
+            w->closed = false;
+            waiters_.push_back(w);
+            return acquire_status::parked;
+        }
+
+        // returns true if w was still parked and has been unlinked,
+        // false if it has already been popped (a permit is handed to it, or w->closed is set).
+        bool cancel_park(detail::flow_waiter* w) noexcept {
+            detail::flow_wait_list_guard g(waiters_);
+            UNLIKELY_IF (!waiters_.erase(w)) {
+                return false;
+            }
+
+            if (waiters_.empty()) {
+                state_.get().fetch_and(~waiters_flag, std::memory_order_relaxed);
+            }
+            return true;
+        }
+    };
+
+namespace detail {
+    // forwards its input once a permit is acquired, error inputs pass through without taking a permit.
+    template <typename R>
+    struct semaphore_acquire_awaitable final
+        : awaitable_base<semaphore_acquire_awaitable<R>, typename R::value_type, typename R::error_type> {
+        using async_result_type = R;
+        using error_type = typename R::error_type;
+
+        async_semaphore* sem;
+        flow_waiter waiter;
+        R in;
+
+        semaphore_acquire_awaitable(async_semaphore* sem_, R&& in_)
+            noexcept(std::is_nothrow_move_constructible<R>::value)
+            : sem(sem_), in(std::move(in_)) {
+            waiter.wake = on_wake;
+            waiter.owner = this;
+        }
+
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+        bool available() const noexcept {
+            return true;
+        }
+#endif
+
+        static void on_wake(flow_waiter* w) noexcept {
+            auto self = static_cast<semaphore_acquire_awaitable*>(w->owner);
+            // if cancel() won the race, resume() is a no-op and cancel() gives the permit back.
+            UNLIKELY_IF (w->closed) {
+                self->resume(R(error_tag, closed_error<error_type>::make()));
+            } else {
+                self->resume(std::move(self->in));
+            }
+            self->release();
+        }
+
+        int submit() noexcept {
+            UNLIKELY_IF (!in.has_value()) {
+                this->resume(std::move(in));
+                return 0;
+            }
+
+            // reference held by the semaphore while parked
+            this->retain();
+            switch (sem->acquire_or_park(&waiter)) {
+                case async_semaphore::acquire_status::acquired:
+                    this->release();
+                    this->resume(std::move(in));
+                    break;
+                case async_semaphore::acquire_status::closed:
+                    this->release();
+                    this->resume(R(error_tag, closed_error<error_type>::make()));
+                    break;
+                default:
+                    break;
+            }
+            return 0;
+        }
+
+        void cancel() noexcept {
+            LIKELY_IF (sem->cancel_park(&waiter)) {
+                this->release();
+                return;
+            }
+
+            // a permit is already on its way to us, but resume() will be rejected.
+            if (!waiter.closed) {
+                sem->release();
+            }
+        }
+    };
+}
+
+namespace flow_impl {
+    template <typename Executor>
+    struct acquire_node {
+        static_assert(check_executor<Executor>::value,
+            "Executor must be pointer-like and support "
+            "noexcept exec->dispatch(task_wrapper_sbo).");
+
+        Executor e;
+        async_semaphore* sem;
+    };
+
+    template <typename I, typename O, typename... Nodes, typename Executor>
+    auto operator|(flow_blueprint<I, O, Nodes...>&& bp, acquire_node<Executor>&& a) {
+        using awaitable_t = detail::semaphore_acquire_awaitable<O>;
+        using wrapper_t = dispatch_wrapper_t<Executor>;
+        using factory_t = bound_awaitable_factory<awaitable_t, async_semaphore>;
+
+        return std::move(bp) | flow_async_node<O, O, wrapper_t, identity, factory_t> {
+            wrapper_t{std::move(a.e)}, identity{}, factory_t{a.sem}
+        };
+    }
+}
+
+    // Suspends the flow until a permit of sem is acquired, then forwards the current output.
+    // The permit is NOT released automatically, pair it with sem.release() downstream.
+    // A canceled waiter is unlinked from the queue and never consumes a permit.
+    // If sem is closed while the flow is parked, it resumes with closed_error<E>.
+    template <typename Executor,
+        std::enable_if_t<flow_impl::check_executor<std::decay_t<Executor>>::value, int> = 0>
+    auto await_acquire(async_semaphore& sem, Executor&& executor_to_resume) noexcept {
+        using E = std::decay_t<Executor>;
+        return flow_impl::acquire_node<E> { std::forward<Executor>(executor_to_resume), &sem };
+    }
+
+    // resume on the thread that calls sem.release().
+    inline auto await_acquire(async_semaphore& sem) noexcept {
+        using E = flow_impl::inline_executor*;
+        return flow_impl::acquire_node<E> { flow_impl::inline_executor::executor(), &sem };
+    }
+}
+
+#endif // FLUX_FOUNDRY_FLOW_SEMAPHORE_H
@@ -0,0 +1,272 @@
+#ifndef FLUX_FOUNDRY_FLOW_STREAM_H
+#define FLUX_FOUNDRY_FLOW_STREAM_H
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/padded_t.h"
+#include "../memory/lite_ptr.h"
+#include "../memory/inplace_t.h"
+#include "../utility/concurrent_queues.h"
+#include "flow_runner.h"
+
+namespace flux_foundry {
+    // a stream receiver gets every item through emplace(), then exactly one complete():
+    // - value: the source completed.
+    // - error: the source failed with that error.
+    template <typename T, typename D = void>
+    struct check_stream_receiver : std::false_type {
+    };
+
+    template <typename T>
+    struct check_stream_receiver<T, void_t<typename T::value_type,
+            std::enable_if_t<conjunction_v<
+                std::is_nothrow_move_constructible<T>,
+                is_result_t<typename T::value_type>>>>>
+        : std::integral_constant<bool,
+            noexcept(std::declval<T&>().emplace(std::declval<typename T::value_type>()))
+            && noexcept(std::declval<T&>().complete(
+                std::declval<result_t<void, typename T::value_type::error_type>>()))> {
+    };
+
+    template <typename T>
+    constexpr bool check_stream_receiver_v = check_stream_receiver<T>::value;
+
+namespace flow_impl {
+    template <typename bp_t, typename receiver_t, size_t capacity>
+    struct stream_state;
+
+    template <typename bp_t, typename receiver_t, size_t capacity>
+    struct stream_driver;
+
+    // per-item receiver: forwards to the stream receiver and hands the turn to the next item.
+    template <typename bp_t, typename receiver_t, size_t capacity>
+    struct stream_item_receiver {
+        using state_t = stream_state<bp_t, receiver_t, capacity>;
+        using value_type = typename bp_t::O_t;
+
+        lite_ptr<state_t> s;
+
+        void emplace(value_type&& r) noexcept {
+            stream_driver<bp_t, receiver_t, capacity>::deliver(s, std::move(r));
+        }
+    };
+
+    // Items go through the blueprint one at a time, in emission order.
+    // All items share this state: the blueprint nodes, the receiver and one flow_controller,
+    // so an item only costs a queue slot plus whatever its async steps allocate.
+    //
+    // - `pending` counts queued items (+1 for the end signal). The thread that moves it away
+    //   from 0 owns the turn and drives the queue.
+    // - `sync` tells whether the item finished before run() returned (keep looping) or
+    //   later (the completing thread takes over the turn), so inline pipelines do not recurse.
+    // - `outstanding` counts granted credits plus undelivered items, and never exceeds capacity,
+    //   which is why the inbox never fills up.
+    template <typename bp_t, typename receiver_t, size_t capacity>
+    struct stream_state {
+        using I_t = typename bp_t::I_t;
+        using O_t = typename bp_t::O_t;
+        using error_type = typename O_t::error_type;
+        using end_t = result_t<void, error_type>;
+        using item_receiver_t = stream_item_receiver<bp_t, receiver_t, capacity>;
+        using item_runner_t = flow_runner<bp_t, item_receiver_t, flow_controller*>;
+
+        enum : int {
+            item_running = 0,
+            item_done = 1,
+            driver_left = 2,
+        };
+
+        padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> credits { 0 };
+        padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> outstanding { 0 };
+        padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> pending { 0 };
+        padded_t<std::atomic<size_t>, CACHE_LINE_SIZE> pushed { 0 };
+        std::atomic<int> sync { item_running };
+        std::atomic<bool> closed { false };
+        size_t popped = 0;
+
+        lite_ptr<bp_t> bp;
+        receiver_t receiver;
+        flow_controller controller;
+        inplace_t<end_t> end;
+        mpsc_queue<I_t, capacity> inbox;
+
+        stream_state(lite_ptr<bp_t> bp_, receiver_t&& receiver_) noexcept
+            : bp(std::move(bp_)), receiver(std::move(receiver_)) {
+        }
+    };
+
+    template <typename bp_t, typename receiver_t, size_t capacity>
+    struct stream_driver {
+        using state_t = stream_state<bp_t, receiver_t, capacity>;
+        using O_t = typename state_t::O_t;
+
+        static void deliver(const lite_ptr<state_t>& s, O_t&& r) noexcept {
+            s->outstanding.get().fetch_sub(1, std::memory_order_release);
+            s->receiver.emplace(std::move(r));
+
+            UNLIKELY_IF (s->sync.exchange(state_t::item_done, std::memory_order_acq_rel) == state_t::driver_left) {
+                LIKELY_IF (s->pending.get().fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                    drive(s);
+                }
+            }
+        }
+
+        static void drive(const lite_ptr<state_t>& s) noexcept {
+            for (;;) {
+                UNLIKELY_IF (s->popped == s->pushed.get().load(std::memory_order_acquire)) {
+                    // nothing left but the end signal. the turn is never given back.
+                    s->receiver.complete(std::move(s->end.get()));
+                    return;
+                }
+
+                ++s->popped;
+                s->sync.store(state_t::item_running, std::memory_order_relaxed);
+                typename state_t::item_runner_t runner(s->bp, &s->controller, typename state_t::item_receiver_t{ s });
+                runner(s->inbox.wait_and_pop());
+
+                // still in flight, deliver() continues the loop on the completing thread.
+                LIKELY_IF (s->sync.exchange(state_t::driver_left, std::memory_order_acq_rel) == state_t::item_running) {
+                    return;
+                }
+
+                UNLIKELY_IF (s->pending.get().fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    return;
+                }
+            }
+        }
+
+        static void schedule(const lite_ptr<state_t>& s) noexcept {
+            UNLIKELY_IF (s->pending.get().fetch_add(1, std::memory_order_acq_rel) == 0) {
+                drive(s);
+            }
+        }
+    };
+}
+
+    // stream_runner: runs a blueprint over a stream of inputs instead of a single one.
+    //
+    // - the consumer grants demand with request(n); the source spends one credit per try_emit().
+    //   without credit try_emit() returns false, so a slow pipeline/consumer throttles the source.
+    // - at most `capacity` credits + undelivered items exist at any time; request() grants less
+    //   when the window is full and returns the amount actually granted.
+    // - items are processed one by one in emission order. calc, via and await nodes all work,
+    //   the next item starts once the previous one reached the receiver.
+    // - complete()/fail() end the stream after the queued items are delivered.
+    //   they must not race with try_emit().
+    // - cancel() cancels the shared controller: the item in flight and every queued item fail with
+    //   cancel_error<E>, and try_emit() refuses new items. the stream still ends with complete()/fail().
+    //
+    // stream_runner is a shared handle, copies refer to the same stream.
+    template <typename bp_t, typename receiver_type, size_t capacity>
+    class stream_runner {
+        using receiver_t = std::decay_t<receiver_type>;
+        using state_t = flow_impl::stream_state<bp_t, receiver_t, capacity>;
+        using driver_t = flow_impl::stream_driver<bp_t, receiver_t, capacity>;
+
+        static_assert(flow_impl::is_blueprint_v<bp_t>, "bp_t must be a flow_blueprint");
+        static_assert(check_stream_receiver_v<receiver_t>,
+            "a valid stream receiver should:\n"
+            "1. be nothrow move constructible.\n"
+            "2. has member:: typename value_type, which should be a result_t<T, E>\n"
+            "3. has member function [ void emplace(value_type&&) noexcept ]\n"
+            "4. has member function [ void complete(result_t<void, E>&&) noexcept ]\n");
+        static_assert(std::is_same<typename receiver_t::value_type, typename bp_t::O_t>::value,
+            "the provided receiver isn't compatible with the current bp's output");
+        static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0,
+            "capacity must be power of 2");
+
+        lite_ptr<state_t> s_;
+
+    public:
+        using I_t = typename bp_t::I_t;
+        using O_t = typename bp_t::O_t;
+        using error_type = typename O_t::error_type;
+
+        stream_runner(lite_ptr<bp_t> bp, receiver_t receiver)
+            : s_(make_lite_ptr<state_t>(std::move(bp), std::move(receiver))) {
+        }
+
+        // returns the number of credits granted, at most n.
+        size_t request(size_t n) noexcept {
+            auto& outstanding = s_->outstanding.get();
+            auto exp = outstanding.load(std::memory_order_relaxed);
+            size_t granted;
+            do {
+                granted = exp < capacity ? (n < capacity - exp ? n : capacity - exp) : 0;
+                UNLIKELY_IF (granted == 0) {
+                    return 0;
+                }
+            } while (!outstanding.compare_exchange_weak(exp, exp + granted,
+                std::memory_order_acquire, std::memory_order_relaxed));
+
+            s_->credits.get().fetch_add(granted, std::memory_order_release);
+            return granted;
+        }
+
+        // credits the source may still spend.
+        size_t demand() const noexcept {
+            return s_->credits.get().load(std::memory_order_acquire);
+        }
+
+        bool try_emit(I_t&& in) noexcept {
+            UNLIKELY_IF (s_->closed.load(std::memory_order_acquire) || s_->controller.is_canceled()) {
+                return false;
+            }
+
+            auto& credits = s_->credits.get();
+            auto exp = credits.load(std::memory_order_acquire);
+            do {
+                UNLIKELY_IF (exp == 0) {
+                    return false;
+                }
+            } while (!credits.compare_exchange_weak(exp, exp - 1,
+                std::memory_order_acquire, std::memory_order_relaxed));
+
+            // the credit window guarantees a free slot, this only waits for other producers.
+            s_->inbox.wait_and_emplace(std::move(in));
+            s_->pushed.get().fetch_add(1, std::memory_order_release);
+            driver_t::schedule(s_);
+            return true;
+        }
+
+        template <typename ... Args,
+            std::enable_if_t<std::is_constructible<typename I_t::value_type, Args&& ...>::value>* = nullptr>
+        bool try_emit(Args&& ... args) noexcept {
+            return try_emit(I_t(value_tag, std::forward<Args>(args)...));
+        }
+
+        void complete() noexcept {
+            finish(typename state_t::end_t(value_tag));
+        }
+
+        void fail(error_type e) noexcept {
+            finish(typename state_t::end_t(error_tag, std::move(e)));
+        }
+
+        void cancel(bool force = false) noexcept {
+            s_->controller.cancel(force);
+        }
+
+        bool is_canceled() const noexcept {
+            return s_->controller.is_canceled();
+        }
+
+    private:
+        void finish(typename state_t::end_t&& r) noexcept {
+            UNLIKELY_IF (s_->closed.exchange(true, std::memory_order_acq_rel)) {
+                return;
+            }
+            s_->end.emplace(std::move(r));
+            driver_t::schedule(s_);
+        }
+    };
+
+    template <size_t capacity, typename bp_t, typename receiver_t>
+    auto make_stream_runner(lite_ptr<bp_t> bp, receiver_t receiver) {
+        return stream_runner<bp_t, receiver_t, capacity>(std::move(bp), std::move(receiver));
+    }
+}
+
+#endif // FLUX_FOUNDRY_FLOW_STREAM_H
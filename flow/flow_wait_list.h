@@ -0,0 +1,141 @@
+#ifndef FLUX_FOUNDRY_FLOW_WAIT_LIST_H
+#define FLUX_FOUNDRY_FLOW_WAIT_LIST_H
+
+#include <atomic>
+#include "../base/traits.h"
+#include "../utility/back_off.h"
+
+namespace flux_foundry {
+namespace detail {
+    // Intrusive node embedded in a parked awaitable.
+    // `wake` is invoked exactly once, outside the list lock, after the node is popped
+    // by the primitive that owns the list (semaphore release, mutex unlock, ...).
+    // `closed` is set under the list lock when the node is popped because the primitive was closed.
+    // `shared` is free for the primitive to interpret (e.g. reader vs writer).
+    struct flow_waiter {
+        using wake_t = void (*)(flow_waiter*);
+
+        flow_waiter* prev { nullptr };
+        flow_waiter* next { nullptr };
+        wake_t wake { nullptr };
+        void* owner { nullptr };
+        bool linked { false };
+        bool closed { false };
+        bool shared { false };
+    };
+
+    // FIFO of parked waiters.
+    // The list is guarded by a tiny test-and-test-and-set lock: cancellation has to unlink
+    // a node from the middle in O(1), which a lock-free singly linked queue cannot do.
+    // Primitives built on top keep their uncontended path on a separate atomic word and only
+    // touch this lock once somebody actually has to park.
+    class flow_wait_list {
+        std::atomic<bool> locked_ { false };
+        flow_waiter* head_ { nullptr };
+        flow_waiter* tail_ { nullptr };
+
+    public:
+        flow_wait_list() noexcept = default;
+        flow_wait_list(const flow_wait_list&) = delete;
+        flow_wait_list& operator=(const flow_wait_list&) = delete;
+
+        void lock() noexcept {
+            for (backoff_strategy<> backoff;; backoff.yield()) {
+                if (!locked_.load(std::memory_order_relaxed)
+                    && !locked_.exchange(true, std::memory_order_acquire)) {
+                    return;
+                }
+            }
+        }
+
+        void unlock() noexcept {
+            locked_.store(false, std::memory_order_release);
+        }
+
+        // all the functions below must be called with the lock held.
+        bool empty() const noexcept {
+            return head_ == nullptr;
+        }
+
+        flow_waiter* front() const noexcept {
+            return head_;
+        }
+
+        void push_back(flow_waiter* w) noexcept {
+            w->next = nullptr;
+            w->prev = tail_;
+            w->linked = true;
+            if (tail_) {
+                tail_->next = w;
+            } else {
+                head_ = w;
+            }
+            tail_ = w;
+        }
+
+        flow_waiter* pop_front() noexcept {
+            auto w = head_;
+            UNLIKELY_IF (!w) {
+                return nullptr;
+            }
+            head_ = w->next;
+            if (head_) {
+                head_->prev = nullptr;
+            } else {
+                tail_ = nullptr;
+            }
+            w->next = w->prev = nullptr;
+            w->linked = false;
+            return w;
+        }
+
+        // detaches every waiter, the returned chain is linked through `next`.
+        flow_waiter* take_all() noexcept {
+            auto w = head_;
+            for (auto p = w; p; p = p->next) {
+                p->prev = nullptr;
+                p->linked = false;
+            }
+            head_ = tail_ = nullptr;
+            return w;
+        }
+
+        // returns false if w has already been popped.
+        bool erase(flow_waiter* w) noexcept {
+            if (!w->linked) {
+                return false;
+            }
+            if (w->prev) {
+                w->prev->next = w->next;
+            } else {
+                head_ = w->next;
+            }
+            if (w->next) {
+                w->next->prev = w->prev;
+            } else {
+                tail_ = w->prev;
+            }
+            w->next = w->prev = nullptr;
+            w->linked = false;
+            return true;
+        }
+    };
+
+    struct flow_wait_list_guard {
+        flow_wait_list& list;
+
+        explicit flow_wait_list_guard(flow_wait_list& l) noexcept : list(l) {
+            list.lock();
+        }
+
+        ~flow_wait_list_guard() noexcept {
+            list.unlock();
+        }
+
+        flow_wait_list_guard(const flow_wait_list_guard&) = delete;
+        flow_wait_list_guard& operator=(const flow_wait_list_guard&) = delete;
+    };
+}
+}
+
+#endif // FLUX_FOUNDRY_FLOW_WAIT_LIST_H
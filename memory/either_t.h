@@ -1,12 +1,16 @@
 #ifndef FLUX_FOUNDRY_EITHERT_H
 #define FLUX_FOUNDRY_EITHERT_H
 
+#include <cstring>
 #include <memory>
+#include <system_error>
 
 #include "../base/inplace_base.h"
 
 // precondition: either_state is always first or second for either_storage_base<void, U>
 // empty state only exists during raw_either_storage_base default construction
+// with a niche (see either_niche) there is no room for empty, it reads back as first, which is why
+// the niche is only used when the first alternative is void or trivially destructible
 
 namespace flux_foundry {
     using first_t = in_place_index<0>;
@@ -19,10 +23,97 @@ namespace flux_foundry {
 		empty, first, second,
 	};
 
+	// either_niche<X>: opt-in declaration of a spare representation of X, a bit pattern no live X ever holds
+	// (a pointer that is never null, a NaN payload, ...). either_t<T, X> keeps its discriminant there instead
+	// of a separate either_state when T fits in the bytes of X before the niche.
+	// a declaration provides:
+	//   static constexpr bool enabled = true;
+	//   static constexpr size_t offset;             first byte of the niche inside X
+	//   static bool is_niche(const void*) noexcept  true if the storage of X holds the niche, i.e. no X lives there
+	//   static void set_niche(void*) noexcept       writes the niche into storage no X lives in
+	template <typename X>
+	struct either_niche {
+		static constexpr bool enabled = false;
+	};
+
+	// the niche of a type holding a pointer at `offset_` that is never null.
+	template <size_t offset_>
+	struct pointer_niche {
+		static constexpr bool enabled = true;
+		static constexpr size_t offset = offset_;
+
+		static bool is_niche(const void* p) noexcept {
+			const void* v;
+			std::memcpy(&v, static_cast<const unsigned char*>(p) + offset, sizeof(v));
+			return v == nullptr;
+		}
+
+		static void set_niche(void* p) noexcept {
+			const void* v = nullptr;
+			std::memcpy(static_cast<unsigned char*>(p) + offset, &v, sizeof(v));
+		}
+	};
+
+#if FLUX_FOUNDRY_ERROR_CODE_NICHE
+	// error_code is {int value; const error_category* cat;} in libstdc++, libc++ and the MSVC STL,
+	// and a live one always points at a category.
+	template <>
+	struct either_niche<std::error_code> : pointer_niche<sizeof(std::error_code) - sizeof(void*)> {
+	};
+#endif
+
+	template <typename T>
+	struct either_first_size : std::integral_constant<size_t, sizeof(T)> {
+	};
+
+	template <>
+	struct either_first_size<void> : std::integral_constant<size_t, 0> {
+	};
+
+	template <typename T, typename U, bool = either_niche<U>::enabled>
+	struct either_uses_niche : std::false_type {
+	};
+
+	template <typename T, typename U>
+	struct either_uses_niche<T, U, true> : std::integral_constant<bool, conjunction_v<
+		disjunction<std::is_void<T>, std::is_trivially_destructible<T>>,
+		std::integral_constant<bool, either_first_size<T>::value <= either_niche<U>::offset>>> {
+	};
+
+	// either_discriminant: where raw_either_storage_base keeps its either_state.
+	// by default an either_state next to the storage, with a niche in U it is an empty base
+	// and the state is read from the bytes of the union.
+	template <typename T, typename U, bool = either_uses_niche<T, U>::value>
+	struct either_discriminant {
+		either_state _state;
+
+		either_state load(const void*) const noexcept {
+			return _state;
+		}
+
+		void store(void*, either_state s) noexcept {
+			_state = s;
+		}
+	};
+
+	template <typename T, typename U>
+	struct either_discriminant<T, U, true> {
+		static either_state load(const void* data) noexcept {
+			return either_niche<U>::is_niche(data) ? either_state::first : either_state::second;
+		}
+
+		// a live U already is its own discriminant, first and empty write the niche.
+		static void store(void* data, either_state s) noexcept {
+			if (s != either_state::second) {
+				either_niche<U>::set_niche(data);
+			}
+		}
+	};
+
 	template <typename T, typename U,
 			bool = std::is_trivially_destructible<T>::value,
 			bool = std::is_trivially_destructible<U>::value>
-	struct TS_EMPTY_BASES raw_either_storage_base {
+	struct TS_EMPTY_BASES raw_either_storage_base : either_discriminant<T, U> {
 		static_assert(conjunction_v<std::is_nothrow_destructible<T>, std::is_nothrow_destructible<U>>,
 			"T and U must be nothrow destructible");
 		static_assert(can_strong_move_or_copy_constructible<U>::value,
@@ -36,7 +127,15 @@ namespace flux_foundry {
 			~storage() noexcept {}
 		} _data;
         
-		either_state _state;
+		using discriminant = either_discriminant<T, U>;
+
+		either_state _get_state() const noexcept {
+			return discriminant::load(std::addressof(_data));
+		}
+
+		void _set_state(either_state s) noexcept {
+			discriminant::store(std::addressof(_data), s);
+		}
 
 		using first_type = T;
 		using second_type = U;
@@ -44,8 +143,8 @@ namespace flux_foundry {
 		using opt = raw_inplace_storage_operations<T>;
 		using opu = raw_inplace_storage_operations<U>;
 
-		explicit raw_either_storage_base() noexcept 
-			: _state {either_state::empty} {
+		explicit raw_either_storage_base() noexcept {
+			_set_state(either_state::empty);
 		}
 
 		template <typename T_ = T, typename ... Args,
@@ -56,9 +155,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(first_t, Args && ... args)
-			noexcept (std::is_nothrow_constructible<T_, Args&&...>::value) :
-			_state{either_state::first} {
+			noexcept (std::is_nothrow_constructible<T_, Args&&...>::value) {
 			opt::construct_at(std::addressof(_data.first), std::forward<Args>(args)...);
+			_set_state(either_state::first);
 		}
 
 		template <typename T_ = T, typename F, typename ... Args,
@@ -69,9 +168,9 @@ namespace flux_foundry {
 #endif
 			>
 		raw_either_storage_base(first_t, std::initializer_list<F> il, Args && ... args)
-			noexcept (std::is_nothrow_constructible<T_, std::initializer_list<F>, Args&&...>::value) :
-			_state{either_state::first} {
+			noexcept (std::is_nothrow_constructible<T_, std::initializer_list<F>, Args&&...>::value) {
 			opt::construct_at(std::addressof(_data.first), il, std::forward<Args>(args)...);
+			_set_state(either_state::first);
 		}
 
 		template <typename U_ = U, typename... Args,
@@ -82,8 +181,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, Args &&... args)
-			noexcept (std::is_nothrow_constructible<U_, Args &&...>::value) : _state{either_state::second} {
+			noexcept (std::is_nothrow_constructible<U_, Args &&...>::value) {
 			opu::construct_at(std::addressof(_data.second), std::forward<Args>(args)...);
+			_set_state(either_state::second);
 		}
 
 		template <typename U_ = U, typename F, typename... Args,
@@ -95,8 +195,9 @@ namespace flux_foundry {
 		>
 		raw_either_storage_base(second_t, std::initializer_list<F> il, Args &&... args)
 			noexcept (std::is_nothrow_constructible<U_, std::initializer_list<F>, Args &&...>::value
-			) : _state{either_state::second} {
+			) {
 			opu::construct_at(std::addressof(_data.second), il, std::forward<Args>(args)...);
+			_set_state(either_state::second);
 		}
 
 		template <typename T_ = T,
@@ -107,9 +208,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(first_t, const T &t)
-			noexcept(std::is_nothrow_copy_constructible<T>::value)
-			: _state{either_state::first} {
+			noexcept(std::is_nothrow_copy_constructible<T>::value) {
 			opt::construct_at(std::addressof(_data.first), t);
+			_set_state(either_state::first);
 		}
 
 		template <typename T_ = T,
@@ -120,9 +221,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(first_t, T &&t)
-			noexcept(std::is_nothrow_move_constructible<T>::value)
-			: _state{either_state::first} {
+			noexcept(std::is_nothrow_move_constructible<T>::value) {
 			opt::construct_at(std::addressof(_data.first), std::move(t));
+			_set_state(either_state::first);
 		}
 
 		template <typename U_ = U,
@@ -133,9 +234,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, const U &u)
-			noexcept(std::is_nothrow_copy_constructible<U>::value)
-			: _state{either_state::second} {
+			noexcept(std::is_nothrow_copy_constructible<U>::value) {
 			opu::construct_at(std::addressof(_data.second), u);
+			_set_state(either_state::second);
 		}
 
 		template <typename U_ = U,
@@ -146,22 +247,22 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, U &&u)
-			noexcept(std::is_nothrow_move_constructible<U>::value)
-			: _state{either_state::second} {
+			noexcept(std::is_nothrow_move_constructible<U>::value) {
 			opu::construct_at(std::addressof(_data.second), std::move(u));
+			_set_state(either_state::second);
 		}
 
 		~raw_either_storage_base() noexcept {
-			if (_state == either_state::first) {
+			if (_get_state() == either_state::first) {
 				opt::destroy_at(std::addressof(_data.first));
-			} else if (_state == either_state::second) {
+			} else if (_get_state() == either_state::second) {
 				opu::destroy_at(std::addressof(_data.second));
 			}
 		}
 	};
 
 	template <typename T, typename U>
-	struct TS_EMPTY_BASES raw_either_storage_base <T, U, true, false> {
+	struct TS_EMPTY_BASES raw_either_storage_base <T, U, true, false> : either_discriminant<T, U> {
 		static_assert(conjunction_v<std::is_nothrow_destructible<T>, std::is_nothrow_destructible<U>>,
 			"T and U must be nothrow destructible");
 		static_assert(can_strong_move_or_copy_constructible<U>::value,
@@ -173,7 +274,15 @@ namespace flux_foundry {
 			storage() noexcept {}
 			~storage() noexcept {}
 		} _data;
-        either_state _state;
+		using discriminant = either_discriminant<T, U>;
+
+		either_state _get_state() const noexcept {
+			return discriminant::load(std::addressof(_data));
+		}
+
+		void _set_state(either_state s) noexcept {
+			discriminant::store(std::addressof(_data), s);
+		}
 
 		using first_type = T;
 		using second_type = U;
@@ -181,9 +290,9 @@ namespace flux_foundry {
 		using opt = raw_inplace_storage_operations<T>;
 		using opu = raw_inplace_storage_operations<U>;
 
-		explicit raw_either_storage_base() noexcept :
-			_state { either_state::empty } {
-        }
+		explicit raw_either_storage_base() noexcept {
+			_set_state(either_state::empty);
+		}
 		raw_either_storage_base(const raw_either_storage_base &) = default;
 		raw_either_storage_base(raw_either_storage_base &&) = default;
 		raw_either_storage_base &operator=(const raw_either_storage_base &) = default;
@@ -197,9 +306,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(first_t, Args && ... args)
-			noexcept (std::is_nothrow_constructible<T_, Args&&...>::value) :
-			_state{either_state::first} {
+			noexcept (std::is_nothrow_constructible<T_, Args&&...>::value) {
 			opt::construct_at(std::addressof(_data.first), std::forward<Args>(args)...);
+			_set_state(either_state::first);
 		}
 
 		template <typename T_ = T, typename F, typename ... Args,
@@ -210,9 +319,9 @@ namespace flux_foundry {
 #endif
 			>
 		raw_either_storage_base(first_t, std::initializer_list<F> il, Args && ... args)
-			noexcept (std::is_nothrow_constructible<T_, std::initializer_list<F>, Args&&...>::value) :
-			_state{either_state::first} {
+			noexcept (std::is_nothrow_constructible<T_, std::initializer_list<F>, Args&&...>::value) {
 			opt::construct_at(std::addressof(_data.first), il, std::forward<Args>(args)...);
+			_set_state(either_state::first);
 		}
 
 		template <typename U_ = U, typename... Args,
@@ -223,8 +332,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, Args &&... args)
-			noexcept (std::is_nothrow_constructible<U_, Args &&...>::value) : _state{either_state::second} {
+			noexcept (std::is_nothrow_constructible<U_, Args &&...>::value) {
 			opu::construct_at(std::addressof(_data.second), std::forward<Args>(args)...);
+			_set_state(either_state::second);
 		}
 
 		template <typename U_ = U, typename F, typename... Args,
@@ -235,8 +345,9 @@ namespace flux_foundry {
 #endif
 		>
 		raw_either_storage_base(second_t, std::initializer_list<F> il, Args &&... args)
-			noexcept (std::is_nothrow_constructible<U_, std::initializer_list<F>, Args &&...>::value) : _state{either_state::second} {
+			noexcept (std::is_nothrow_constructible<U_, std::initializer_list<F>, Args &&...>::value) {
 			opu::construct_at(std::addressof(_data.second), il, std::forward<Args>(args)...);
+			_set_state(either_state::second);
 		}
 
 		template <typename T_ = T,
@@ -247,9 +358,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(first_t, const T &t)
-			noexcept(std::is_nothrow_copy_constructible<T>::value)
-			: _state{either_state::first} {
+			noexcept(std::is_nothrow_copy_constructible<T>::value) {
 			opt::construct_at(std::addressof(_data.first), t);
+			_set_state(either_state::first);
 		}
 
 		template <typename T_ = T,
@@ -260,9 +371,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(first_t, T &&t)
-			noexcept(std::is_nothrow_move_constructible<T>::value)
-			: _state{either_state::first} {
+			noexcept(std::is_nothrow_move_constructible<T>::value) {
 			opt::construct_at(std::addressof(_data.first), std::move(t));
+			_set_state(either_state::first);
 		}
 
 		template <typename U_ = U,
@@ -273,9 +384,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, const U &u)
-			noexcept(std::is_nothrow_copy_constructible<U>::value)
-			: _state{either_state::second} {
+			noexcept(std::is_nothrow_copy_constructible<U>::value) {
 			opu::construct_at(std::addressof(_data.second), u);
+			_set_state(either_state::second);
 		}
 
 		template <typename U_ = U,
@@ -286,20 +397,20 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, U &&u)
-			noexcept(std::is_nothrow_move_constructible<U>::value)
-			: _state{either_state::second} {
+			noexcept(std::is_nothrow_move_constructible<U>::value) {
 			opu::construct_at(std::addressof(_data.second), std::move(u));
+			_set_state(either_state::second);
 		}
 
 		~raw_either_storage_base() noexcept {
-			if (_state == either_state::second) {
+			if (_get_state() == either_state::second) {
 				opu::destroy_at(std::addressof(_data.second));
 			}
 		}
 	};
 
 	template <typename T, typename U>
-	struct TS_EMPTY_BASES raw_either_storage_base <T, U, false, true> {
+	struct TS_EMPTY_BASES raw_either_storage_base <T, U, false, true> : either_discriminant<T, U> {
 		static_assert(conjunction_v<std::is_nothrow_destructible<T>, std::is_nothrow_destructible<U>>,
 			"T and U must be nothrow destructible");
 		static_assert(can_strong_move_or_copy_constructible<U>::value,
@@ -312,7 +423,15 @@ namespace flux_foundry {
 			storage() noexcept {}
 			~storage() noexcept {}
 		} _data;
-        either_state _state;
+		using discriminant = either_discriminant<T, U>;
+
+		either_state _get_state() const noexcept {
+			return discriminant::load(std::addressof(_data));
+		}
+
+		void _set_state(either_state s) noexcept {
+			discriminant::store(std::addressof(_data), s);
+		}
 
 		using first_type = T;
 		using second_type = U;
@@ -320,9 +439,9 @@ namespace flux_foundry {
 		using opt = raw_inplace_storage_operations<T>;
 		using opu = raw_inplace_storage_operations<U>;
 
-		explicit raw_either_storage_base() noexcept : 
-			_state { either_state::empty } {
-        }
+		explicit raw_either_storage_base() noexcept {
+			_set_state(either_state::empty);
+		}
 		raw_either_storage_base(const raw_either_storage_base &) = default;
 		raw_either_storage_base(raw_either_storage_base &&) = default;
 		raw_either_storage_base &operator=(const raw_either_storage_base &) = default;
@@ -336,9 +455,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(first_t, Args && ... args)
-			noexcept (std::is_nothrow_constructible<T_, Args&&...>::value) :
-			_state{either_state::first} {
+			noexcept (std::is_nothrow_constructible<T_, Args&&...>::value) {
 			opt::construct_at(std::addressof(_data.first), std::forward<Args>(args)...);
+			_set_state(either_state::first);
 		}
 
 		template <typename T_ = T, typename F, typename ... Args,
@@ -349,9 +468,9 @@ namespace flux_foundry {
 #endif
 			>
 		raw_either_storage_base(first_t, std::initializer_list<F> il, Args && ... args)
-			noexcept (std::is_nothrow_constructible<T_, std::initializer_list<F>, Args&&...>::value) :
-			_state{either_state::first} {
+			noexcept (std::is_nothrow_constructible<T_, std::initializer_list<F>, Args&&...>::value) {
 			opt::construct_at(std::addressof(_data.first), il, std::forward<Args>(args)...);
+			_set_state(either_state::first);
 		}
 
 		template <typename U_ = U, typename ... Args,
@@ -362,8 +481,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, Args &&... args)
-			noexcept (std::is_nothrow_constructible<U_, Args &&...>::value) : _state{either_state::second} {
+			noexcept (std::is_nothrow_constructible<U_, Args &&...>::value) {
 			opu::construct_at(std::addressof(_data.second), std::forward<Args>(args)...);
+			_set_state(either_state::second);
 		}
 
 		template <typename U_ = U, typename F, typename... Args,
@@ -375,8 +495,9 @@ namespace flux_foundry {
 		>
 		raw_either_storage_base(second_t, std::initializer_list<F> il, Args &&... args)
 			noexcept (std::is_nothrow_constructible<U_, std::initializer_list<F>, Args &&...>::value
-			) : _state{either_state::second} {
+			) {
 			opu::construct_at(std::addressof(_data.second), il, std::forward<Args>(args)...);
+			_set_state(either_state::second);
 		}
 
 		template <typename T_ = T,
@@ -387,9 +508,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(first_t, const T &t)
-			noexcept(std::is_nothrow_copy_constructible<T>::value)
-			: _state{either_state::first} {
+			noexcept(std::is_nothrow_copy_constructible<T>::value) {
 			opt::construct_at(std::addressof(_data.first), t);
+			_set_state(either_state::first);
 		}
 
 		template <typename T_ = T,
@@ -400,9 +521,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(first_t, T &&t)
-			noexcept(std::is_nothrow_move_constructible<T>::value)
-			: _state{either_state::first} {
+			noexcept(std::is_nothrow_move_constructible<T>::value) {
 			opt::construct_at(std::addressof(_data.first), std::move(t));
+			_set_state(either_state::first);
 		}
 
 		template <typename U_ = U,
@@ -413,9 +534,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, const U &u)
-			noexcept(std::is_nothrow_copy_constructible<U>::value)
-			: _state{either_state::second} {
+			noexcept(std::is_nothrow_copy_constructible<U>::value) {
 			opu::construct_at(std::addressof(_data.second), u);
+			_set_state(either_state::second);
 		}
 
 		template <typename U_ = U,
@@ -426,20 +547,20 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, U &&u)
-			noexcept(std::is_nothrow_move_constructible<U>::value)
-			: _state{either_state::second} {
+			noexcept(std::is_nothrow_move_constructible<U>::value) {
 			opu::construct_at(std::addressof(_data.second), std::move(u));
+			_set_state(either_state::second);
 		}
 
 		~raw_either_storage_base() noexcept {
-			if (_state == either_state::first) {
+			if (_get_state() == either_state::first) {
 				opt::destroy_at(std::addressof(_data.first));
 			}
 		}
 	};
 
 	template <typename T, typename U>
-	struct TS_EMPTY_BASES raw_either_storage_base <T, U, true, true> {
+	struct TS_EMPTY_BASES raw_either_storage_base <T, U, true, true> : either_discriminant<T, U> {
 		static_assert(conjunction_v<std::is_nothrow_destructible<T>, std::is_nothrow_destructible<U>>,
 			"T and U must be nothrow destructible");
 		static_assert(can_strong_move_or_copy_constructible<U>::value,
@@ -451,7 +572,15 @@ namespace flux_foundry {
 
 			storage() noexcept {}
 		} _data;
-		either_state _state;
+		using discriminant = either_discriminant<T, U>;
+
+		either_state _get_state() const noexcept {
+			return discriminant::load(std::addressof(_data));
+		}
+
+		void _set_state(either_state s) noexcept {
+			discriminant::store(std::addressof(_data), s);
+		}
 
 		using first_type = T;
 		using second_type = U;
@@ -459,9 +588,9 @@ namespace flux_foundry {
 		using opt = raw_inplace_storage_operations<T>;
 		using opu = raw_inplace_storage_operations<U>;
 
-		explicit raw_either_storage_base() noexcept
-			: _state { either_state::empty } {
-        }
+		explicit raw_either_storage_base() noexcept {
+			_set_state(either_state::empty);
+		}
         raw_either_storage_base(const raw_either_storage_base&) = default;
 		raw_either_storage_base(raw_either_storage_base &&) = default;
 		raw_either_storage_base &operator=(const raw_either_storage_base &) = default;
@@ -475,9 +604,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(first_t, Args && ... args)
-			noexcept (std::is_nothrow_constructible<T_, Args&&...>::value) :
-			_state{either_state::first} {
+			noexcept (std::is_nothrow_constructible<T_, Args&&...>::value) {
 			opt::construct_at(std::addressof(_data.first), std::forward<Args>(args)...);
+			_set_state(either_state::first);
 		}
 
 		template <typename T_ = T, typename F, typename ... Args,
@@ -488,9 +617,9 @@ namespace flux_foundry {
 #endif
 			>
 		raw_either_storage_base(first_t, std::initializer_list<F> il, Args && ... args)
-			noexcept (std::is_nothrow_constructible<T_, std::initializer_list<F>, Args&&...>::value) :
-			_state{either_state::first} {
+			noexcept (std::is_nothrow_constructible<T_, std::initializer_list<F>, Args&&...>::value) {
 			opt::construct_at(std::addressof(_data.first), il, std::forward<Args>(args)...);
+			_set_state(either_state::first);
 		}
 
 		template <typename U_ = U, typename... Args,
@@ -501,8 +630,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, Args &&... args)
-			noexcept (std::is_nothrow_constructible<U_, Args &&...>::value) : _state{either_state::second} {
+			noexcept (std::is_nothrow_constructible<U_, Args &&...>::value) {
 			opu::construct_at(std::addressof(_data.second), std::forward<Args>(args)...);
+			_set_state(either_state::second);
 		}
 
 		template <typename U_ = U, typename F, typename... Args,
@@ -514,8 +644,9 @@ namespace flux_foundry {
 		>
 		raw_either_storage_base(second_t, std::initializer_list<F> il, Args &&... args)
 			noexcept (std::is_nothrow_constructible<U_, std::initializer_list<F>, Args &&...>::value
-			) : _state{either_state::second} {
+			) {
 			opu::construct_at(std::addressof(_data.second), il, std::forward<Args>(args)...);
+			_set_state(either_state::second);
 		}
 
 		template <typename T_ = T,
@@ -526,9 +657,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(first_t, const T &t)
-			noexcept(std::is_nothrow_copy_constructible<T>::value)
-			: _state{either_state::first} {
+			noexcept(std::is_nothrow_copy_constructible<T>::value) {
 			opt::construct_at(std::addressof(_data.first), t);
+			_set_state(either_state::first);
 		}
 
 		template <typename T_ = T,
@@ -539,9 +670,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(first_t, T &&t)
-			noexcept(std::is_nothrow_move_constructible<T>::value)
-			: _state{either_state::first} {
+			noexcept(std::is_nothrow_move_constructible<T>::value) {
 			opt::construct_at(std::addressof(_data.first), std::move(t));
+			_set_state(either_state::first);
 		}
 
 		template <typename U_ = U,
@@ -552,9 +683,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, const U &u)
-			noexcept(std::is_nothrow_copy_constructible<U>::value)
-			: _state{either_state::second} {
+			noexcept(std::is_nothrow_copy_constructible<U>::value) {
 			opu::construct_at(std::addressof(_data.second), u);
+			_set_state(either_state::second);
 		}
 
 		template <typename U_ = U,
@@ -565,16 +696,16 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, U &&u)
-			noexcept(std::is_nothrow_move_constructible<U>::value)
-			: _state{either_state::second} {
+			noexcept(std::is_nothrow_move_constructible<U>::value) {
 			opu::construct_at(std::addressof(_data.second), std::move(u));
+			_set_state(either_state::second);
 		}
 
 		~raw_either_storage_base() noexcept = default;
 	};
 
 	template <typename U>
-	struct TS_EMPTY_BASES raw_either_storage_base <void, U, false, true> {
+	struct TS_EMPTY_BASES raw_either_storage_base <void, U, false, true> : either_discriminant<void, U> {
 		static_assert(std::is_nothrow_destructible<U>::value,
 			"U must be nothrow destructible");
 		static_assert(can_strong_move_or_copy_constructible<U>::value,
@@ -586,7 +717,15 @@ namespace flux_foundry {
 
 			storage() noexcept {}
 		} _data;
-        either_state _state;
+		using discriminant = either_discriminant<void, U>;
+
+		either_state _get_state() const noexcept {
+			return discriminant::load(std::addressof(_data));
+		}
+
+		void _set_state(either_state s) noexcept {
+			discriminant::store(std::addressof(_data), s);
+		}
 
 		using first_type = void;
 		using second_type = U;
@@ -597,11 +736,13 @@ namespace flux_foundry {
 		raw_either_storage_base &operator=(const raw_either_storage_base &) = default;
 		raw_either_storage_base &operator=(raw_either_storage_base &&) = default;
 
-		explicit raw_either_storage_base() noexcept : 
-			_state{ either_state::empty } { }
+		explicit raw_either_storage_base() noexcept {
+			_set_state(either_state::empty);
+		}
 		
-		explicit raw_either_storage_base(first_t) noexcept : 
-			_state{ either_state::first } { }
+		explicit raw_either_storage_base(first_t) noexcept {
+			_set_state(either_state::first);
+		}
 
 		template <typename U_ = U, typename... Args,
 #if FLUX_FOUNDRY_HAS_EXCEPTIONS
@@ -611,8 +752,9 @@ namespace flux_foundry {
 #endif
 >
 		explicit raw_either_storage_base(second_t, Args &&... args)
-			noexcept (std::is_nothrow_constructible<U_, Args &&...>::value) : _state{either_state::second} {
+			noexcept (std::is_nothrow_constructible<U_, Args &&...>::value) {
 			opu::construct_at(std::addressof(_data.second), std::forward<Args>(args)...);
+			_set_state(either_state::second);
 		}
 
 		template <typename U_ = U, typename F, typename... Args,
@@ -624,8 +766,9 @@ namespace flux_foundry {
 		>
 		raw_either_storage_base(second_t, std::initializer_list<F> il, Args &&... args)
 			noexcept (std::is_nothrow_constructible<U_, std::initializer_list<F>, Args &&...>::value
-			) : _state{either_state::second} {
+			) {
 			opu::construct_at(std::addressof(_data.second), il, std::forward<Args>(args)...);
+			_set_state(either_state::second);
 		}
 		template <typename U_ = U,
 #if FLUX_FOUNDRY_HAS_EXCEPTIONS
@@ -635,9 +778,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, const U &u)
-			noexcept(std::is_nothrow_copy_constructible<U>::value)
-			: _state{either_state::second} {
+			noexcept(std::is_nothrow_copy_constructible<U>::value) {
 			opu::construct_at(std::addressof(_data.second), u);
+			_set_state(either_state::second);
 		}
 
 		template <typename U_ = U,
@@ -648,16 +791,16 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, U &&u)
-			noexcept(std::is_nothrow_move_constructible<U>::value)
-			: _state{either_state::second} {
+			noexcept(std::is_nothrow_move_constructible<U>::value) {
 			opu::construct_at(std::addressof(_data.second), std::move(u));
+			_set_state(either_state::second);
 		}
 
 		~raw_either_storage_base() noexcept = default;
 	};
 
 	template <typename U>
-	struct TS_EMPTY_BASES raw_either_storage_base <void, U, false, false> {
+	struct TS_EMPTY_BASES raw_either_storage_base <void, U, false, false> : either_discriminant<void, U> {
 		static_assert(std::is_nothrow_destructible<U>::value,
 			"U must be nothrow destructible");
 		static_assert(can_strong_move_or_copy_constructible<U>::value,
@@ -670,17 +813,27 @@ namespace flux_foundry {
 			storage() noexcept {}
 			~storage() noexcept {}
 		} _data;
-		either_state _state;
+		using discriminant = either_discriminant<void, U>;
+
+		either_state _get_state() const noexcept {
+			return discriminant::load(std::addressof(_data));
+		}
+
+		void _set_state(either_state s) noexcept {
+			discriminant::store(std::addressof(_data), s);
+		}
 
 		using first_type = void;
 		using second_type = U;
 		using opu = raw_inplace_storage_operations<U>;
 		
-		explicit raw_either_storage_base() noexcept : 
-			_state{ either_state::empty } { }
+		explicit raw_either_storage_base() noexcept {
+			_set_state(either_state::empty);
+		}
 		
-		explicit raw_either_storage_base(first_t) noexcept : 
-			_state{ either_state::first } {}
+		explicit raw_either_storage_base(first_t) noexcept {
+			_set_state(either_state::first);
+		}
 
 		template <typename U_ = U, typename... Args,
 #if FLUX_FOUNDRY_HAS_EXCEPTIONS
@@ -690,8 +843,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, Args &&... args)
-			noexcept (std::is_nothrow_constructible<U_, Args &&...>::value) : _state{either_state::second} {
+			noexcept (std::is_nothrow_constructible<U_, Args &&...>::value) {
 			opu::construct_at(std::addressof(_data.second), std::forward<Args>(args)...);
+			_set_state(either_state::second);
 		}
 
 		template <typename U_ = U, typename F, typename... Args,
@@ -703,8 +857,9 @@ namespace flux_foundry {
 		>
 		raw_either_storage_base(second_t, std::initializer_list<F> il, Args &&... args)
 			noexcept (std::is_nothrow_constructible<U_, std::initializer_list<F>, Args &&...>::value
-			) : _state{either_state::second} {
+			) {
 			opu::construct_at(std::addressof(_data.second), il, std::forward<Args>(args)...);
+			_set_state(either_state::second);
 		}
 		template <typename U_ = U,
 #if FLUX_FOUNDRY_HAS_EXCEPTIONS
@@ -714,9 +869,9 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, const U &u)
-			noexcept(std::is_nothrow_copy_constructible<U>::value)
-			: _state{either_state::second} {
+			noexcept(std::is_nothrow_copy_constructible<U>::value) {
 			opu::construct_at(std::addressof(_data.second), u);
+			_set_state(either_state::second);
 		}
 
 		template <typename U_ = U,
@@ -727,13 +882,13 @@ namespace flux_foundry {
 #endif
 		>
 		explicit raw_either_storage_base(second_t, U &&u)
-			noexcept(std::is_nothrow_move_constructible<U>::value)
-			: _state{either_state::second} {
+			noexcept(std::is_nothrow_move_constructible<U>::value) {
 			opu::construct_at(std::addressof(_data.second), std::move(u));
+			_set_state(either_state::second);
 		}
 
 		~raw_either_storage_base() noexcept {
-			if (_state == either_state::second) {
+			if (_get_state() == either_state::second) {
 				opu::destroy_at(std::addressof(_data.second));
 			}
 		}
@@ -765,7 +920,7 @@ namespace flux_foundry {
 			try {
 #endif
 				opt::construct_at(std::addressof(this->_data.first), std::forward<Args>(args)...);
-				this->_state = either_state::first;
+				this->_set_state(either_state::first);
 #if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
 			} catch (...) {
 				opu::construct_at(std::addressof(this->_data.second), std::move(backup));
@@ -793,7 +948,7 @@ namespace flux_foundry {
 			try {
 #endif
 				opt::construct_at(std::addressof(this->_data.first), std::forward<Args>(args)...);
-				this->_state = either_state::first;
+				this->_set_state(either_state::first);
 #if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
 			} catch (...) {
 				opu::construct_at(std::addressof(this->_data.second), backup);
@@ -817,7 +972,7 @@ namespace flux_foundry {
 
 			opt::destroy_at(std::addressof(this->_data.first));
 			opu::construct_at(std::addressof(this->_data.second), std::move(tmp));
-			this->_state = either_state::second;
+			this->_set_state(either_state::second);
 		}
 
 		template <typename T_ = T, typename U_ = U, typename... Args,
@@ -835,7 +990,7 @@ namespace flux_foundry {
 
 			opt::destroy_at(std::addressof(this->_data.first));
 			opu::construct_at(std::addressof(this->_data.second), tmp);
-			this->_state = either_state::second;
+			this->_set_state(either_state::second);
 		}
 #else
 		template <typename T_ = T, typename ... Args,
@@ -848,7 +1003,7 @@ namespace flux_foundry {
 
 			opu::destroy_at(std::addressof(this->_data.second));
 			opt::construct_at(std::addressof(this->_data.first), std::forward<Args>(args)...);
-			this->_state = either_state::first;
+			this->_set_state(either_state::first);
 		}
 
 		template <typename U_ = U, typename... Args,
@@ -861,7 +1016,7 @@ namespace flux_foundry {
 
 			opt::destroy_at(std::addressof(this->_data.first));
 			opu::construct_at(std::addressof(this->_data.second), std::forward<Args>(args)...);
-			this->_state = either_state::second;
+			this->_set_state(either_state::second);
 		}
 #endif
 
@@ -916,7 +1071,7 @@ namespace flux_foundry {
 		}
 
 		constexpr bool has_first() const noexcept {
-			return this->_state == either_state::first;
+			return this->_get_state() == either_state::first;
 		}
 
 		constexpr T& get_first() & noexcept {
@@ -955,7 +1110,7 @@ namespace flux_foundry {
 				return;
 			}
 			opu::destroy_at(std::addressof(this->_data.second));
-			this->_state = either_state::first;
+			this->_set_state(either_state::first);
 		}
 
 		template <typename U_ = U, typename ... Args,
@@ -970,7 +1125,7 @@ namespace flux_foundry {
 			noexcept(noexcept(opu::emplace_at(static_cast<U_*>(nullptr), std::forward<Args>(args)...))) {
 			if (this->has_first()) {
 				opu::construct_at(std::addressof(this->_data.second), std::forward<Args>(args)...);
-				this->_state = either_state::second;
+				this->_set_state(either_state::second);
 				return;
 			}
 			opu::emplace_at(std::addressof(this->_data.second), std::forward<Args>(args)...);
@@ -1021,7 +1176,7 @@ namespace flux_foundry {
 		}
 
 		constexpr bool has_first() const noexcept {
-			return this->_state == either_state::first;
+			return this->_get_state() == either_state::first;
 		}
 
 		constexpr U& get_second() & noexcept {
@@ -1062,7 +1217,7 @@ namespace flux_foundry {
         	} else {
         		opu::construct_at(std::addressof(this->_data.second), rhs.get_second());
         	}
-        	this->_state = rhs._state;
+        	this->_set_state(rhs._get_state());
         }
         either_storage_copy_construct_base(either_storage_copy_construct_base &&rhs) = default;
         either_storage_copy_construct_base &operator=(const either_storage_copy_construct_base &rhs) = default;
@@ -1080,7 +1235,7 @@ namespace flux_foundry {
 			if (!rhs.has_first()) {
 				opu::construct_at(std::addressof(this->_data.second), rhs.get_second());
 			}
-			this->_state = rhs._state;
+			this->_set_state(rhs._get_state());
 		}
 		either_storage_copy_construct_base(either_storage_copy_construct_base &&rhs) = default;
 		either_storage_copy_construct_base &operator=(const either_storage_copy_construct_base &rhs) = default;
@@ -1114,7 +1269,7 @@ namespace flux_foundry {
         	} else {
         		opu::construct_at(std::addressof(this->_data.second), std::move(rhs).get_second());
         	}
-        	this->_state = rhs._state;
+        	this->_set_state(rhs._get_state());
         }
 
         either_storage_move_construct_base &operator=(const either_storage_move_construct_base &rhs) = default;
@@ -1135,7 +1290,7 @@ namespace flux_foundry {
 			if (!rhs.has_first()) {
 				opu::construct_at(std::addressof(this->_data.second), std::move(rhs).get_second());
 			}
-			this->_state = rhs._state;
+			this->_set_state(rhs._get_state());
 		}
 
 		either_storage_move_construct_base &operator=(const either_storage_move_construct_base &rhs) = default;
@@ -1325,11 +1480,11 @@ namespace flux_foundry {
 			if (rhs.has_first()) {
 				opt::construct_at(std::addressof(static_cast<base*>(this)->_data.first),
 					std::move(rhs.get_first()));
-                static_cast<base*>(this)->_state = either_state::first;
+                static_cast<base*>(this)->_set_state(either_state::first);
 			} else {
 				opu::construct_at(std::addressof(static_cast<base*>(this)->_data.second),
 					std::move(rhs.get_second()));
-                static_cast<base*>(this)->_state = either_state::second;
+                static_cast<base*>(this)->_set_state(either_state::second);
 			}
 		}
 
@@ -1350,10 +1505,10 @@ namespace flux_foundry {
 			using opu = typename base::opu;
 			if (rhs.has_first()) {
 				opt::construct_at(std::addressof(static_cast<base*>(this)->_data.first), rhs.get_first());
-                static_cast<base*>(this)->_state = either_state::first;
+                static_cast<base*>(this)->_set_state(either_state::first);
 			} else {
 				opu::construct_at(std::addressof(static_cast<base*>(this)->_data.second), rhs.get_second());
-                static_cast<base*>(this)->_state = either_state::second;
+                static_cast<base*>(this)->_set_state(either_state::second);
 			}
 		}
 
@@ -1452,7 +1607,7 @@ namespace flux_foundry {
 			} else {
 				opt::destroy_at(std::addressof(this->_data.first));
 				opu::construct_at(std::addressof(this->_data.second), std::move(u));
-				this->_state = either_state::second;
+				this->_set_state(either_state::second);
 			}
 			return *this;
 		}
@@ -1469,7 +1624,7 @@ namespace flux_foundry {
 			} else {
 				opt::destroy_at(std::addressof(this->_data.first));
 				opu::construct_at(std::addressof(this->_data.second), tmp);
-				this->_state = either_state::second;
+				this->_set_state(either_state::second);
 			}
 			return *this;
 		}
@@ -1484,7 +1639,7 @@ namespace flux_foundry {
 			} else {
 				opt::destroy_at(std::addressof(this->_data.first));
 				opu::construct_at(std::addressof(this->_data.second), u);
-				this->_state = either_state::second;
+				this->_set_state(either_state::second);
 			}
 			return *this;
 		}
@@ -1502,7 +1657,7 @@ namespace flux_foundry {
 			} else {
 				opt::destroy_at(std::addressof(this->_data.first));
 				opu::construct_at(std::addressof(this->_data.second), std::move(tmp));
-				this->_state = either_state::second;
+				this->_set_state(either_state::second);
 			}
 			return *this;
 		}
@@ -1526,11 +1681,11 @@ namespace flux_foundry {
 
 			base::opt::destroy_at(std::addressof(this->_data.first));
 			base::opu::construct_at(std::addressof(this->_data.second), std::move(rhs._data.second));
-			this->_state = either_state::second;
+			this->_set_state(either_state::second);
 
 			base::opu::destroy_at(std::addressof(rhs._data.second));
 			base::opt::construct_at(std::addressof(rhs._data.first), std::move(tmp));
-			rhs._state = either_state::first;
+			rhs._set_state(either_state::first);
 		}
 
 		void swap_one_first_another_second_impl(either_t& rhs,
@@ -1540,11 +1695,11 @@ namespace flux_foundry {
 
 			base::opt::destroy_at(std::addressof(this->_data.first));
 			base::opu::construct_at(std::addressof(this->_data.second), rhs._data.second);
-			this->_state = either_state::second;
+			this->_set_state(either_state::second);
 
 			base::opu::destroy_at(std::addressof(rhs._data.second));
 			base::opt::construct_at(std::addressof(rhs._data.first), std::move(tmp));
-			rhs._state = either_state::first;
+			rhs._set_state(either_state::first);
 		}
 
 		void swap_one_first_another_second_impl(either_t& rhs,
@@ -1554,11 +1709,11 @@ namespace flux_foundry {
 
 			base::opt::destroy_at(std::addressof(this->_data.first));
 			base::opu::construct_at(std::addressof(this->_data.second), std::move(rhs._data.second));
-			this->_state = either_state::second;
+			this->_set_state(either_state::second);
 
 			base::opu::destroy_at(std::addressof(rhs._data.second));
 			base::opt::construct_at(std::addressof(rhs._data.first), tmp);
-			rhs._state = either_state::first;
+			rhs._set_state(either_state::first);
 		}
 
 		void swap_one_first_another_second_impl(either_t& rhs,
@@ -1568,11 +1723,11 @@ namespace flux_foundry {
 
 			base::opt::destroy_at(std::addressof(this->_data.first));
 			base::opu::construct_at(std::addressof(this->_data.second), rhs._data.second);
-			this->_state = either_state::second;
+			this->_set_state(either_state::second);
 
 			base::opu::destroy_at(std::addressof(rhs._data.second));
 			base::opt::construct_at(std::addressof(rhs._data.first), tmp);
-			rhs._state = either_state::first;
+			rhs._set_state(either_state::first);
 		}
 
 		void swap_one_first_another_second(either_t& rhs) noexcept {
@@ -1661,11 +1816,11 @@ namespace flux_foundry {
 			using opu = typename base::opu;
 
 			if (rhs.has_first()) {
-                static_cast<base*>(this)->_state = either_state::first;
+                static_cast<base*>(this)->_set_state(either_state::first);
 			} else {
 				opu::construct_at(std::addressof(static_cast<base*>(this)->_data.second),
 					std::move(rhs.get_second()));
-                static_cast<base*>(this)->_state = either_state::second;
+                static_cast<base*>(this)->_set_state(either_state::second);
 			}
 		}
 
@@ -1682,10 +1837,10 @@ namespace flux_foundry {
 			noexcept(std::is_nothrow_constructible<U, const U_&>::value) {
 			using opu = typename base::opu;
 			if (rhs.has_first()) {
-                static_cast<base*>(this)->_state = either_state::first;
+                static_cast<base*>(this)->_set_state(either_state::first);
 			} else {
 				opu::construct_at(std::addressof(static_cast<base*>(this)->_data.second), rhs.get_second());
-                static_cast<base*>(this)->_state = either_state::second;
+                static_cast<base*>(this)->_set_state(either_state::second);
 			}
 		}
 
@@ -1739,7 +1894,7 @@ namespace flux_foundry {
 				opu::emplace_at(std::addressof(this->_data.second), std::move(u));
 			} else {
 				opu::construct_at(std::addressof(this->_data.second), std::move(u));
-				this->_state = either_state::second;
+				this->_set_state(either_state::second);
 			}
 			return *this;
 		}
@@ -1751,7 +1906,7 @@ namespace flux_foundry {
 				opu::emplace_at(std::addressof(this->_data.second), u);
 			} else {
 				opu::construct_at(std::addressof(this->_data.second), u);
-				this->_state = either_state::second;
+				this->_set_state(either_state::second);
 			}
 			return *this;
 		}
@@ -1763,20 +1918,20 @@ namespace flux_foundry {
 			using std::swap;
 
 			base::opu::construct_at(std::addressof(this->_data.second), std::move(rhs._data.second));
-			this->_state = either_state::second;
+			this->_set_state(either_state::second);
 
 			base::opu::destroy_at(std::addressof(rhs._data.second));
-			rhs._state = either_state::first;
+			rhs._set_state(either_state::first);
 		}
 
 		void swap_one_first_another_second_impl(either_t& rhs, u_is_nothrow_copy_constructible) noexcept {
 			using std::swap;
 
 			base::opu::construct_at(std::addressof(this->_data.second), rhs._data.second);
-			this->_state = either_state::second;
+			this->_set_state(either_state::second);
 
 			base::opu::destroy_at(std::addressof(rhs._data.second));
-			rhs._state = either_state::first;
+			rhs._set_state(either_state::first);
 		}
 
 		void swap_one_first_another_second(either_t& rhs) noexcept {
@@ -1837,6 +1992,12 @@ namespace flux_foundry {
 	constexpr bool operator!=(const either_t<T_, U_>& lhs, const either_t<T_, U_>& rhs) noexcept {
 		return !(lhs == rhs);
 	}
+
+	// the discriminant is plain bytes, whichever alternative is held decides.
+	template <typename T, typename U>
+	struct is_trivially_relocatable<either_t<T, U>>
+		: conjunction<disjunction<std::is_void<T>, is_trivially_relocatable<T>>, is_trivially_relocatable<U>> {
+	};
 }
 
 #endif
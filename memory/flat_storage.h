@@ -313,6 +313,10 @@ namespace flux_foundry {
     template <typename T>
     constexpr static bool is_compressed_pair_v = is_compressed_pair<T>::value;
 
+    template <typename T, typename U>
+    struct is_trivially_relocatable<compressed_pair<T, U>>
+        : conjunction<is_trivially_relocatable<T>, is_trivially_relocatable<U>> { };
+
     namespace detail {
         // actually this is a simpler impl of std::tuple, I implemented this because std::tuple on MSVC is like
         // tuple<A, B, C> : public tuple<B, C>
@@ -468,6 +472,9 @@ namespace flux_foundry {
 
     template <typename T>
     constexpr static bool is_flat_storage_v = is_flat_storage<T>::value;
+
+    template <typename ... Ts>
+    struct is_trivially_relocatable<flat_storage<Ts...>> : conjunction<is_trivially_relocatable<Ts>...> { };
 }
 
 #endif
@@ -3,12 +3,12 @@
 
 #include <atomic>
 #include <thread>
-#include <vector>
 #include <stdexcept>
 #include <cstdlib>
 
 #include "../base/traits.h"
 #include "../memory/flat_storage.h"
+#include "../memory/small_vector.h"
 #include "../utility/callable_wrapper.h"
 #include "../utility/back_off.h"
 
@@ -55,10 +55,10 @@ private:
         }
     };
 
+    // a sweep runs every RETIRE_BATCH / 2 retirements, so the records normally stay inline.
     struct retire_list {
         retire_list* next{nullptr};
-        std::vector<retire_record> retired;
-        retire_list() { retired.reserve(RETIRE_BATCH); }
+        small_vector<retire_record, RETIRE_BATCH> retired;
     };
 
 public:
@@ -228,12 +228,7 @@ public:
         if (!is_hazard(p)) {
             deleter(p);
         } else {
-            auto& vec = owner.list->retired;
-            if (vec.size() == vec.capacity()) {
-                size_t new_cap = vec.capacity() == 0 ? RETIRE_BATCH : vec.capacity() * 2;
-                vec.reserve(new_cap);
-            }
-            vec.emplace_back(p, [deleter = std::move(deleter)](void* _p) noexcept {
+            owner.list->retired.emplace_back(p, [deleter = std::move(deleter)](void* _p) noexcept {
                 deleter(static_cast<T*>(_p));
             });
         }
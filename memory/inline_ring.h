@@ -0,0 +1,273 @@
+#ifndef FLUX_FOUNDRY_INLINE_RING_H
+#define FLUX_FOUNDRY_INLINE_RING_H
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#include "../base/traits.h"
+#include "pooling.h"
+
+namespace flux_foundry {
+    // inline_ring<T, N>: single-threaded FIFO that keeps up to N elements inline.
+    // past N it moves to a block from flux_foundry_block_allocator, doubling the capacity and
+    // laying the elements out again from index 0. capacities stay powers of two, so indexing is a mask.
+    //
+    // same contract as small_vector: T is nothrow movable, reserve() returns false on an allocation
+    // failure, push_back/emplace_back throw std::bad_alloc on it (abort without exceptions).
+    // use mpsc_queue / mpmc_queue for hand-offs between threads.
+    template <typename T, size_t N>
+    class inline_ring {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "N must be 2^n.");
+        static_assert(conjunction_v<std::is_nothrow_move_constructible<T>, std::is_nothrow_destructible<T>>,
+            "T should be nothrow move constructible and nothrow destructible.");
+
+        using allocator_t = flux_foundry_block_allocator<alignof(T)>;
+
+        T* data_;
+        size_t head_;
+        size_t size_;
+        size_t cap_;
+        alignas(T) unsigned char inline_[N * sizeof(T)];
+
+        T* inline_data() noexcept {
+            return reinterpret_cast<T*>(inline_);
+        }
+
+        bool on_heap() const noexcept {
+            return cap_ != N;
+        }
+
+        size_t slot(size_t i) const noexcept {
+            return (head_ + i) & (cap_ - 1);
+        }
+
+        void release() noexcept {
+            if (on_heap()) {
+                allocator_t().dealloc(data_, cap_ * sizeof(T));
+                data_ = inline_data();
+                cap_ = N;
+            }
+        }
+
+        void move_from(inline_ring& rhs) noexcept {
+            if (rhs.on_heap()) {
+                data_ = rhs.data_;
+                head_ = rhs.head_;
+                size_ = rhs.size_;
+                cap_ = rhs.cap_;
+                rhs.data_ = rhs.inline_data();
+                rhs.head_ = 0;
+                rhs.size_ = 0;
+                rhs.cap_ = N;
+                return;
+            }
+
+            for (size_t i = 0; i < rhs.size_; ++i) {
+                ::new (data_ + i) T(std::move(rhs[i]));
+            }
+            size_ = rhs.size_;
+            rhs.clear();
+        }
+
+        // moves the elements to [0, size_) of p.
+        void adopt(T* p, size_t new_cap) noexcept {
+            for (size_t i = 0; i < size_; ++i) {
+                T& v = data_[slot(i)];
+                ::new (p + i) T(std::move(v));
+                v.~T();
+            }
+            release();
+            data_ = p;
+            head_ = 0;
+            cap_ = new_cap;
+        }
+
+        static void alloc_failed() {
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+            throw std::bad_alloc();
+#else
+            assert(false && "out of memory");
+            std::abort();
+#endif
+        }
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        static constexpr size_t inline_capacity = N;
+
+        inline_ring() noexcept
+            : data_(inline_data()), head_(0), size_(0), cap_(N) {
+        }
+
+        inline_ring(const inline_ring& rhs)
+            : inline_ring() {
+            UNLIKELY_IF (!reserve(rhs.size_)) {
+                alloc_failed();
+            }
+            for (size_t i = 0; i < rhs.size_; ++i) {
+                emplace_back(rhs[i]);
+            }
+        }
+
+        inline_ring(inline_ring&& rhs) noexcept
+            : inline_ring() {
+            move_from(rhs);
+        }
+
+        inline_ring& operator=(const inline_ring& rhs) {
+            if (this != &rhs) {
+                inline_ring tmp(rhs);
+                *this = std::move(tmp);
+            }
+            return *this;
+        }
+
+        inline_ring& operator=(inline_ring&& rhs) noexcept {
+            if (this != &rhs) {
+                clear();
+                release();
+                move_from(rhs);
+            }
+            return *this;
+        }
+
+        ~inline_ring() noexcept {
+            clear();
+            release();
+        }
+
+        size_t size() const noexcept {
+            return size_;
+        }
+
+        size_t capacity() const noexcept {
+            return cap_;
+        }
+
+        bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        bool is_inline() const noexcept {
+            return !on_heap();
+        }
+
+        // i-th element from the front.
+        T& operator[](size_t i) noexcept {
+            assert(i < size_);
+            return data_[slot(i)];
+        }
+
+        const T& operator[](size_t i) const noexcept {
+            assert(i < size_);
+            return data_[slot(i)];
+        }
+
+        T& front() noexcept {
+            return (*this)[0];
+        }
+
+        T& back() noexcept {
+            return (*this)[size_ - 1];
+        }
+
+        const T& front() const noexcept {
+            return (*this)[0];
+        }
+
+        const T& back() const noexcept {
+            return (*this)[size_ - 1];
+        }
+
+        // returns false when the block cannot be allocated, the ring is left unchanged.
+        bool reserve(size_t n) noexcept {
+            LIKELY_IF (n <= cap_) {
+                return true;
+            }
+
+            size_t new_cap = cap_;
+            while (new_cap < n) {
+                new_cap <<= 1;
+            }
+            auto p = static_cast<T*>(allocator_t().alloc(new_cap * sizeof(T)));
+            UNLIKELY_IF (!p) {
+                return false;
+            }
+            adopt(p, new_cap);
+            return true;
+        }
+
+        template <typename ... Args,
+            std::enable_if_t<
+#if FLUX_FOUNDRY_HAS_EXCEPTIONS
+                std::is_constructible<T, Args&&...>::value
+#else
+                std::is_nothrow_constructible<T, Args&&...>::value
+#endif
+            >* = nullptr>
+        T& emplace_back(Args&& ... args) {
+            LIKELY_IF (size_ < cap_) {
+                T* p = ::new (data_ + slot(size_)) T(std::forward<Args>(args)...);
+                ++size_;
+                return *p;
+            }
+
+            // args may refer into this ring, build the new element before moving the old ones.
+            const size_t new_cap = cap_ << 1;
+            auto block = static_cast<T*>(allocator_t().alloc(new_cap * sizeof(T)));
+            UNLIKELY_IF (!block) {
+                alloc_failed();
+            }
+
+            struct guard {
+                T* p;
+                size_t n;
+                ~guard() noexcept {
+                    allocator_t().dealloc(p, n);
+                }
+            };
+
+            guard g{block, new_cap * sizeof(T)};
+            ::new (block + size_) T(std::forward<Args>(args)...);
+            g.p = nullptr;
+
+            adopt(block, new_cap);
+            return data_[size_++];
+        }
+
+        void push_back(const T& v) {
+            emplace_back(v);
+        }
+
+        void push_back(T&& v) {
+            emplace_back(std::move(v));
+        }
+
+        void pop_front() noexcept {
+            assert(size_ > 0);
+            data_[head_].~T();
+            head_ = (head_ + 1) & (cap_ - 1);
+            --size_;
+        }
+
+        // moves the front element out and pops it.
+        T take_front() noexcept {
+            T v(std::move(front()));
+            pop_front();
+            return v;
+        }
+
+        // keeps the capacity.
+        void clear() noexcept {
+            while (size_) {
+                pop_front();
+            }
+            head_ = 0;
+        }
+    };
+}
+
+#endif // FLUX_FOUNDRY_INLINE_RING_H
@@ -343,6 +343,10 @@ namespace flux_foundry {
 
     template <typename R>
     constexpr bool is_lite_ptr_v = is_lite_ptr<R>::value;
+
+    // a lite_ptr is a single pointer to its control block, moving its bytes moves the ownership.
+    template <typename T, typename F, size_t align, typename A>
+    struct is_trivially_relocatable<lite_ptr<T, F, align, A>> : std::true_type { };
 }
 
 #endif //LF_LITE_PTR
@@ -152,6 +152,56 @@ namespace flux_foundry {
         }
     };
 
+    namespace detail {
+        template <size_t align, size_t block = (pool_max_block_size >> 3), bool = (block <= pool_max_block_size)>
+        struct block_size_class {
+            static void* alloc(size_t n) noexcept {
+                LIKELY_IF (n <= block) {
+                    return flux_foundry_allocator<block, align>().alloc();
+                }
+                return block_size_class<align, (block << 1)>::alloc(n);
+            }
+
+            static void dealloc(void* p, size_t n) noexcept {
+                LIKELY_IF (n <= block) {
+                    flux_foundry_allocator<block, align>().dealloc(p);
+                    return;
+                }
+                block_size_class<align, (block << 1)>::dealloc(p, n);
+            }
+        };
+
+        template <size_t align, size_t block>
+        struct block_size_class<align, block, false> {
+            static constexpr size_t heap_align = align < alignof(void*) ? alignof(void*) : align;
+
+            static void* alloc(size_t n) noexcept {
+                return aligned_alloc(heap_align, alloc_size(n, heap_align));
+            }
+
+            static void dealloc(void* p, size_t) noexcept {
+                aligned_free(p);
+            }
+        };
+    }
+
+    // runtime-sized blocks for growable containers (small_vector, inline_ring).
+    // a request is rounded up to the next pool block size and served like flux_foundry_allocator<block, align>,
+    // larger ones go to aligned_alloc. dealloc must be given the size passed to alloc.
+    template <size_t align>
+    struct flux_foundry_block_allocator {
+        void* alloc(size_t n) noexcept {
+            return detail::block_size_class<align>::alloc(n);
+        }
+
+        void dealloc(void* p, size_t n) noexcept {
+            UNLIKELY_IF (!p) {
+                return;
+            }
+            detail::block_size_class<align>::dealloc(p, n);
+        }
+    };
+
     // this pool only serves exact-type element_t allocations, no base/derived polymorphic allocations.
     // best-effort TLS cache; cross-thread frees may reduce locality and cause memory drift.
     template <typename element_t, size_t cache_cap = 128>
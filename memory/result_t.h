@@ -117,6 +117,15 @@ namespace flux_foundry {
     template <typename T>
     constexpr bool is_error_t_v = is_error_t<T>::value;
 
+    // error_t<E> holds nothing but an E, so it has the niche of E (see either_niche).
+    template <typename E>
+    struct either_niche<error_t<E>> : either_niche<E> {
+    };
+
+    template <typename E>
+    struct is_trivially_relocatable<error_t<E>> : is_trivially_relocatable<E> {
+    };
+
     constexpr static in_place_index<0> value_tag{};
     constexpr static in_place_index<1> error_tag{};
 
@@ -399,6 +408,9 @@ namespace flux_foundry {
     template <typename R>
     constexpr bool is_result_t_v = is_result_t<R>::value;
 
+    template <typename T, typename E>
+    struct is_trivially_relocatable<result_t<T, E>> : is_trivially_relocatable<either_t<T, error_t<E>>> {};
+
     template <typename T, class E>
     void swap(result_t<T,E>& a, result_t<T,E>& b)
         noexcept(noexcept(std::declval<result_t<T, E>&>().swap(std::declval<result_t<T, E>&>()))) {
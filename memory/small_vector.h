@@ -0,0 +1,307 @@
+#ifndef FLUX_FOUNDRY_SMALL_VECTOR_H
+#define FLUX_FOUNDRY_SMALL_VECTOR_H
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#include "../base/traits.h"
+#include "pooling.h"
+
+namespace flux_foundry {
+    // small_vector<T, N>: contiguous sequence that keeps up to N elements inline.
+    // past N it moves to a block from flux_foundry_block_allocator, doubling the capacity on every growth.
+    //
+    // - T must be nothrow move constructible, so growing and moving the vector never throw.
+    // - reserve() reports an allocation failure by returning false. push_back/emplace_back throw
+    //   std::bad_alloc on it, or abort when the compiler has no exceptions; call reserve() first to recover.
+    // - with FLUX_FOUNDRY_HAS_EXCEPTIONS == 0 only nothrow constructions are accepted, like the rest of the library.
+    template <typename T, size_t N>
+    class small_vector {
+        static_assert(N > 0, "N must be greater than 0");
+        static_assert(conjunction_v<std::is_nothrow_move_constructible<T>, std::is_nothrow_destructible<T>>,
+            "T should be nothrow move constructible and nothrow destructible.");
+
+        using allocator_t = flux_foundry_block_allocator<alignof(T)>;
+
+        T* data_;
+        size_t size_;
+        size_t cap_;
+        alignas(T) unsigned char inline_[N * sizeof(T)];
+
+        T* inline_data() noexcept {
+            return reinterpret_cast<T*>(inline_);
+        }
+
+        bool on_heap() const noexcept {
+            return cap_ != N;
+        }
+
+        void release() noexcept {
+            if (on_heap()) {
+                allocator_t().dealloc(data_, cap_ * sizeof(T));
+                data_ = inline_data();
+                cap_ = N;
+            }
+        }
+
+        void move_from(small_vector& rhs) noexcept {
+            if (rhs.on_heap()) {
+                data_ = rhs.data_;
+                size_ = rhs.size_;
+                cap_ = rhs.cap_;
+                rhs.data_ = rhs.inline_data();
+                rhs.size_ = 0;
+                rhs.cap_ = N;
+                return;
+            }
+
+            for (size_t i = 0; i < rhs.size_; ++i) {
+                ::new (data_ + i) T(std::move(rhs.data_[i]));
+            }
+            size_ = rhs.size_;
+            rhs.clear();
+        }
+
+        size_t next_capacity(size_t n) const noexcept {
+            size_t cap = cap_;
+            while (cap < n) {
+                cap <<= 1;
+            }
+            return cap;
+        }
+
+        // moves the elements into a block of new_cap, keeps the old buffer if the allocation fails.
+        bool grow(size_t new_cap) noexcept {
+            auto p = static_cast<T*>(allocator_t().alloc(new_cap * sizeof(T)));
+            UNLIKELY_IF (!p) {
+                return false;
+            }
+            adopt(p, new_cap);
+            return true;
+        }
+
+        void adopt(T* p, size_t new_cap) noexcept {
+            for (size_t i = 0; i < size_; ++i) {
+                ::new (p + i) T(std::move(data_[i]));
+                data_[i].~T();
+            }
+            release();
+            data_ = p;
+            cap_ = new_cap;
+        }
+
+        static void alloc_failed() {
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+            throw std::bad_alloc();
+#else
+            assert(false && "out of memory");
+            std::abort();
+#endif
+        }
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using iterator = T*;
+        using const_iterator = const T*;
+        static constexpr size_t inline_capacity = N;
+
+        small_vector() noexcept
+            : data_(inline_data()), size_(0), cap_(N) {
+        }
+
+        small_vector(const small_vector& rhs)
+            : small_vector() {
+            UNLIKELY_IF (!reserve(rhs.size_)) {
+                alloc_failed();
+            }
+            for (const auto& v : rhs) {
+                emplace_back(v);
+            }
+        }
+
+        small_vector(small_vector&& rhs) noexcept
+            : small_vector() {
+            move_from(rhs);
+        }
+
+        small_vector& operator=(const small_vector& rhs) {
+            if (this != &rhs) {
+                small_vector tmp(rhs);
+                *this = std::move(tmp);
+            }
+            return *this;
+        }
+
+        small_vector& operator=(small_vector&& rhs) noexcept {
+            if (this != &rhs) {
+                clear();
+                release();
+                move_from(rhs);
+            }
+            return *this;
+        }
+
+        ~small_vector() noexcept {
+            clear();
+            release();
+        }
+
+        size_t size() const noexcept {
+            return size_;
+        }
+
+        size_t capacity() const noexcept {
+            return cap_;
+        }
+
+        bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        // true while the elements live in the inline buffer.
+        bool is_inline() const noexcept {
+            return !on_heap();
+        }
+
+        T* data() noexcept {
+            return data_;
+        }
+
+        const T* data() const noexcept {
+            return data_;
+        }
+
+        iterator begin() noexcept {
+            return data_;
+        }
+
+        iterator end() noexcept {
+            return data_ + size_;
+        }
+
+        const_iterator begin() const noexcept {
+            return data_;
+        }
+
+        const_iterator end() const noexcept {
+            return data_ + size_;
+        }
+
+        T& operator[](size_t i) noexcept {
+            assert(i < size_);
+            return data_[i];
+        }
+
+        const T& operator[](size_t i) const noexcept {
+            assert(i < size_);
+            return data_[i];
+        }
+
+        T& front() noexcept {
+            return (*this)[0];
+        }
+
+        T& back() noexcept {
+            return (*this)[size_ - 1];
+        }
+
+        const T& front() const noexcept {
+            return (*this)[0];
+        }
+
+        const T& back() const noexcept {
+            return (*this)[size_ - 1];
+        }
+
+        // returns false when the block cannot be allocated, the vector is left unchanged.
+        bool reserve(size_t n) noexcept {
+            LIKELY_IF (n <= cap_) {
+                return true;
+            }
+            return grow(next_capacity(n));
+        }
+
+        template <typename ... Args,
+            std::enable_if_t<
+#if FLUX_FOUNDRY_HAS_EXCEPTIONS
+                std::is_constructible<T, Args&&...>::value
+#else
+                std::is_nothrow_constructible<T, Args&&...>::value
+#endif
+            >* = nullptr>
+        T& emplace_back(Args&& ... args) {
+            LIKELY_IF (size_ < cap_) {
+                T* p = ::new (data_ + size_) T(std::forward<Args>(args)...);
+                ++size_;
+                return *p;
+            }
+
+            // args may refer into this vector, build the new element before moving the old ones.
+            const size_t new_cap = cap_ << 1;
+            auto block = static_cast<T*>(allocator_t().alloc(new_cap * sizeof(T)));
+            UNLIKELY_IF (!block) {
+                alloc_failed();
+            }
+
+            struct guard {
+                T* p;
+                size_t n;
+                ~guard() noexcept {
+                    allocator_t().dealloc(p, n);
+                }
+            };
+
+            guard g{block, new_cap * sizeof(T)};
+            ::new (block + size_) T(std::forward<Args>(args)...);
+            g.p = nullptr;
+
+            adopt(block, new_cap);
+            return data_[size_++];
+        }
+
+        void push_back(const T& v) {
+            emplace_back(v);
+        }
+
+        void push_back(T&& v) {
+            emplace_back(std::move(v));
+        }
+
+        void pop_back() noexcept {
+            assert(size_ > 0);
+            data_[--size_].~T();
+        }
+
+        // growing requires a default constructible T.
+        void resize(size_t n) {
+            while (size_ > n) {
+                pop_back();
+            }
+            UNLIKELY_IF (!reserve(n)) {
+                alloc_failed();
+            }
+            while (size_ < n) {
+                emplace_back();
+            }
+        }
+
+        // keeps the capacity, like std::vector::clear.
+        void clear() noexcept {
+            while (size_) {
+                data_[--size_].~T();
+            }
+        }
+
+        // returns the heap block once the elements fit inline again.
+        void shrink_to_fit() noexcept {
+            UNLIKELY_IF (on_heap() && size_ <= N) {
+                adopt(inline_data(), N);
+            }
+        }
+    };
+}
+
+#endif // FLUX_FOUNDRY_SMALL_VECTOR_H
@@ -1,9 +1,9 @@
 #ifndef FLUX_FOUNDRY_FUTURE_TASK_H
 #define FLUX_FOUNDRY_FUTURE_TASK_H
 
-#include <future>
 #include <atomic>
 #include "../base/traits.h"
+#include "lite_future.h"
 #include "task_core.h"
 
 namespace flux_foundry {
@@ -12,59 +12,30 @@ namespace future_task_detail {
     template <typename Callable, typename... Params>
     class future_task_impl : task<std::decay_t<Callable>, std::decay_t<Params>...> {
         using base = task<std::decay_t<Callable>, std::decay_t<Params>...>;
+        using future_result_t = typename base::result_type;
+        using promise_t = lite_promise<typename future_result_t::value_type, typename future_result_t::error_type>;
 
         base& _as_base() noexcept {
             return static_cast<base&>(*this);
         }
 
-        void run(std::false_type, std::false_type) noexcept {
-            auto result = _as_base()();
-            if (result.has_value()) {
-                promise_.set_value(std::move(result.value()));
-            } 
-#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
-              else {
-                promise_.set_exception(result.error());
-            }
-#endif
-        }
-
-        void run(std::true_type, std::false_type) noexcept {
-            auto result = _as_base()();
-            if (result.has_value()) {
-                promise_.set_value();
-            }
-#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
-              else {
-                promise_.set_exception(result.error());
-            }
-#endif
-        }
-
-        void run(std::false_type, std::true_type) noexcept {
-            promise_.set_value(_as_base()());
-        }
-
     public:
         using base::base;
         using result_type = typename base::callable_result_t;
+        using future_type = lite_future<typename future_result_t::value_type, typename future_result_t::error_type>;
 
         future_task_impl() = delete;
 
         future_task_impl(const future_task_impl&) = delete;
         future_task_impl& operator=(const future_task_impl&) = delete;
 
-        future_task_impl(future_task_impl&& other) noexcept(conjunction_v<
-            std::is_nothrow_move_constructible<base>,
-            std::is_nothrow_move_constructible<std::promise<result_type>>>)
+        future_task_impl(future_task_impl&& other) noexcept(std::is_nothrow_move_constructible<base>::value)
             : base(std::move(static_cast<base&>(other)))
             , promise_(std::move(other.promise_))
             , fired_(other.fired_.load(std::memory_order_relaxed)) {
         }
 
-        future_task_impl& operator=(future_task_impl&& other) 
-            noexcept(conjunction_v<std::is_nothrow_move_assignable<base>,
-                    std::is_nothrow_move_assignable<std::promise<result_type>>>) {
+        future_task_impl& operator=(future_task_impl&& other) noexcept(std::is_nothrow_move_assignable<base>::value) {
             if (this != &other) {
                 static_cast<base&>(*this) = std::move(static_cast<base&>(other));
                 promise_ = std::move(other.promise_);
@@ -73,7 +44,9 @@ namespace future_task_detail {
             return *this;
         }
 
-        std::future<result_type> get_future() {
+        // the future holds the task's uniform result, i.e. result_t<R, std::exception_ptr>,
+        // or R itself when the callable already returns a result_t.
+        future_type get_future() noexcept {
             return this->promise_.get_future();
         }
 
@@ -82,11 +55,11 @@ namespace future_task_detail {
             if (fired_.exchange(true, std::memory_order_relaxed)) {
                 return;
             }
-            this->run(std::is_void<result_type> {}, is_result_t<result_type>{});
+            promise_.set_result(_as_base()());
         }
 
     private:
-        std::promise<result_type> promise_;
+        promise_t promise_;
         std::atomic<bool> fired_ { false };
     };
 }
@@ -117,6 +90,7 @@ class future_task :
 public:
     using impl::impl;
     using result_type = typename impl::result_type;
+    using future_type = typename impl::future_type;
 };
 
 template <typename Callable, typename... Args>
@@ -0,0 +1,353 @@
+#ifndef FLUX_FOUNDRY_LITE_FUTURE_H
+#define FLUX_FOUNDRY_LITE_FUTURE_H
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+#include "../base/inplace_base.h"
+#include "../base/traits.h"
+#include "../memory/pooling.h"
+#include "../memory/result_t.h"
+#include "../utility/park.h"
+#include "task_wrapper.h"
+
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+#include <future>
+#endif
+
+namespace flux_foundry {
+    // the error a future observes when its promise is dropped without a result.
+    // specialize it for your error type, the default is a value-initialized E.
+    template <typename E>
+    struct broken_promise_error {
+        static E make() noexcept {
+            return E();
+        }
+    };
+
+    template <>
+    struct broken_promise_error<std::exception_ptr> {
+        static std::exception_ptr make() noexcept {
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+            return std::make_exception_ptr(std::future_error(std::future_errc::broken_promise));
+#else
+            return nullptr;
+#endif
+        }
+    };
+
+namespace lite_future_detail {
+    enum state_bits : std::uint32_t {
+        ready = 1,          // the result is published
+        waiters = 2,        // a thread parks (or is about to park) on the word
+        continuation = 4,   // then() stored a continuation
+        retrieved = 8,      // get_future() was called
+    };
+
+    // the whole shared state is one pooled block: the state word, the reference count,
+    // the result and the continuation slot.
+    template <typename T, typename E>
+    class shared_state final : public pooling_base<shared_state<T, E>> {
+    public:
+        using result_type = result_t<T, E>;
+        static_assert(conjunction_v<std::is_nothrow_move_constructible<result_type>,
+            std::is_nothrow_destructible<result_type>>,
+            "result_t<T, E> should be nothrow move constructible and nothrow destructible.");
+
+        std::atomic<std::uint32_t> word { 0 };
+        std::atomic<std::uint32_t> refs { 1 };
+        raw_inplace_storage_base<result_type> result;
+        task_wrapper_sbo cont;
+
+        shared_state() noexcept = default;
+
+        shared_state(const shared_state&) = delete;
+        shared_state& operator=(const shared_state&) = delete;
+
+        ~shared_state() noexcept {
+            if (word.load(std::memory_order_relaxed) & ready) {
+                result.destroy();
+            }
+        }
+
+        void retain() noexcept {
+            refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void release() noexcept {
+            if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+
+        bool is_ready() const noexcept {
+            return word.load(std::memory_order_acquire) & ready;
+        }
+
+        // the producer side, called once.
+        void publish(result_type&& r) noexcept {
+            assert(!(word.load(std::memory_order_relaxed) & ready) && "the result is already set");
+            result.construct(std::move(r));
+            const std::uint32_t prev = word.fetch_or(ready, std::memory_order_acq_rel);
+            UNLIKELY_IF (prev & waiters) {
+                unpark_all(word);
+            }
+            if (prev & continuation) {
+                fire();
+            }
+        }
+
+        // whoever of publish() and attach() comes second runs the continuation.
+        void attach(task_wrapper_sbo&& t) noexcept {
+            cont = std::move(t);
+            if (word.fetch_or(continuation, std::memory_order_acq_rel) & ready) {
+                fire();
+            }
+        }
+
+        void fire() noexcept {
+            task_wrapper_sbo t(std::move(cont));
+            t();
+        }
+
+        bool spin() const noexcept {
+            return spin_until([this]() noexcept { return is_ready(); });
+        }
+
+        void wait() noexcept {
+            if (spin()) {
+                return;
+            }
+
+            std::uint32_t w = word.fetch_or(waiters, std::memory_order_acq_rel) | waiters;
+            while (!(w & ready)) {
+                park_on(word, w);
+                w = word.load(std::memory_order_acquire);
+            }
+        }
+
+        template <typename Clock, typename Duration>
+        bool wait_until(const std::chrono::time_point<Clock, Duration>& deadline) noexcept {
+            if (spin()) {
+                return true;
+            }
+
+            std::uint32_t w = word.fetch_or(waiters, std::memory_order_acq_rel) | waiters;
+            while (!(w & ready)) {
+                const auto now = Clock::now();
+                if (now >= deadline) {
+                    return false;
+                }
+                park_on_for(word, w, deadline - now);
+                w = word.load(std::memory_order_acquire);
+            }
+            return true;
+        }
+    };
+}
+
+    template <typename T, typename E>
+    class lite_promise;
+
+    // lite_future<T, E>: the consumer half of a one-shot result handed across threads,
+    // a lighter std::future. the result is a result_t<T, E>, so errors are values.
+    //
+    // - wait()/get() spin briefly and then park on the state word (a futex on Linux).
+    //   a producer only makes a syscall when a consumer is actually parked.
+    // - get() moves the result out and leaves the future invalid, like std::future::get.
+    // - then(executor, f) consumes the future instead: f(result_t<T, E>&&) is dispatched to the
+    //   executor once the result is published, and never runs on the producing thread.
+    // - a future is not shared, only one thread may use it at a time.
+    template <typename T, typename E = std::exception_ptr>
+    class lite_future {
+        using state_t = lite_future_detail::shared_state<T, E>;
+
+        state_t* state_;
+
+        explicit lite_future(state_t* s) noexcept
+            : state_(s) {
+        }
+
+        void reset() noexcept {
+            if (state_) {
+                state_->release();
+                state_ = nullptr;
+            }
+        }
+
+        template <typename, typename>
+        friend class lite_promise;
+
+    public:
+        using value_type = T;
+        using error_type = E;
+        using result_type = result_t<T, E>;
+
+        lite_future() noexcept
+            : state_(nullptr) {
+        }
+
+        lite_future(const lite_future&) = delete;
+        lite_future& operator=(const lite_future&) = delete;
+
+        lite_future(lite_future&& rhs) noexcept
+            : state_(rhs.state_) {
+            rhs.state_ = nullptr;
+        }
+
+        lite_future& operator=(lite_future&& rhs) noexcept {
+            if (this != &rhs) {
+                reset();
+                state_ = rhs.state_;
+                rhs.state_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~lite_future() noexcept {
+            reset();
+        }
+
+        bool valid() const noexcept {
+            return state_ != nullptr;
+        }
+
+        // does not block.
+        bool ready() const noexcept {
+            assert(valid());
+            return state_->is_ready();
+        }
+
+        void wait() const noexcept {
+            assert(valid());
+            state_->wait();
+        }
+
+        // returns false on timeout.
+        template <typename Rep, typename Period>
+        bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const noexcept {
+            return wait_until(std::chrono::steady_clock::now() + timeout);
+        }
+
+        template <typename Clock, typename Duration>
+        bool wait_until(const std::chrono::time_point<Clock, Duration>& deadline) const noexcept {
+            assert(valid());
+            return state_->wait_until(deadline);
+        }
+
+        result_type get() noexcept {
+            assert(valid());
+            state_->wait();
+            result_type r(std::move(*state_->result.ptr()));
+            reset();
+            return r;
+        }
+
+        // Executor is a pointer-like handle whose dispatch() takes a task_wrapper_sbo.
+        // F is void(result_type&&) noexcept.
+        template <typename Executor, typename F>
+        void then(Executor executor, F&& f) && {
+            assert(valid());
+            state_t* s = state_;
+            s->attach(task_wrapper_sbo([executor, f = std::forward<F>(f), self = std::move(*this)]() mutable noexcept {
+                executor->dispatch(task_wrapper_sbo([f = std::move(f), self = std::move(self)]() mutable noexcept {
+                    f(self.get());
+                }));
+            }));
+        }
+    };
+
+    // lite_promise<T, E>: the producer half. it allocates the shared state from the pooling allocator.
+    //
+    // - set_value/set_error/set_result publish the result once, and never block.
+    // - a promise dropped without a result publishes broken_promise_error<E>::make().
+    // - get_future() may be called once.
+    // - lite_promise(nullptr) holds no state and allocates nothing, until a promise is moved into it.
+    template <typename T, typename E = std::exception_ptr>
+    class lite_promise {
+        using state_t = lite_future_detail::shared_state<T, E>;
+
+        state_t* state_;
+
+        void abandon() noexcept {
+            if (!state_) {
+                return;
+            }
+            if (!(state_->word.load(std::memory_order_relaxed) & lite_future_detail::ready)) {
+                state_->publish(result_type(error_tag, broken_promise_error<E>::make()));
+            }
+            state_->release();
+            state_ = nullptr;
+        }
+
+    public:
+        using value_type = T;
+        using error_type = E;
+        using result_type = result_t<T, E>;
+
+        lite_promise()
+#if !FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+            noexcept
+#endif
+            : state_(new state_t()) {
+        }
+
+        explicit lite_promise(std::nullptr_t) noexcept
+            : state_(nullptr) {
+        }
+
+        lite_promise(const lite_promise&) = delete;
+        lite_promise& operator=(const lite_promise&) = delete;
+
+        lite_promise(lite_promise&& rhs) noexcept
+            : state_(rhs.state_) {
+            rhs.state_ = nullptr;
+        }
+
+        lite_promise& operator=(lite_promise&& rhs) noexcept {
+            if (this != &rhs) {
+                abandon();
+                state_ = rhs.state_;
+                rhs.state_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~lite_promise() noexcept {
+            abandon();
+        }
+
+        lite_future<T, E> get_future() noexcept {
+            assert(state_);
+            const std::uint32_t prev = state_->word.fetch_or(lite_future_detail::retrieved, std::memory_order_relaxed);
+            (void)prev;
+            assert(!(prev & lite_future_detail::retrieved) && "get_future() called twice");
+            state_->retain();
+            return lite_future<T, E>(state_);
+        }
+
+        void set_result(result_type&& r) noexcept {
+            assert(state_);
+            state_->publish(std::move(r));
+        }
+
+        template <typename ... Args>
+        void set_value(Args&& ... args)
+            noexcept(std::is_nothrow_constructible<result_type, in_place_index<0>, Args&&...>::value) {
+            set_result(result_type(value_tag, std::forward<Args>(args)...));
+        }
+
+        template <typename ... Args>
+        void set_error(Args&& ... args)
+            noexcept(std::is_nothrow_constructible<result_type, in_place_index<1>, Args&&...>::value) {
+            set_result(result_type(error_tag, std::forward<Args>(args)...));
+        }
+    };
+}
+
+#endif // FLUX_FOUNDRY_LITE_FUTURE_H
@@ -0,0 +1,361 @@
+#ifndef FLUX_FOUNDRY_PARALLEL_FOR_H
+#define FLUX_FOUNDRY_PARALLEL_FOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "../base/inplace_base.h"
+#include "../base/traits.h"
+#include "../memory/aligned_alloc.h"
+#include "../utility/back_off.h"
+#include "../utility/concurrent_queues.h"
+#include "task_wrapper.h"
+
+namespace flux_foundry {
+namespace parallel_detail {
+    struct loop_range {
+        size_t begin;
+        size_t end;
+    };
+
+    using range_deque = spmc_deque<loop_range, 8>;
+
+    // the newest entry of an spmc_deque stays private to its owner until the next push,
+    // so a worker keeps two ranges queued to leave one that thieves can take.
+    static constexpr size_t stealable_depth = 2;
+
+    // failed rounds of looking for work before a helper leaves the loop.
+    static constexpr size_t idle_limit = 128;
+
+    struct no_local {};
+
+    // one per participant. the deque is built by the thread that owns it, spmc_deque binds to its creator.
+    template <typename Local>
+    struct alignas(CACHE_LINE_SIZE) worker_slot {
+        raw_inplace_storage_base<range_deque> deque;
+        raw_inplace_storage_base<Local> local;
+        std::atomic<bool> ready { false };
+    };
+
+    inline size_t auto_grain(size_t n, size_t workers) noexcept {
+        const size_t g = n / (workers * 64);
+        return g ? g : 1;
+    }
+
+    // the shared state of one loop over [begin, begin + total).
+    //
+    // Body provides:
+    // - void run(size_t begin, size_t end, Local& local) noexcept: one chunk, on the calling worker.
+    // - template <typename State> void finish(State& s) noexcept: called once, by the worker that
+    //   completes the last chunk. the locals of every worker are final by then.
+    //
+    // Scheduling model (lazy binary splitting):
+    // - worker 0 starts with the whole range, the others start empty and steal.
+    // - a worker walks its range `grain` indices at a time. between chunks, if its deque holds fewer than
+    //   stealable_depth ranges, it pushes the upper half of what is left instead. so ranges are only split
+    //   while some thief could take them, and a loop with no thieves costs one size check per chunk.
+    // - an exhausted range is counted as done, then the worker pops its own deque, then steals from the
+    //   front of the others, starting after its own slot.
+    template <typename Body, typename Local>
+    class loop_state {
+        using slot_t = worker_slot<Local>;
+
+        slot_t* slots_;
+        size_t workers_;
+        size_t begin_;
+        size_t total_;
+        size_t grain_;
+        std::atomic<size_t> done_ { 0 };
+        std::atomic<std::uint32_t> refs_ { 1 };
+
+        template <typename ... Args>
+        loop_state(slot_t* slots, size_t workers, size_t begin, size_t end, size_t grain, Args&& ... args) noexcept
+            : slots_(slots), workers_(workers), begin_(begin), total_(end - begin), grain_(grain),
+              body(std::forward<Args>(args)...) {
+        }
+
+        ~loop_state() noexcept {
+            for (size_t w = 0; w < workers_; ++w) {
+                if (slots_[w].ready.load(std::memory_order_relaxed)) {
+                    slots_[w].deque.destroy();
+                }
+                slots_[w].local.destroy();
+                slots_[w].~slot_t();
+            }
+            aligned_free(slots_);
+        }
+
+        bool next(size_t me, range_deque& own, loop_range& r) noexcept {
+            auto mine = own.try_pop_back();
+            if (mine.has_value()) {
+                r = mine.get();
+                return true;
+            }
+
+            for (size_t i = 1; i < workers_; ++i) {
+                slot_t& victim = slots_[(me + i) % workers_];
+                if (!victim.ready.load(std::memory_order_acquire)) {
+                    continue;
+                }
+                auto stolen = victim.deque.ptr()->try_pop_front();
+                if (stolen.has_value()) {
+                    r = stolen.get();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void run_range(range_deque& own, loop_range r, Local& local) noexcept {
+            const size_t first = r.begin;
+            while (r.end - r.begin > grain_) {
+                if (own.size() < stealable_depth) {
+                    const size_t mid = r.begin + (r.end - r.begin) / 2;
+                    if (own.try_emplace_back(loop_range{mid, r.end})) {
+                        r.end = mid;
+                        continue;
+                    }
+                }
+                body.run(r.begin, r.begin + grain_, local);
+                r.begin += grain_;
+            }
+            body.run(r.begin, r.end, local);
+
+            // what was split off is counted by whoever runs it.
+            const size_t n = r.end - first;
+            if (done_.fetch_add(n, std::memory_order_acq_rel) + n == total_) {
+                body.finish(*this);
+            }
+        }
+
+    public:
+        Body body;
+
+        // nullptr when the state or the slots cannot be allocated.
+        // every worker's local starts as a copy of `init`.
+        template <typename ... Args>
+        static loop_state* create(size_t begin, size_t end, size_t grain, size_t workers,
+            const Local& init, Args&& ... args) noexcept {
+            static_assert(std::is_nothrow_copy_constructible<Local>::value,
+                "the per-worker state should be nothrow copy constructible.");
+            static_assert(std::is_nothrow_constructible<Body, Args&&...>::value,
+                "the loop body should be nothrow constructible.");
+
+            auto slots = static_cast<slot_t*>(aligned_alloc(alignof(slot_t), workers * sizeof(slot_t)));
+            UNLIKELY_IF (!slots) {
+                return nullptr;
+            }
+            for (size_t w = 0; w < workers; ++w) {
+                new (&slots[w]) slot_t();
+                slots[w].local.construct(init);
+            }
+
+            auto s = new (std::nothrow) loop_state(slots, workers, begin, end, grain, std::forward<Args>(args)...);
+            UNLIKELY_IF (!s) {
+                for (size_t w = 0; w < workers; ++w) {
+                    slots[w].local.destroy();
+                    slots[w].~slot_t();
+                }
+                aligned_free(slots);
+            }
+            return s;
+        }
+
+        loop_state(const loop_state&) = delete;
+        loop_state& operator=(const loop_state&) = delete;
+
+        size_t workers() const noexcept {
+            return workers_;
+        }
+
+        Local& local(size_t w) noexcept {
+            return *slots_[w].local.ptr();
+        }
+
+        bool done() const noexcept {
+            return done_.load(std::memory_order_acquire) == total_;
+        }
+
+        void retain() noexcept {
+            refs_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void release() noexcept {
+            if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+
+        // participates as worker `me` until nothing is left to take. a helper gives up after idle_limit
+        // fruitless rounds, `until_done` keeps looking until the last chunk has finished.
+        void work(size_t me, bool until_done) noexcept {
+            slot_t& self = slots_[me];
+            self.deque.construct();
+            self.ready.store(true, std::memory_order_release);
+            range_deque& own = *self.deque.ptr();
+            Local& local = *self.local.ptr();
+
+            if (me == 0) {
+                run_range(own, loop_range{begin_, begin_ + total_}, local);
+            }
+
+            loop_range r{0, 0};
+            backoff_strategy<> backoff;
+            size_t idle = 0;
+            while (!done()) {
+                if (next(me, own, r)) {
+                    run_range(own, r, local);
+                    backoff.reset();
+                    idle = 0;
+                    continue;
+                }
+                if (!until_done && ++idle > idle_limit) {
+                    break;
+                }
+                backoff.yield();
+            }
+        }
+
+        // workers [first, workers()) run as tasks on exec, each holding a reference.
+        template <typename Executor>
+        void spawn(Executor& exec, size_t first) noexcept {
+            for (size_t w = first; w < workers_; ++w) {
+                retain();
+                exec->dispatch(task_wrapper_sbo([this, w]() noexcept {
+                    work(w, false);
+                    release();
+                }));
+            }
+        }
+    };
+
+    inline size_t loop_workers(size_t n, size_t grain, size_t concurrency) noexcept {
+        const size_t chunks = (n + grain - 1) / grain;
+        concurrency = concurrency ? concurrency : 1;
+        return chunks < concurrency ? chunks : concurrency;
+    }
+
+    template <typename F>
+    struct for_body {
+        F& f;
+
+        void run(size_t begin, size_t end, no_local&) noexcept {
+            for (size_t i = begin; i < end; ++i) {
+                f(i);
+            }
+        }
+
+        template <typename State>
+        void finish(State&) noexcept {
+        }
+    };
+
+    template <typename T, typename Map, typename Combine>
+    struct reduce_body {
+        Map& map;
+        Combine& combine;
+
+        void run(size_t begin, size_t end, T& local) noexcept {
+            for (size_t i = begin; i < end; ++i) {
+                local = combine(std::move(local), map(i));
+            }
+        }
+
+        template <typename State>
+        void finish(State&) noexcept {
+        }
+    };
+}
+
+    // parallel_for(exec, begin, end, f): calls f(i) for every i in [begin, end), spread over the calling
+    // thread and up to concurrency - 1 helper tasks dispatched to exec.
+    //
+    // - f is void(size_t) noexcept and called concurrently. indices are handed out as ranges by lazy
+    //   binary splitting over per-worker spmc_deques (see parallel_detail::loop_state).
+    // - grain is the smallest range a worker splits off, 0 picks n / (64 * workers).
+    // - the calling thread works on the loop too and returns when every index has run, so it never waits
+    //   on exec: helpers that start late, or share the caller's thread, find nothing left and leave.
+    // - if the loop state cannot be allocated, the caller runs the whole range itself.
+    template <typename Executor, typename F>
+    void parallel_for(Executor* exec, size_t begin, size_t end, F&& f, size_t grain = 0,
+        size_t concurrency = std::thread::hardware_concurrency()) noexcept {
+        static_assert(noexcept(f(std::declval<size_t>())), "f should be nothrow invocable with a size_t.");
+        using body_t = parallel_detail::for_body<std::remove_reference_t<F>>;
+        using state_t = parallel_detail::loop_state<body_t, parallel_detail::no_local>;
+
+        UNLIKELY_IF (end <= begin) {
+            return;
+        }
+
+        const size_t n = end - begin;
+        concurrency = concurrency ? concurrency : 1;
+        grain = grain ? grain : parallel_detail::auto_grain(n, concurrency);
+        const size_t workers = parallel_detail::loop_workers(n, grain, concurrency);
+
+        state_t* s = workers > 1
+            ? state_t::create(begin, end, grain, workers, parallel_detail::no_local{}, body_t{f})
+            : nullptr;
+        UNLIKELY_IF (!s) {
+            for (size_t i = begin; i < end; ++i) {
+                f(i);
+            }
+            return;
+        }
+
+        s->spawn(exec, 1);
+        s->work(0, true);
+        s->release();
+    }
+
+    // parallel_reduce(exec, begin, end, identity, map, combine): the combine-fold of map(i) over
+    // [begin, end), scheduled like parallel_for.
+    //
+    // - map is T(size_t) noexcept, combine is T(T&&, T&&) noexcept, both called concurrently.
+    // - every worker folds the indices it ran into its own partial, starting from identity. the caller
+    //   folds the partials in worker order at the end. workers take ranges in any order, so combine
+    //   must be associative and commutative for the result to be deterministic.
+    template <typename Executor, typename T, typename Map, typename Combine>
+    T parallel_reduce(Executor* exec, size_t begin, size_t end, T identity, Map&& map, Combine&& combine,
+        size_t grain = 0, size_t concurrency = std::thread::hardware_concurrency()) noexcept {
+        static_assert(noexcept(combine(std::declval<T&&>(), map(std::declval<size_t>()))),
+            "map and combine should be nothrow invocable.");
+        static_assert(conjunction_v<std::is_nothrow_copy_constructible<T>, std::is_nothrow_move_assignable<T>>,
+            "T should be nothrow copy constructible and nothrow move assignable.");
+        using body_t = parallel_detail::reduce_body<T, std::remove_reference_t<Map>, std::remove_reference_t<Combine>>;
+        using state_t = parallel_detail::loop_state<body_t, T>;
+
+        UNLIKELY_IF (end <= begin) {
+            return identity;
+        }
+
+        const size_t n = end - begin;
+        concurrency = concurrency ? concurrency : 1;
+        grain = grain ? grain : parallel_detail::auto_grain(n, concurrency);
+        const size_t workers = parallel_detail::loop_workers(n, grain, concurrency);
+
+        state_t* s = workers > 1
+            ? state_t::create(begin, end, grain, workers, identity, body_t{map, combine})
+            : nullptr;
+        UNLIKELY_IF (!s) {
+            for (size_t i = begin; i < end; ++i) {
+                identity = combine(std::move(identity), map(i));
+            }
+            return identity;
+        }
+
+        s->spawn(exec, 1);
+        s->work(0, true);
+        for (size_t w = 0; w < s->workers(); ++w) {
+            identity = combine(std::move(identity), std::move(s->local(w)));
+        }
+        s->release();
+        return identity;
+    }
+}
+
+#endif // FLUX_FOUNDRY_PARALLEL_FOR_H
@@ -0,0 +1,287 @@
+#ifndef FLUX_FOUNDRY_TASK_GRAPH_H
+#define FLUX_FOUNDRY_TASK_GRAPH_H
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "../base/traits.h"
+#include "../executor/current_executor.h"
+#include "../memory/small_vector.h"
+#include "../utility/callable_wrapper.h"
+#include "lite_future.h"
+#include "task_core.h"
+#include "task_wrapper.h"
+
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+#include <stdexcept>
+#endif
+
+namespace flux_foundry {
+    // task_graph: a DAG of tasks, built once and run many times on any executor.
+    //
+    // Build model:
+    // - add(f) stores f as a task<F> (task_core.h) and returns the node id, precede(a, b) makes b wait for a.
+    //   f takes no arguments and is invoked as an lvalue on every run, so it keeps what it needs in its captures.
+    // - the first run() after a change lays the edges out as flat arrays (successor offsets and ids,
+    //   a predecessor count per node) and checks the graph is acyclic. later runs only reset the counters.
+    // Execution model:
+    // - a finished node decrements the atomic counters of its successors. it keeps one newly ready node
+    //   for its own thread and splits the others into `concurrency` batches, one task each. a batch
+    //   carries at most `batch_capacity` ids inline, so a wider fan-out takes more tasks.
+    // - run() returns a lite_future<void> completed by the last node. the first node whose result holds an
+    //   error fails the run: nodes that have not started yet are skipped, the error is reported there.
+    // Lifecycle model:
+    // - the graph must outlive the run, and must not be changed or run again until the future is ready.
+    class task_graph {
+    public:
+        using node_id = std::uint32_t;
+        static constexpr size_t batch_capacity = 8;
+
+    private:
+        using body_t = callable_wrapper<bool(std::exception_ptr&)>;
+
+        template <typename T>
+        struct node_body {
+            T task;
+
+            bool operator()(std::exception_ptr& e) noexcept {
+                auto r = task();
+                LIKELY_IF (r.has_value()) {
+                    return true;
+                }
+                e = std::move(r).error();
+                return false;
+            }
+        };
+
+        // the ids ride inline in task_wrapper_sbo.
+        struct batch_task {
+            task_graph* g;
+            std::uint32_t n;
+            node_id ids[batch_capacity];
+
+            void operator()() noexcept {
+                // the run cannot complete before the last id has started, so g stays valid.
+                for (std::uint32_t i = 0; i < n; ++i) {
+                    g->execute(ids[i]);
+                }
+            }
+        };
+
+        small_vector<body_t, 8> bodies_;
+        small_vector<std::pair<node_id, node_id>, 16> edges_;
+
+        // flat layout, rebuilt by freeze() after a change.
+        small_vector<std::uint32_t, 8> preds_;
+        small_vector<std::uint32_t, 9> succ_begin_;
+        small_vector<node_id, 16> succ_;
+        small_vector<node_id, 8> roots_;
+        std::unique_ptr<std::atomic<std::uint32_t>[]> pending_;
+        bool dirty_ = true;
+        bool acyclic_ = true;
+
+        // run state.
+        std::atomic<std::uint32_t> remaining_ { 0 };
+        std::atomic<bool> failed_ { false };
+        std::exception_ptr error_;
+        // holds a state only while a run is in flight, run() creates it and finish() takes it.
+        lite_promise<void> promise_ { nullptr };
+        executor_ref exec_;
+        size_t concurrency_ = 1;
+
+        void freeze() {
+            LIKELY_IF (!dirty_) {
+                return;
+            }
+
+            const size_t n = bodies_.size();
+            preds_.clear();
+            preds_.resize(n);
+            succ_begin_.clear();
+            succ_begin_.resize(n + 1);
+            succ_.clear();
+            succ_.resize(edges_.size());
+            roots_.clear();
+
+            // counting sort of the edges by their source.
+            for (const auto& e : edges_) {
+                ++succ_begin_[e.first + 1];
+                ++preds_[e.second];
+            }
+            for (size_t i = 0; i < n; ++i) {
+                succ_begin_[i + 1] += succ_begin_[i];
+            }
+            {
+                small_vector<std::uint32_t, 9> fill(succ_begin_);
+                for (const auto& e : edges_) {
+                    succ_[fill[e.first]++] = e.second;
+                }
+            }
+
+            for (node_id v = 0; v < n; ++v) {
+                if (preds_[v] == 0) {
+                    roots_.push_back(v);
+                }
+            }
+
+            // Kahn's walk, every node is reached iff there is no cycle.
+            small_vector<std::uint32_t, 8> indegree(preds_);
+            small_vector<node_id, 8> frontier(roots_);
+            size_t reached = 0;
+            while (!frontier.empty()) {
+                const node_id v = frontier.back();
+                frontier.pop_back();
+                ++reached;
+                for (std::uint32_t i = succ_begin_[v]; i < succ_begin_[v + 1]; ++i) {
+                    if (--indegree[succ_[i]] == 0) {
+                        frontier.push_back(succ_[i]);
+                    }
+                }
+            }
+            acyclic_ = reached == n;
+
+            pending_.reset(n ? new std::atomic<std::uint32_t>[n] : nullptr);
+            dirty_ = false;
+        }
+
+        void fail(std::exception_ptr&& e) noexcept {
+            bool expected = false;
+            if (failed_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                error_ = std::move(e);
+            }
+        }
+
+        void finish() noexcept {
+            // the caller may destroy the graph as soon as the future is ready, publish from a local.
+            lite_promise<void> p(std::move(promise_));
+            if (failed_.load(std::memory_order_acquire)) {
+                p.set_error(std::move(error_));
+            } else {
+                p.set_value();
+            }
+        }
+
+        void dispatch_ready(const node_id* ids, size_t k) noexcept {
+            size_t per = (k + concurrency_ - 1) / concurrency_;
+            per = per > batch_capacity ? batch_capacity : per;
+            for (size_t i = 0; i < k; i += per) {
+                batch_task t{this, 0, {}};
+                for (size_t j = i; j < k && t.n < per; ++j) {
+                    t.ids[t.n++] = ids[j];
+                }
+                exec_.dispatch(task_wrapper_sbo(t));
+            }
+        }
+
+        // runs v, then keeps running one node it made ready, on this thread.
+        void execute(node_id v) noexcept {
+            small_vector<node_id, 32> ready;
+            for (;;) {
+                LIKELY_IF (!failed_.load(std::memory_order_relaxed)) {
+                    std::exception_ptr e;
+                    UNLIKELY_IF (!bodies_[v](e)) {
+                        fail(std::move(e));
+                    }
+                }
+
+                ready.clear();
+                for (std::uint32_t i = succ_begin_[v]; i < succ_begin_[v + 1]; ++i) {
+                    const node_id s = succ_[i];
+                    if (pending_[s].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        ready.push_back(s);
+                    }
+                }
+
+                if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    finish();
+                    return;
+                }
+
+                if (ready.empty()) {
+                    return;
+                }
+                if (ready.size() > 1) {
+                    dispatch_ready(ready.data() + 1, ready.size() - 1);
+                }
+                v = ready[0];
+            }
+        }
+
+    public:
+        task_graph() = default;
+
+        task_graph(const task_graph&) = delete;
+        task_graph& operator=(const task_graph&) = delete;
+
+        size_t node_count() const noexcept {
+            return bodies_.size();
+        }
+
+        size_t edge_count() const noexcept {
+            return edges_.size();
+        }
+
+        // F is invocable with no arguments, its task<F> result must carry a std::exception_ptr error.
+        template <typename F>
+        node_id add(F&& f) {
+            using task_t = task<std::decay_t<F>>;
+            static_assert(std::is_same<typename task_t::result_type::error_type, std::exception_ptr>::value,
+                "a task_graph node must report its errors as std::exception_ptr.");
+
+            const node_id id = static_cast<node_id>(bodies_.size());
+            bodies_.emplace_back(node_body<task_t>{task_t(std::forward<F>(f))});
+            dirty_ = true;
+            return id;
+        }
+
+        // `after` starts once `before` has finished.
+        void precede(node_id before, node_id after) {
+            assert(before < bodies_.size() && after < bodies_.size());
+            edges_.push_back(std::make_pair(before, after));
+            dirty_ = true;
+        }
+
+        // Executor is dispatched task_wrapper_sbo tasks, see executor_ref.
+        template <typename Executor>
+        lite_future<void> run(Executor* exec, size_t concurrency = std::thread::hardware_concurrency()) {
+            freeze();
+            lite_promise<void> p;
+            auto f = p.get_future();
+
+            UNLIKELY_IF (!acyclic_) {
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+                p.set_error(std::make_exception_ptr(std::logic_error("task_graph has a cycle")));
+#else
+                p.set_error(nullptr);
+#endif
+                return f;
+            }
+
+            UNLIKELY_IF (bodies_.empty()) {
+                p.set_value();
+                return f;
+            }
+
+            promise_ = std::move(p);
+            exec_ = executor_ref(exec);
+            concurrency_ = concurrency ? concurrency : 1;
+            for (size_t v = 0; v < bodies_.size(); ++v) {
+                pending_[v].store(preds_[v], std::memory_order_relaxed);
+            }
+            error_ = nullptr;
+            failed_.store(false, std::memory_order_relaxed);
+            remaining_.store(static_cast<std::uint32_t>(bodies_.size()), std::memory_order_relaxed);
+
+            // the executor queue publishes the counters to the workers.
+            dispatch_ready(roots_.data(), roots_.size());
+            return f;
+        }
+    };
+}
+
+#endif // FLUX_FOUNDRY_TASK_GRAPH_H
@@ -14,7 +14,7 @@
 
 namespace flux_foundry {
     // this is not thread safe
-    template <size_t sbo_size_, size_t align_>
+    template <size_t sbo_size_, size_t align_ = alignof(std::max_align_t)>
     class task_wrapper : 
         public raw_type_erase_base<task_wrapper<sbo_size_, align_>, sbo_size_, align_, void(void*)>  {
         using base = raw_type_erase_base<task_wrapper<sbo_size_, align_>, sbo_size_, align_, void(void*)>;
@@ -69,7 +69,7 @@ namespace flux_foundry {
             static_assert(is_compatible<T>::value,
                 "the given type is not compatible with task_wrapper container. T must be void() noexcept.");
             this->invoker_ = task_vfns<T, sbo_enabled>::call;
-            this->manager_ = life_span_manager<T, sbo_enabled>::manage;
+            this->manager_ = &life_span_manager<T, sbo_enabled>::vtable;
         }
 
         template <typename U,
@@ -93,6 +93,12 @@ namespace flux_foundry {
     using task_wrapper_sbo = task_wrapper<OPTIMIZED_ALIGN - 2 * sizeof(std::nullptr_t), alignof(std::max_align_t)>;
     static_assert(sizeof(task_wrapper_sbo) == OPTIMIZED_ALIGN,
                   "task_wrapper_sbo must fit exactly in one optimized alignment block.");
+
+    // for executors whose continuations capture more than task_wrapper_sbo holds inline
+    // (a runner plus a large result_t), see simple_executor<capacity, task_t>.
+    using task_wrapper_large = task_wrapper<2 * OPTIMIZED_ALIGN - 2 * sizeof(std::nullptr_t), alignof(std::max_align_t)>;
+    static_assert(sizeof(task_wrapper_large) == 2 * OPTIMIZED_ALIGN,
+                  "task_wrapper_large must fit exactly in two optimized alignment blocks.");
 }
 
 #endif
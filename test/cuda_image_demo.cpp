@@ -14,6 +14,7 @@
 
 #include "cuda_image_backend.h"
 #include "extension/external_async_awaitable.h"
+#include "extension/external_async_result_pool.h"
 #include "flow/flow.h"
 
 using namespace flux_foundry;
@@ -26,9 +27,17 @@ struct cuda_image_result {
     int width{0};
     int height{0};
     std::size_t bytes{0};
+    std::size_t capacity{0};
     unsigned char* rgba{nullptr};
 };
 
+struct cuda_image_result_release {
+    void operator()(cuda_image_result* p) const noexcept {
+        delete[] p->rgba;
+        delete p;
+    }
+};
+
 struct cuda_image_async_op {
     using context_t = flux_foundry_cuda_image_backend_context;
     using result_t = cuda_image_result*;
@@ -41,11 +50,17 @@ struct cuda_image_async_op {
         flux_foundry_cuda_image_backend_destroy(ctx);
     }
 
+    // frame buffers are recycled across submissions instead of being freed per frame.
+    using pool_t = extension::external_async_result_pool<cuda_image_result, 4, cuda_image_result_release>;
+
+    static pool_t& result_pool() noexcept {
+        static pool_t pool;
+        return pool;
+    }
+
     static void free_result(result_t p) noexcept {
         if (p != nullptr) {
-            delete[] p->rgba;
-            p->rgba = nullptr;
-            delete p;
+            cuda_image_result_release{}(p);
         }
     }
 
@@ -62,22 +77,29 @@ struct cuda_image_async_op {
             return nullptr;
         }
 
-        auto* out = new (std::nothrow) cuda_image_result{};
+        auto* out = result_pool().acquire();
         if (out == nullptr) {
-            return nullptr;
+            out = new (std::nothrow) cuda_image_result{};
+            if (out == nullptr) {
+                return nullptr;
+            }
         }
 
-        auto* rgba = new (std::nothrow) unsigned char[bytes];
-        if (rgba == nullptr) {
-            delete out;
-            return nullptr;
+        if (out->capacity < bytes) {
+            auto* rgba = new (std::nothrow) unsigned char[bytes];
+            if (rgba == nullptr) {
+                result_pool().recycle(out);
+                return nullptr;
+            }
+            delete[] out->rgba;
+            out->rgba = rgba;
+            out->capacity = bytes;
         }
 
-        std::memcpy(rgba, src, bytes);
+        std::memcpy(out->rgba, src, bytes);
         out->width = width;
         out->height = height;
         out->bytes = bytes;
-        out->rgba = rgba;
         return out;
     }
 };
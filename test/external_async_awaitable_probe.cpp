@@ -1,11 +1,14 @@
 #include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <exception>
 #include <new>
 #include <stdexcept>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "base/traits.h"
 #include "flow/flow_def.h"
@@ -50,6 +53,10 @@ struct async_any_failed_error<std::error_code> {
 
 #include "flow/flow.h"
 #include "extension/external_async_awaitable.h"
+#include "extension/batched_external_async.h"
+#include "extension/polled_external_async.h"
+#include "extension/external_async_result_pool.h"
+#include "executor/simple_executor.h"
 
 using namespace flux_foundry;
 
@@ -285,6 +292,489 @@ int test_cuda_submit_fail_path() {
     return failed;
 }
 
+// takes whole batches, completes every accepted context right away.
+struct mock_batch_op {
+    struct context_t {
+        int input = 0;
+        cuda_payload* out = nullptr;
+    };
+
+    using result_t = cuda_payload*;
+
+    static std::vector<size_t> batches;
+    static size_t accept_limit;
+
+    static int init_ctx(context_t* ctx, int* in) noexcept {
+        ctx->input = *in;
+        return 0;
+    }
+
+    static void destroy_ctx(context_t* ctx) noexcept {
+        delete ctx->out;
+        ctx->out = nullptr;
+    }
+
+    static void free_result(result_t p) noexcept {
+        delete p;
+    }
+
+    static size_t submit_batch(context_t** ctxs, size_t n,
+        extension::external_async_callback_fp_t cb, extension::external_async_callback_param_t* users) noexcept {
+        batches.push_back(n);
+        size_t accepted = n < accept_limit ? n : accept_limit;
+        for (size_t i = 0; i < accepted; ++i) {
+            ctxs[i]->out = new (std::nothrow) cuda_payload(ctxs[i]->input * 2);
+            cb(users[i]);
+        }
+        return accepted;
+    }
+
+    static result_t collect(context_t* ctx) noexcept {
+        auto* p = ctx->out;
+        ctx->out = nullptr;
+        return p;
+    }
+};
+
+std::vector<size_t> mock_batch_op::batches;
+size_t mock_batch_op::accept_limit = ~size_t(0);
+
+// queues the flush tasks until run_all(), like one executor tick.
+struct manual_executor {
+    std::vector<task_wrapper_sbo> tasks;
+
+    void dispatch(task_wrapper_sbo&& t) noexcept {
+        tasks.emplace_back(std::move(t));
+    }
+
+    void run_all() noexcept {
+        auto batch = std::move(tasks);
+        tasks.clear();
+        for (auto& t : batch) {
+            t();
+        }
+    }
+};
+
+template <typename Out>
+struct batch_observer {
+    std::vector<int> values;
+    int errors = 0;
+    err_t err{};
+};
+
+template <typename Out>
+struct batch_receiver {
+    using value_type = Out;
+    batch_observer<Out>* obs{};
+
+    void emplace(value_type&& r) noexcept {
+        if (r.has_value()) {
+            obs->values.push_back(r.value() ? r.value()->value : -1);
+            return;
+        }
+        ++obs->errors;
+        obs->err = r.error();
+    }
+};
+
+template <typename OP, typename Stage>
+auto make_batched_bp(Stage& stage) {
+    auto bp = make_blueprint<int, err_t>()
+        | await_batched_external_async<OP>(stage)
+        | end();
+    return make_lite_ptr<decltype(bp)>(std::move(bp));
+}
+
+int test_batched_size_threshold() {
+    using stage_t = extension::external_async_batcher<mock_batch_op, manual_executor*, 8>;
+    using out_bt = typename stage_t::awaitable_t::async_result_type;
+    mock_batch_op::batches.clear();
+    mock_batch_op::accept_limit = ~size_t(0);
+
+    manual_executor ex;
+    stage_t stage(&ex, 3, std::chrono::hours(1));
+    batch_observer<out_bt> obs;
+    auto bp = make_batched_bp<mock_batch_op>(stage);
+
+    int failed = 0;
+    for (int i = 1; i <= 2; ++i) {
+        auto runner = make_runner(bp, batch_receiver<out_bt>{&obs});
+        runner(i);
+    }
+    check(mock_batch_op::batches.empty() && obs.values.empty(), "batched contexts are staged", failed);
+    check(ex.tasks.size() == 1, "batched staging arms one tick flush", failed);
+
+    auto runner = make_runner(bp, batch_receiver<out_bt>{&obs});
+    runner(3);
+    check(mock_batch_op::batches == std::vector<size_t>({3}), "batched size threshold submits one batch", failed);
+    check(obs.values == std::vector<int>({2, 4, 6}), "batched results reach every runner", failed);
+
+    ex.run_all();
+    check(mock_batch_op::batches.size() == 1, "batched tick flush of an empty stage is a no-op", failed);
+    return failed;
+}
+
+int test_batched_tick_and_deadline() {
+    using stage_t = extension::external_async_batcher<mock_batch_op, manual_executor*, 8>;
+    using out_bt = typename stage_t::awaitable_t::async_result_type;
+    mock_batch_op::batches.clear();
+    mock_batch_op::accept_limit = ~size_t(0);
+
+    manual_executor ex;
+    stage_t stage(&ex, 8, std::chrono::milliseconds(5));
+    batch_observer<out_bt> obs;
+    auto bp = make_batched_bp<mock_batch_op>(stage);
+
+    int failed = 0;
+    for (int i = 1; i <= 2; ++i) {
+        auto runner = make_runner(bp, batch_receiver<out_bt>{&obs});
+        runner(i);
+    }
+    ex.run_all();
+    check(mock_batch_op::batches == std::vector<size_t>({2}) && obs.values.size() == 2,
+        "batched tick end submits the staged contexts", failed);
+
+    auto runner = make_runner(bp, batch_receiver<out_bt>{&obs});
+    runner(5);
+    check(!stage.poll(), "batched poll keeps a young batch", failed);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    check(stage.poll(), "batched poll submits after the deadline", failed);
+    check(obs.values.size() == 3 && obs.values[2] == 10, "batched deadline flush delivers the result", failed);
+    ex.run_all();
+    return failed;
+}
+
+int test_batched_partial_accept() {
+    using stage_t = extension::external_async_batcher<mock_batch_op, manual_executor*, 8>;
+    using out_bt = typename stage_t::awaitable_t::async_result_type;
+    mock_batch_op::batches.clear();
+    mock_batch_op::accept_limit = 1;
+
+    manual_executor ex;
+    stage_t stage(&ex, 2, std::chrono::hours(1));
+    batch_observer<out_bt> obs;
+    auto bp = make_batched_bp<mock_batch_op>(stage);
+
+    for (int i = 1; i <= 2; ++i) {
+        auto runner = make_runner(bp, batch_receiver<out_bt>{&obs});
+        runner(i);
+    }
+    ex.run_all();
+
+    int failed = 0;
+    check(obs.values == std::vector<int>({2}) && obs.errors == 1, "batched rejected tail fails", failed);
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+    check(has_logic_error_message(obs.err, "failed to submit async operation"),
+          "batched rejected tail async_submission_failed_error", failed);
+#else
+    check(obs.err.value() == 1004, "batched rejected tail async_submission_failed_error", failed);
+#endif
+    mock_batch_op::accept_limit = ~size_t(0);
+    return failed;
+}
+
+int test_batched_submit_fallback() {
+    using stage_t = extension::external_async_batcher<mock_cuda_op, manual_executor*, 8>;
+    using out_bt = typename stage_t::awaitable_t::async_result_type;
+    mock_cuda_op::reset();
+
+    manual_executor ex;
+    stage_t stage(&ex, 8, std::chrono::hours(1));
+    batch_observer<out_bt> obs;
+    auto bp = make_batched_bp<mock_cuda_op>(stage);
+
+    for (int i = 0; i < 3; ++i) {
+        auto runner = make_runner(bp, batch_receiver<out_bt>{&obs});
+        runner(i);
+    }
+
+    int failed = 0;
+    check(mock_cuda_op::submit_count.load(std::memory_order_relaxed) == 0, "batched fallback stages before submit", failed);
+    ex.run_all();
+    check(mock_cuda_op::submit_count.load(std::memory_order_relaxed) == 3, "batched fallback submits per context", failed);
+    check(obs.values == std::vector<int>({2, 3}) && obs.errors == 1, "batched fallback reports per-context failures", failed);
+    check(mock_cuda_op::destroy_count.load(std::memory_order_relaxed) == 3, "batched fallback destroys every context", failed);
+    return failed;
+}
+
+// completes after `input` polls, input == 0 fails to start.
+struct mock_poll_op {
+    struct context_t {
+        int input = 0;
+        int polls_left = 0;
+        std::thread::id completed_on;
+    };
+
+    using result_t = cuda_payload*;
+
+    static std::atomic<int> destroy_count;
+    static std::atomic<int> wrong_thread;
+    static std::thread::id poll_thread;
+
+    static int init_ctx(context_t* ctx, int* in) noexcept {
+        ctx->input = *in;
+        return 0;
+    }
+
+    static void destroy_ctx(context_t*) noexcept {
+        destroy_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void free_result(result_t p) noexcept {
+        delete p;
+    }
+
+    static int start(context_t* ctx) noexcept {
+        if (ctx->input == 0) {
+            return -1;
+        }
+        ctx->polls_left = ctx->input;
+        return 0;
+    }
+
+    static bool poll(context_t* ctx) noexcept {
+        return --ctx->polls_left <= 0;
+    }
+
+    static result_t collect(context_t* ctx) noexcept {
+        if (poll_thread != std::thread::id() && std::this_thread::get_id() != poll_thread) {
+            wrong_thread.fetch_add(1, std::memory_order_relaxed);
+        }
+        return new (std::nothrow) cuda_payload(ctx->input * 2);
+    }
+};
+
+std::atomic<int> mock_poll_op::destroy_count{0};
+std::atomic<int> mock_poll_op::wrong_thread{0};
+std::thread::id mock_poll_op::poll_thread;
+
+template <typename OP, typename Poller>
+auto make_polled_bp(Poller& poller) {
+    auto bp = make_blueprint<int, err_t>()
+        | await_polled_external_async<OP>(poller)
+        | end();
+    return make_lite_ptr<decltype(bp)>(std::move(bp));
+}
+
+int test_polled_ticks() {
+    using poller_t = extension::external_async_poller<mock_poll_op, manual_executor*>;
+    using out_pt = typename poller_t::awaitable_t::async_result_type;
+    mock_poll_op::destroy_count = 0;
+
+    manual_executor ex;
+    poller_t poller(&ex);
+    batch_observer<out_pt> obs;
+    auto bp = make_polled_bp<mock_poll_op>(poller);
+
+    int failed = 0;
+    for (int i : {3, 1}) {
+        auto runner = make_runner(bp, batch_receiver<out_pt>{&obs});
+        runner(i);
+    }
+    check(obs.values.empty() && ex.tasks.size() == 1, "polled contexts arm one tick", failed);
+
+    ex.run_all();
+    check(obs.values == std::vector<int>({2}) && ex.tasks.size() == 1, "polled tick resumes completed contexts", failed);
+    ex.run_all();
+    ex.run_all();
+    check(obs.values == std::vector<int>({2, 6}) && ex.tasks.empty(), "polled ticks stop once nothing is in flight", failed);
+    check(mock_poll_op::destroy_count.load() == 2, "polled contexts are destroyed", failed);
+
+    auto runner = make_runner(bp, batch_receiver<out_pt>{&obs});
+    runner(1);
+    check(ex.tasks.size() == 1, "an idle poller re-arms", failed);
+    ex.run_all();
+    check(obs.values.size() == 3 && ex.tasks.empty(), "a re-armed poller completes", failed);
+    return failed;
+}
+
+int test_polled_start_fail() {
+    using poller_t = extension::external_async_poller<mock_poll_op, manual_executor*>;
+    using out_pt = typename poller_t::awaitable_t::async_result_type;
+
+    manual_executor ex;
+    poller_t poller(&ex);
+    batch_observer<out_pt> obs;
+    auto bp = make_polled_bp<mock_poll_op>(poller);
+
+    auto runner = make_runner(bp, batch_receiver<out_pt>{&obs});
+    runner(0);
+
+    int failed = 0;
+    check(obs.errors == 1 && ex.tasks.empty(), "polled start failure is not registered", failed);
+#if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
+    check(has_logic_error_message(obs.err, "failed to submit async operation"),
+          "polled start failure async_submission_failed_error", failed);
+#else
+    check(obs.err.value() == 1004, "polled start failure async_submission_failed_error", failed);
+#endif
+    return failed;
+}
+
+int test_polled_concurrent_submitters() {
+    constexpr int threads = 4;
+    constexpr int rounds = 2000;
+
+    simple_executor<1024> ex;
+    std::thread worker([&]() noexcept { ex.run(); });
+    using poller_t = extension::external_async_poller<mock_poll_op, simple_executor<1024>*>;
+    using out_pt = typename poller_t::awaitable_t::async_result_type;
+    poller_t poller(&ex);
+    mock_poll_op::poll_thread = worker.get_id();
+    mock_poll_op::wrong_thread = 0;
+
+    std::atomic<int> done{0};
+    std::atomic<int> wrong{0};
+    struct count_receiver {
+        using value_type = out_pt;
+        std::atomic<int>* done;
+        std::atomic<int>* wrong;
+        int expected;
+
+        void emplace(value_type&& r) noexcept {
+            if (!r.has_value() || r.value()->value != expected) {
+                wrong->fetch_add(1, std::memory_order_relaxed);
+            }
+            done->fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    auto bp = make_polled_bp<mock_poll_op>(poller);
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < threads; ++t) {
+        submitters.emplace_back([&, t]() {
+            for (int i = 0; i < rounds; ++i) {
+                int v = 1 + (i + t) % 4;
+                auto runner = make_runner(bp, count_receiver{&done, &wrong, v * 2});
+                runner(v);
+            }
+        });
+    }
+    for (auto& s : submitters) {
+        s.join();
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    while (done.load(std::memory_order_acquire) != threads * rounds
+        && std::chrono::steady_clock::now() - begin < std::chrono::seconds(10)) {
+        std::this_thread::yield();
+    }
+
+    int failed = 0;
+    check(done.load() == threads * rounds, "polled concurrent flows all complete", failed);
+    check(wrong.load() == 0, "polled concurrent flows get their results", failed);
+    check(mock_poll_op::wrong_thread.load() == 0, "polled completions run on the poller thread", failed);
+
+    while (!ex.try_shutdown()) {
+        std::this_thread::yield();
+    }
+    worker.join();
+    mock_poll_op::poll_thread = std::thread::id();
+    return failed;
+}
+
+struct pooled_release {
+    static int count;
+
+    void operator()(cuda_payload* p) const noexcept {
+        ++count;
+        delete p;
+    }
+};
+
+int pooled_release::count = 0;
+
+// recycles its results through result_pool(), counts fresh allocations.
+struct mock_pooled_op {
+    struct context_t {
+        int input = 0;
+    };
+
+    using result_t = cuda_payload*;
+    using pool_t = extension::external_async_result_pool<cuda_payload, 2, pooled_release>;
+
+    static int allocations;
+    static int free_count;
+
+    static pool_t& result_pool() noexcept {
+        static pool_t pool;
+        return pool;
+    }
+
+    static int init_ctx(context_t* ctx, int* in) noexcept {
+        ctx->input = *in;
+        return 0;
+    }
+
+    static void destroy_ctx(context_t*) noexcept {
+    }
+
+    static void free_result(result_t p) noexcept {
+        ++free_count;
+        delete p;
+    }
+
+    static int submit(context_t*, extension::external_async_callback_fp_t cb, extension::external_async_callback_param_t user) noexcept {
+        cb(user);
+        return 0;
+    }
+
+    static result_t collect(context_t* ctx) noexcept {
+        auto p = result_pool().acquire();
+        if (!p) {
+            ++allocations;
+            p = new (std::nothrow) cuda_payload(0);
+            if (!p) {
+                return nullptr;
+            }
+        }
+        p->value = ctx->input * 3;
+        return p;
+    }
+};
+
+int mock_pooled_op::allocations = 0;
+int mock_pooled_op::free_count = 0;
+
+using pooled_out_t = typename extension::external_async_awaitable<mock_pooled_op>::async_result_type;
+
+struct holding_receiver {
+    using value_type = pooled_out_t;
+    std::vector<value_type>* held{};
+
+    void emplace(value_type&& r) noexcept {
+        held->emplace_back(std::move(r));
+    }
+};
+
+int test_pooled_results() {
+    auto bp = make_blueprint<int, err_t>()
+        | await_external_async<mock_pooled_op>()
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+
+    int failed = 0;
+    batch_observer<pooled_out_t> obs;
+    for (int i = 1; i <= 3; ++i) {
+        auto runner = make_runner(bp_ptr, batch_receiver<pooled_out_t>{&obs});
+        runner(i);
+    }
+    check(obs.values == std::vector<int>({3, 6, 9}), "pooled results are refilled", failed);
+    check(mock_pooled_op::allocations == 1, "pooled result buffer is reused across submissions", failed);
+
+    std::vector<pooled_out_t> held;
+    for (int i = 1; i <= 3; ++i) {
+        auto runner = make_runner(bp_ptr, holding_receiver{&held});
+        runner(i);
+    }
+    check(mock_pooled_op::allocations == 3, "pooled results in use are not shared", failed);
+    held.clear();
+    check(pooled_release::count == 1, "pooled surplus beyond capacity is released", failed);
+    check(mock_pooled_op::free_count == 0, "pooled results bypass free_result", failed);
+    return failed;
+}
+
 } // namespace
 
 int main() {
@@ -292,6 +782,14 @@ int main() {
     failed += test_cuda_success_path();
     failed += test_cuda_init_fail_path();
     failed += test_cuda_submit_fail_path();
+    failed += test_batched_size_threshold();
+    failed += test_batched_tick_and_deadline();
+    failed += test_batched_partial_accept();
+    failed += test_batched_submit_fallback();
+    failed += test_polled_ticks();
+    failed += test_polled_start_fail();
+    failed += test_polled_concurrent_submitters();
+    failed += test_pooled_results();
     if (failed != 0) {
         std::printf("[FAIL] external_async_awaitable_probe failures=%d\n", failed);
         return 1;
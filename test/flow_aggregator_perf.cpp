@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+// Fan-in contention of flow_aggregator: `threads` producers fill the N slots of one aggregator at once
+// (slot i belongs to thread i % threads) while the main thread sits in wait_all().
+// - packed: flow_aggregator, one flag array and one counter shared by every producer.
+// - sharded<k>: basic_flow_aggregator<sharded_slots<k>>, padded slots and a combining counter.
+// Each row is the median time per aggregator, from releasing the producers to wait_all() returning.
+
+namespace {
+using err_t = std::exception_ptr;
+using in_t = result_t<int, err_t>;
+
+constexpr int kRounds = 5;
+constexpr int kBatch = 400;
+
+template <size_t>
+using slot_t = in_t;
+
+template <typename Layout, typename Seq>
+struct wide_agg;
+
+template <typename Layout, size_t... Is>
+struct wide_agg<Layout, std::index_sequence<Is...>> {
+    using type = basic_flow_aggregator<Layout, slot_t<Is>...>;
+};
+
+template <typename Agg, size_t... Is>
+void bind_slots(Agg& agg, std::vector<std::function<void()>>& slots, std::index_sequence<Is...>) {
+    int unused[] = {0, (slots[Is] = [d = agg.template delegate_for<Is>()]() mutable {
+        d.emplace(value_tag, static_cast<int>(Is));
+    }, 0)...};
+    (void)unused;
+}
+
+// producers stay up for the whole run and are released once per aggregator.
+class producers {
+    std::vector<std::thread> threads_;
+    std::vector<std::function<void()>>* slots_ = nullptr;
+    std::atomic<unsigned> generation_{0};
+    std::atomic<size_t> finished_{0};
+    std::atomic<bool> stop_{false};
+
+    void run(size_t me, size_t count) noexcept {
+        unsigned seen = 0;
+        for (;;) {
+            unsigned g;
+            while ((g = generation_.load(std::memory_order_acquire)) == seen) {
+                if (stop_.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+            seen = g;
+            auto& slots = *slots_;
+            for (size_t i = me; i < slots.size(); i += count) {
+                slots[i]();
+            }
+            finished_.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+public:
+    explicit producers(size_t count) {
+        for (size_t t = 0; t < count; ++t) {
+            threads_.emplace_back([this, t, count]() noexcept { run(t, count); });
+        }
+    }
+
+    ~producers() {
+        stop_.store(true, std::memory_order_relaxed);
+        for (auto& t : threads_) {
+            t.join();
+        }
+    }
+
+    void release(std::vector<std::function<void()>>& slots) noexcept {
+        slots_ = &slots;
+        finished_.store(0, std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+
+    // the slots must outlive the producers' calls.
+    void drain() const noexcept {
+        while (finished_.load(std::memory_order_acquire) != threads_.size()) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+template <typename Layout, size_t N>
+double fan_in_ns(producers& p, bool& ok) {
+    using agg_t = typename wide_agg<Layout, std::make_index_sequence<N>>::type;
+    std::array<double, kRounds> ns{};
+    for (int round = 0; round < kRounds; ++round) {
+        double total = 0;
+        for (int b = 0; b < kBatch; ++b) {
+            agg_t agg;
+            std::vector<std::function<void()>> slots(N);
+            bind_slots(agg, slots, std::make_index_sequence<N>{});
+
+            auto begin = std::chrono::steady_clock::now();
+            p.release(slots);
+            agg.wait_all();
+            total += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+            p.drain();
+            ok = ok && agg.value_got() == N;
+        }
+        ns[static_cast<size_t>(round)] = total / kBatch;
+    }
+    std::sort(ns.begin(), ns.end());
+    return ns[kRounds / 2];
+}
+
+template <size_t N>
+void run_case(size_t max_threads, bool& ok) {
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        producers p(threads);
+        const double packed = fan_in_ns<packed_slots, N>(p, ok);
+        const double sharded4 = fan_in_ns<sharded_slots<4>, N>(p, ok);
+        const double sharded8 = fan_in_ns<sharded_slots<8>, N>(p, ok);
+        std::printf("slots=%4zu threads=%3zu packed %10.0f ns   sharded<4> %10.0f ns (x%5.2f)   "
+            "sharded<8> %10.0f ns (x%5.2f)\n",
+            N, threads, packed, sharded4, packed / sharded4, sharded8, packed / sharded8);
+        if (threads < max_threads && threads * 2 > max_threads) {
+            threads = max_threads / 2;
+        }
+    }
+}
+
+int arg_or_default(char** argv, int argc, int index, int fallback) {
+    if (index >= argc) {
+        return fallback;
+    }
+    const int v = std::atoi(argv[index]);
+    return v > 0 ? v : fallback;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t hw = std::thread::hardware_concurrency();
+    const size_t threads = static_cast<size_t>(arg_or_default(argv, argc, 1, static_cast<int>(hw ? hw : 1)));
+    std::printf("[flow aggregator perf] threads=%zu\n", threads);
+
+    bool ok = true;
+    run_case<16>(threads, ok);
+    run_case<64>(threads, ok);
+
+    if (!ok) {
+        std::printf("[FAIL] an aggregator finished with empty slots\n");
+        return 1;
+    }
+
+    std::printf("[PASS] flow aggregator perf finished\n");
+    return 0;
+}
@@ -0,0 +1,276 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using in_t = result_t<int, err_t>;
+using agg_t = flow_aggregator<in_t, in_t, in_t>;
+
+template <size_t>
+using slot_t = in_t;
+
+template <typename Layout, typename Seq>
+struct wide_agg;
+
+template <typename Layout, size_t... Is>
+struct wide_agg<Layout, std::index_sequence<Is...>> {
+    using type = basic_flow_aggregator<Layout, slot_t<Is>...>;
+};
+
+// 20 slots under 4-wide counters: two levels below a root of two groups.
+constexpr size_t kWide = 20;
+using wide_t = wide_agg<sharded_slots<4>, std::make_index_sequence<kWide>>::type;
+
+static_assert(std::is_empty<detail::combining_counter<kWide, 0>>::value,
+    "packed_slots counts every arrival at the root and keeps no counters below it");
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+struct sum_log {
+    int values = 0;
+    int errors = 0;
+    int last = 0;
+};
+
+struct log_receiver {
+    using value_type = in_t;
+    sum_log* log;
+
+    void emplace(value_type&& r) noexcept {
+        if (r.has_value()) {
+            ++log->values;
+            log->last = r.value();
+        } else {
+            ++log->errors;
+        }
+    }
+};
+
+int sum_slots(const agg_t& agg) noexcept {
+    return get<0>(agg.value()).value() + get<1>(agg.value()).value() + get<2>(agg.value()).value();
+}
+
+int test_wait_all() {
+    int failed = 0;
+    agg_t agg;
+    std::vector<std::thread> producers;
+    producers.emplace_back([d = agg.delegate_for<0>()]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        d.emplace(value_tag, 1);
+    });
+    producers.emplace_back([d = agg.delegate_for<1>()]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        d.emplace(value_tag, 2);
+    });
+    producers.emplace_back([d = agg.delegate_for<2>()]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(15));
+        d.emplace(value_tag, 3);
+    });
+
+    agg.wait_all();
+    check(agg.is_all_ready() && agg.value_got() == 3 && sum_slots(agg) == 6,
+        "wait_all returns once every slot is filled", failed);
+    for (auto& t : producers) {
+        t.join();
+    }
+    return failed;
+}
+
+int test_wait_any_and_timeout() {
+    int failed = 0;
+    agg_t agg;
+    auto d0 = agg.delegate_for<0>();
+    auto d1 = agg.delegate_for<1>();
+    auto d2 = agg.delegate_for<2>();
+
+    std::thread first([&d1]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        d1.emplace(value_tag, 7);
+    });
+    agg.wait_any();
+    check(agg.is_slot_ready<1>() && agg.value_got() == 1, "wait_any returns on the first filled slot", failed);
+    first.join();
+
+    const auto begin = std::chrono::steady_clock::now();
+    const bool early = agg.wait_all_for(std::chrono::milliseconds(20));
+    check(!early && std::chrono::steady_clock::now() - begin >= std::chrono::milliseconds(20),
+        "wait_all_for times out while a slot is empty", failed);
+
+    d0.emplace(value_tag, 1);
+    d2.emplace(value_tag, 2);
+    check(agg.wait_all_for(std::chrono::milliseconds(20)) && sum_slots(agg) == 10,
+        "wait_all_for succeeds once every slot is filled", failed);
+    return failed;
+}
+
+int test_await_aggregator() {
+    int failed = 0;
+    agg_t agg;
+    sum_log log;
+
+    auto bp = make_blueprint<int>()
+        | await_aggregator(agg)
+        | transform([](const agg_t& a) noexcept { return sum_slots(a); })
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+
+    auto first = make_runner(bp_ptr, log_receiver{&log});
+    first(0);
+    auto second = make_runner(bp_ptr, log_receiver{&log});
+    second(0);
+
+    agg.delegate_for<0>().emplace(value_tag, 10);
+    agg.delegate_for<1>().emplace(value_tag, 20);
+    check(log.values == 0, "awaiting flows stay parked until the last slot", failed);
+    agg.delegate_for<2>().emplace(value_tag, 30);
+    check(log.values == 2 && log.last == 60, "the last slot resumes every awaiting flow", failed);
+
+    auto late = make_runner(bp_ptr, log_receiver{&log});
+    late(0);
+    check(log.values == 3, "a flow arriving after the last slot continues at once", failed);
+
+    auto failing = make_runner(bp_ptr, log_receiver{&log});
+    failing(in_t(error_tag, std::make_exception_ptr(std::logic_error("upstream"))));
+    check(log.errors == 1, "an error input passes through without waiting", failed);
+    return failed;
+}
+
+// the blueprint keeps its own handle, the aggregator object it was built from may go away first.
+int test_blueprint_holds_aggregator() {
+    int failed = 0;
+    sum_log log;
+    std::unique_ptr<agg_t> agg(new agg_t);
+    auto d0 = agg->delegate_for<0>();
+    auto d1 = agg->delegate_for<1>();
+    auto d2 = agg->delegate_for<2>();
+
+    auto bp = make_blueprint<int>()
+        | await_aggregator(*agg)
+        | transform([](const agg_t& a) noexcept { return sum_slots(a); })
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+    agg.reset();
+
+    auto runner = make_runner(bp_ptr, log_receiver{&log});
+    runner(0);
+    d0.emplace(value_tag, 1);
+    d1.emplace(value_tag, 2);
+    d2.emplace(value_tag, 3);
+    check(log.values == 1 && log.last == 6, "await_aggregator outlives the aggregator it was built from", failed);
+    return failed;
+}
+
+int test_cancel_unlinks() {
+    int failed = 0;
+    agg_t agg;
+    sum_log log;
+
+    auto bp = make_blueprint<int>()
+        | await_aggregator(agg)
+        | transform([](const agg_t& a) noexcept { return sum_slots(a); })
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+
+    auto canceled = make_runner(bp_ptr, log_receiver{&log});
+    canceled(0);
+    auto waiting = make_runner(bp_ptr, log_receiver{&log});
+    waiting(0);
+
+    canceled.get_controller()->cancel(true);
+    check(log.errors == 1, "a canceled flow is resumed with an error", failed);
+
+    agg.delegate_for<0>().emplace(value_tag, 1);
+    agg.delegate_for<1>().emplace(value_tag, 1);
+    agg.delegate_for<2>().emplace(value_tag, 1);
+    check(log.values == 1 && log.errors == 1, "a canceled flow is not resumed again", failed);
+    return failed;
+}
+template <size_t... Is>
+void fill_wide(wide_t& agg, std::index_sequence<Is...>) {
+    std::vector<std::thread> producers;
+    int unused[] = {0, (producers.emplace_back([d = agg.delegate_for<Is>()]() mutable {
+        d.emplace(value_tag, static_cast<int>(Is));
+    }), 0)...};
+    (void)unused;
+    for (auto& t : producers) {
+        t.join();
+    }
+}
+
+template <size_t... Is>
+int sum_wide(const wide_t& agg, std::index_sequence<Is...>) noexcept {
+    int sum = 0;
+    int unused[] = {0, (sum += agg.result<Is>().value(), 0)...};
+    (void)unused;
+    return sum;
+}
+
+int test_sharded() {
+    int failed = 0;
+    using seq = std::make_index_sequence<kWide>;
+    constexpr int expected = static_cast<int>(kWide * (kWide - 1) / 2);
+
+    wide_t agg;
+    check(!agg.is_any_ready() && agg.value_got() == 0, "a sharded aggregator starts empty", failed);
+    agg.delegate_for<5>().emplace(value_tag, 5);
+    check(agg.is_any_ready() && !agg.is_all_ready() && agg.value_got() == 1,
+        "one slot of an open group marks the sharded aggregator", failed);
+    check(!agg.delegate_for<5>().emplace(value_tag, 0), "a sharded slot is only filled once", failed);
+
+    wide_t waited;
+    std::thread filler([&waited]() { fill_wide(waited, seq{}); });
+    waited.wait_all();
+    check(waited.is_all_ready() && waited.value_got() == kWide && sum_wide(waited, seq{}) == expected,
+        "wait_all returns once every sharded slot is filled", failed);
+    filler.join();
+
+    wide_t awaited;
+    sum_log log;
+    auto bp = make_blueprint<int>()
+        | await_aggregator(awaited)
+        | transform([](const wide_t& a) noexcept { return sum_wide(a, seq{}); })
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+    auto runner = make_runner(bp_ptr, log_receiver{&log});
+    runner(0);
+    fill_wide(awaited, seq{});
+    check(log.values == 1 && log.last == expected, "the last sharded slot resumes an awaiting flow", failed);
+    return failed;
+}
+} // namespace
+
+int main() {
+    int failed = 0;
+    failed += test_wait_all();
+    failed += test_wait_any_and_timeout();
+    failed += test_await_aggregator();
+    failed += test_blueprint_holds_aggregator();
+    failed += test_cancel_unlinks();
+    failed += test_sharded();
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] aggregator wait test passed\n");
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include <cstdio>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using in_t = result_t<int, err_t>;
+using out_t = result_t<int, err_t>;
+using any_bp_t = any_blueprint<in_t, out_t>;
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+struct plus_one_awaitable final : awaitable_base<plus_one_awaitable, int, err_t> {
+    using async_result_type = out_t;
+    int v;
+
+    explicit plus_one_awaitable(async_result_type&& in) noexcept
+        : v(in.has_value() ? in.value() : 0) {
+    }
+
+    int submit() noexcept {
+        this->resume(async_result_type(value_tag, v + 1));
+        return 0;
+    }
+
+    void cancel() noexcept {}
+};
+
+struct run_observer {
+    int calls = 0;
+    bool has_value = false;
+    int value = 0;
+};
+
+struct int_receiver {
+    using value_type = out_t;
+
+    run_observer* obs;
+
+    void emplace(value_type&& r) noexcept {
+        ++obs->calls;
+        obs->has_value = r.has_value();
+        obs->value = r.has_value() ? r.value() : 0;
+    }
+};
+
+// pipelines of different static types behind one any_blueprint type, picked by name at runtime.
+any_bp_t pick_pipeline(const std::string& name) {
+    if (name == "double") {
+        return make_any_blueprint(make_blueprint<int>()
+            | transform([](int x) noexcept { return x * 2; })
+            | end());
+    }
+    if (name == "async") {
+        return make_any_blueprint(make_blueprint<int>()
+            | transform([](int x) noexcept { return x + 10; })
+            | await<plus_one_awaitable>()
+            | transform([](int x) noexcept { return x * 3; })
+            | end());
+    }
+    if (name == "fail") {
+        return make_any_blueprint(make_blueprint<int>()
+            | then([](in_t&&) -> out_t { throw std::logic_error("any-bp-error"); })
+            | end());
+    }
+    return any_bp_t();
+}
+
+int test_runtime_selection() {
+    int failed = 0;
+    const char* names[] = {"double", "async", "fail"};
+    std::vector<any_bp_t> bps;
+    for (const char* name : names) {
+        bps.push_back(pick_pipeline(name));
+    }
+
+    run_observer obs[3];
+    for (size_t i = 0; i < bps.size(); ++i) {
+        auto runner = make_runner(bps[i], int_receiver{&obs[i]});
+        runner(5);
+    }
+
+    check(obs[0].calls == 1 && obs[0].has_value && obs[0].value == 10, "sync pipeline through any_runner", failed);
+    check(obs[1].calls == 1 && obs[1].has_value && obs[1].value == 48, "async pipeline through any_runner", failed);
+    check(obs[2].calls == 1 && !obs[2].has_value, "failing pipeline delivers its error", failed);
+    return failed;
+}
+
+int test_runner_reuse_and_input_overloads() {
+    int failed = 0;
+    run_observer obs;
+    auto runner = make_runner(pick_pipeline("async"), int_receiver{&obs});
+
+    runner(1);
+    const in_t in(value_tag, 2);
+    runner(in);
+    runner(in_t(value_tag, 3));
+
+    check(obs.calls == 3, "any_runner can be run repeatedly", failed);
+    check(obs.value == (3 + 10 + 1) * 3, "any_runner accepts args, const and rvalue results", failed);
+    return failed;
+}
+
+int test_copies_share_blueprint() {
+    int failed = 0;
+    auto bp = pick_pipeline("double");
+    any_bp_t copy = bp;
+    any_bp_t moved = std::move(bp);
+
+    run_observer a;
+    run_observer b;
+    make_runner(copy, int_receiver{&a})(4);
+    make_runner(moved, int_receiver{&b})(6);
+
+    check(a.value == 8 && b.value == 12, "copied and moved any_blueprint still run", failed);
+    check(!bp, "moved-from any_blueprint is empty", failed);
+    return failed;
+}
+
+int test_empty_blueprint() {
+    int failed = 0;
+    run_observer obs;
+    auto runner = make_runner(pick_pipeline("unknown"), int_receiver{&obs});
+    runner(1);
+
+    check(!runner, "empty any_blueprint makes an empty runner", failed);
+    check(obs.calls == 0, "running an empty any_runner is a no-op", failed);
+    return failed;
+}
+
+int test_without_receiver() {
+    int failed = 0;
+    auto runner = make_runner(pick_pipeline("double"));
+    runner(1);
+    check(static_cast<bool>(runner), "any_runner without a receiver runs", failed);
+    return failed;
+}
+} // namespace
+
+int main() {
+    int failed = 0;
+    failed += test_runtime_selection();
+    failed += test_runner_reuse_and_input_overloads();
+    failed += test_copies_share_blueprint();
+    failed += test_empty_blueprint();
+    failed += test_without_receiver();
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] flow any_blueprint test passed\n");
+    return 0;
+}
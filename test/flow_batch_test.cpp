@@ -0,0 +1,279 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "executor/simple_executor.h"
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using item_t = result_t<int, err_t>;
+using batch_t = batch_ptr<item_t, 8>;
+using done_t = result_t<void, err_t>;
+
+// collects the flushed batches, one entry per sink run.
+struct batch_log {
+    std::mutex mtx;
+    std::vector<std::vector<int>> batches;
+    std::atomic<int> items{0};
+    std::atomic<int> errors{0};
+    std::atomic<int> off_thread{0};
+    std::thread::id flush_thread;
+};
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+template <typename BP>
+auto share(BP&& bp) {
+    return make_lite_ptr<std::decay_t<BP>>(std::forward<BP>(bp));
+}
+
+// runs every dispatched task right away, on the calling thread.
+struct manual_executor {
+    std::vector<task_wrapper_sbo> tasks;
+
+    void dispatch(task_wrapper_sbo&& t) noexcept {
+        tasks.emplace_back(std::move(t));
+    }
+
+    size_t run_all() {
+        size_t n = tasks.size();
+        for (auto& t : tasks) {
+            t();
+        }
+        tasks.clear();
+        return n;
+    }
+};
+
+auto make_sink(batch_log* log) {
+    return share(make_blueprint<batch_t>()
+        | transform([log](batch_t&& b) noexcept {
+            std::vector<int> values;
+            for (size_t i = 0; i < b->size(); ++i) {
+                if ((*b)[i].has_value()) {
+                    values.push_back((*b)[i].value());
+                } else {
+                    log->errors.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            if (std::this_thread::get_id() != log->flush_thread) {
+                log->off_thread.fetch_add(1, std::memory_order_relaxed);
+            }
+            log->items.fetch_add(static_cast<int>(b->size()), std::memory_order_release);
+            std::lock_guard<std::mutex> lk(log->mtx);
+            log->batches.push_back(std::move(values));
+        })
+        | end());
+}
+
+int test_size_flush() {
+    int failed = 0;
+    batch_log log;
+    log.flush_thread = std::this_thread::get_id();
+    manual_executor ex;
+
+    auto batcher = make_batcher(3, std::chrono::hours(1), &ex, make_sink(&log));
+    auto bp = share(make_blueprint<int>() | batch(batcher) | end());
+
+    for (int i = 0; i < 7; ++i) {
+        auto runner = make_runner(bp);
+        runner(i);
+    }
+    check(ex.tasks.size() == 2, "a batch is flushed every n items", failed);
+    check(log.batches.empty(), "flush runs on the flush executor", failed);
+
+    ex.run_all();
+    check(log.batches == std::vector<std::vector<int>>({{0, 1, 2}, {3, 4, 5}}),
+        "batches keep the push order", failed);
+
+    batcher->flush();
+    ex.run_all();
+    check(log.batches.size() == 3 && log.batches[2] == std::vector<int>({6}),
+        "flush forwards a partial batch", failed);
+    check(!batcher->flush(), "nothing left to flush", failed);
+    return failed;
+}
+
+int test_delay_flush() {
+    int failed = 0;
+    batch_log log;
+    log.flush_thread = std::this_thread::get_id();
+    manual_executor ex;
+
+    auto batcher = make_batcher(8, std::chrono::milliseconds(20), &ex, make_sink(&log));
+    auto bp = share(make_blueprint<int>() | batch(batcher) | end());
+
+    auto runner = make_runner(bp);
+    runner(1);
+    runner = make_runner(bp);
+    runner(2);
+    check(!batcher->poll(), "a young batch is not flushed by poll", failed);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    check(batcher->poll(), "poll flushes a batch older than max_delay", failed);
+    ex.run_all();
+    check(log.batches == std::vector<std::vector<int>>({{1, 2}}), "expired batch carries its items", failed);
+
+    runner = make_runner(bp);
+    runner(3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    runner = make_runner(bp);
+    runner(4);
+    ex.run_all();
+    check(log.batches.size() == 2 && log.batches[1] == std::vector<int>({3, 4}),
+        "a push into an expired batch flushes it", failed);
+    return failed;
+}
+
+int test_errors_are_batched() {
+    int failed = 0;
+    batch_log log;
+    log.flush_thread = std::this_thread::get_id();
+    manual_executor ex;
+
+    struct done_receiver {
+        using value_type = done_t;
+        done_t* out;
+        void emplace(value_type&& r) noexcept {
+            *out = std::move(r);
+        }
+    };
+
+    {
+        auto batcher = make_batcher(2, std::chrono::hours(1), &ex, make_sink(&log));
+        auto bp = share(make_blueprint<int>() | batch(batcher) | end());
+
+        done_t out(error_tag, nullptr);
+        auto runner = make_runner(bp, done_receiver{&out});
+        runner(item_t(error_tag, std::make_exception_ptr(std::logic_error("upstream"))));
+        check(out.has_value(), "queuing an error result succeeds", failed);
+        runner = make_runner(bp, done_receiver{&out});
+        runner(5);
+        ex.run_all();
+        check(log.errors.load() == 1 && log.batches == std::vector<std::vector<int>>({{5}}),
+            "error results travel inside the batch", failed);
+
+        runner = make_runner(bp, done_receiver{&out});
+        runner(6);
+        check(ex.tasks.empty(), "a partial batch stays open", failed);
+    }
+
+    ex.run_all();
+    check(log.batches.size() == 2 && log.batches[1] == std::vector<int>({6}),
+        "destroying the batcher flushes the open batch", failed);
+    return failed;
+}
+
+struct executor_env {
+    simple_executor<1024> ex;
+    std::thread worker;
+
+    executor_env()
+        : worker([this]() noexcept { ex.run(); }) {
+    }
+
+    ~executor_env() {
+        for (int i = 0; i < 200000; ++i) {
+            if (ex.try_shutdown()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+int test_concurrent_producers() {
+    int failed = 0;
+    constexpr int threads = 4;
+    constexpr int per_thread = 20000;
+
+    executor_env env;
+    batch_log log;
+    log.flush_thread = env.worker.get_id();
+
+    {
+        auto batcher = make_batcher(8, std::chrono::milliseconds(1), &env.ex, make_sink(&log));
+        auto bp = share(make_blueprint<int>() | batch(batcher) | end());
+
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threads; ++t) {
+            producers.emplace_back([&, t]() {
+                for (int i = 0; i < per_thread; ++i) {
+                    auto runner = make_runner(bp);
+                    runner(t * per_thread + i);
+                }
+            });
+        }
+        for (auto& p : producers) {
+            p.join();
+        }
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    while (log.items.load(std::memory_order_acquire) != threads * per_thread) {
+        std::this_thread::yield();
+        if (std::chrono::steady_clock::now() - begin > std::chrono::seconds(10)) {
+            std::printf("[FAIL] batches were not flushed\n");
+            std::abort();
+        }
+    }
+
+    std::vector<int> seen(threads * per_thread, 0);
+    bool sized = true;
+    {
+        std::lock_guard<std::mutex> lk(log.mtx);
+        for (auto& b : log.batches) {
+            sized = sized && !b.empty() && b.size() <= 8;
+            for (int v : b) {
+                ++seen[v];
+            }
+        }
+    }
+
+    bool exactly_once = true;
+    for (int c : seen) {
+        exactly_once = exactly_once && c == 1;
+    }
+    check(exactly_once, "every item lands in exactly one batch", failed);
+    check(sized, "no batch exceeds n items", failed);
+    check(log.off_thread.load() == 0, "every batch is flushed on the flush executor", failed);
+    return failed;
+}
+
+} // namespace
+
+int main() {
+    int failed = 0;
+
+    failed += test_size_flush();
+    failed += test_delay_flush();
+    failed += test_errors_are_batched();
+    failed += test_concurrent_producers();
+
+    if (failed == 0) {
+        std::printf("[PASS] batch test passed\n");
+        return 0;
+    }
+
+    std::printf("[FAIL] batch test failed with %d failures\n", failed);
+    return 1;
+}
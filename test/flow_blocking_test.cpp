@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#include "executor/blocking_pool.h"
+#include "executor/simple_executor.h"
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using in_t = result_t<int, err_t>;
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+struct executor_env {
+    simple_executor<1024> ex;
+    std::thread worker;
+
+    executor_env()
+        : worker([this]() noexcept { ex.run(); }) {
+    }
+
+    ~executor_env() {
+        for (int i = 0; i < 200000; ++i) {
+            if (ex.try_shutdown()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+struct flow_log {
+    std::atomic<int> done{0};
+    std::atomic<int> sum{0};
+    std::atomic<int> errors{0};
+    std::atomic<int> wrong_thread{0};
+    std::thread::id expected_thread;
+};
+
+struct log_receiver {
+    using value_type = in_t;
+    flow_log* log;
+
+    void emplace(value_type&& r) noexcept {
+        if (log->expected_thread != std::thread::id() && std::this_thread::get_id() != log->expected_thread) {
+            log->wrong_thread.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (r.has_value()) {
+            log->sum.fetch_add(r.value(), std::memory_order_relaxed);
+        } else {
+            log->errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        log->done.fetch_add(1, std::memory_order_release);
+    }
+};
+
+void wait_for(flow_log& log, int n) {
+    auto begin = std::chrono::steady_clock::now();
+    while (log.done.load(std::memory_order_acquire) != n) {
+        std::this_thread::yield();
+        if (std::chrono::steady_clock::now() - begin > std::chrono::seconds(10)) {
+            std::printf("[FAIL] blocking flows did not complete\n");
+            std::abort();
+        }
+    }
+}
+
+template <typename BP>
+auto share(BP&& bp) {
+    return make_lite_ptr<std::decay_t<BP>>(std::forward<BP>(bp));
+}
+
+int test_offload_and_resume() {
+    int failed = 0;
+    executor_env env;
+    blocking_pool<> pool(2);
+    flow_log log;
+    log.expected_thread = env.worker.get_id();
+
+    std::atomic<int> on_caller{0};
+    const auto caller = std::this_thread::get_id();
+    auto bp = share(make_blueprint<int>()
+        | await_blocking([&on_caller, caller](int v) noexcept {
+            if (std::this_thread::get_id() == caller) {
+                on_caller.fetch_add(1, std::memory_order_relaxed);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            return v * 2;
+        }, &pool, &env.ex)
+        | end());
+
+    for (int i = 1; i <= 4; ++i) {
+        auto runner = make_runner(bp, log_receiver{&log});
+        runner(i);
+    }
+    wait_for(log, 4);
+
+    check(log.sum.load() == 20, "blocking results reach the flow", failed);
+    check(on_caller.load() == 0, "blocking calls run off the calling thread", failed);
+    check(log.wrong_thread.load() == 0, "blocking flows resume on the requested executor", failed);
+    return failed;
+}
+
+int test_thread_cap() {
+    int failed = 0;
+    blocking_pool<> pool(2);
+    flow_log log;
+
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    auto bp = share(make_blueprint<int>()
+        | await_blocking([&running, &peak](int v) noexcept {
+            int now = running.fetch_add(1, std::memory_order_acq_rel) + 1;
+            int seen = peak.load(std::memory_order_relaxed);
+            while (now > seen && !peak.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            running.fetch_sub(1, std::memory_order_acq_rel);
+            return v;
+        }, &pool)
+        | end());
+
+    for (int i = 0; i < 8; ++i) {
+        auto runner = make_runner(bp, log_receiver{&log});
+        runner(1);
+    }
+    check(pool.threads() <= 2, "blocking pool never exceeds max_threads", failed);
+    wait_for(log, 8);
+
+    check(log.sum.load() == 8, "every capped call completes", failed);
+    check(peak.load() == 2, "blocking calls run concurrently up to the cap", failed);
+    return failed;
+}
+
+int test_idle_shrink() {
+    int failed = 0;
+    blocking_pool<> pool(3, std::chrono::milliseconds(20));
+    flow_log log;
+
+    auto bp = share(make_blueprint<int>()
+        | await_blocking([](int v) noexcept { return v + 1; }, &pool)
+        | end());
+
+    for (int i = 0; i < 3; ++i) {
+        auto runner = make_runner(bp, log_receiver{&log});
+        runner(i);
+    }
+    wait_for(log, 3);
+    check(pool.threads() >= 1, "blocking pool starts workers on demand", failed);
+
+    auto begin = std::chrono::steady_clock::now();
+    while (pool.threads() != 0 && std::chrono::steady_clock::now() - begin < std::chrono::seconds(2)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    check(pool.threads() == 0, "idle workers exit after keep_alive", failed);
+
+    auto runner = make_runner(bp, log_receiver{&log});
+    runner(10);
+    wait_for(log, 4);
+    check(log.sum.load() == 1 + 2 + 3 + 11, "blocking pool restarts workers after shrinking", failed);
+    return failed;
+}
+
+int test_error_skips_call() {
+    int failed = 0;
+    blocking_pool<> pool(1);
+    flow_log log;
+    log.expected_thread = std::this_thread::get_id();
+
+    std::atomic<int> calls{0};
+    auto bp = share(make_blueprint<int>()
+        | await_blocking([&calls](int v) noexcept {
+            calls.fetch_add(1, std::memory_order_relaxed);
+            return v;
+        }, &pool)
+        | end());
+
+    auto runner = make_runner(bp, log_receiver{&log});
+    runner(in_t(error_tag, std::make_exception_ptr(std::logic_error("upstream"))));
+    wait_for(log, 1);
+    check(log.errors.load() == 1 && calls.load() == 0, "error input skips the blocking call", failed);
+    check(log.wrong_thread.load() == 0, "error input does not hop to the pool", failed);
+    return failed;
+}
+
+} // namespace
+
+int main() {
+    int failed = 0;
+
+    failed += test_offload_and_resume();
+    failed += test_thread_cap();
+    failed += test_idle_shrink();
+    failed += test_error_skips_call();
+
+    if (failed == 0) {
+        std::printf("[PASS] blocking test passed\n");
+        return 0;
+    }
+
+    std::printf("[FAIL] blocking test failed with %d failures\n", failed);
+    return 1;
+}
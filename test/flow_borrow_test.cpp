@@ -0,0 +1,160 @@
+#include <cstdio>
+#include <exception>
+#include <utility>
+#include <vector>
+
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using out_t = result_t<long long, err_t>;
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+int g_copies = 0;
+
+// stands in for a large decoded snapshot, counts every copy made of it.
+struct book_snapshot {
+    std::vector<long long> levels;
+
+    explicit book_snapshot(size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            levels.push_back(static_cast<long long>(i + 1));
+        }
+    }
+
+    book_snapshot(const book_snapshot& rhs)
+        : levels(rhs.levels) {
+        ++g_copies;
+    }
+
+    book_snapshot(book_snapshot&&) noexcept = default;
+};
+
+long long depth_sum(const book_snapshot& b) noexcept {
+    long long s = 0;
+    for (long long v : b.levels) {
+        s += v;
+    }
+    return s;
+}
+
+struct plus_one_awaitable final : awaitable_base<plus_one_awaitable, long long, err_t> {
+    using async_result_type = out_t;
+    long long v;
+
+    explicit plus_one_awaitable(async_result_type&& in) noexcept
+        : v(in.has_value() ? in.value() : 0) {
+    }
+
+    int submit() noexcept {
+        this->resume(async_result_type(value_tag, v + 1));
+        return 0;
+    }
+
+    void cancel() noexcept {}
+};
+
+struct run_observer {
+    int calls = 0;
+    long long value = 0;
+};
+
+struct sum_receiver {
+    using value_type = out_t;
+    run_observer* obs;
+
+    void emplace(value_type&& r) noexcept {
+        ++obs->calls;
+        obs->value = r.has_value() ? r.value() : -1;
+    }
+};
+
+int test_calc_prefix_reads_in_place() {
+    int failed = 0;
+    book_snapshot book(1000);
+    g_copies = 0;
+
+    auto bp = make_borrowing_blueprint<book_snapshot>()
+        | transform([](const book_snapshot& b) noexcept { return depth_sum(b); })
+        | transform([](long long s) noexcept { return s * 2; })
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+
+    run_observer obs;
+    auto runner = make_runner(bp_ptr, sum_receiver{&obs});
+    runner(book);
+
+    check(obs.calls == 1 && obs.value == 1000LL * 1001, "borrowed run delivers its result", failed);
+    check(g_copies == 0, "borrowed run does not copy the input", failed);
+
+    // the view reads the caller's object as it is at run time.
+    book.levels[0] += 100;
+    runner(book);
+    check(obs.value == (1000LL * 1001) + 200, "borrowed run sees the caller's current object", failed);
+    return failed;
+}
+
+int test_fast_runner_borrowed() {
+    int failed = 0;
+    book_snapshot book(64);
+    g_copies = 0;
+
+    auto bp = make_borrowing_blueprint<book_snapshot>()
+        | transform([](borrowed<book_snapshot> b) noexcept { return static_cast<long long>(b->levels.size()); })
+        | end();
+
+    run_observer obs;
+    auto runner = make_fast_runner_view(bp, sum_receiver{&obs});
+    runner(book);
+
+    check(obs.calls == 1 && obs.value == 64, "fast_runner borrowed run delivers its result", failed);
+    check(g_copies == 0, "fast_runner borrowed run does not copy the input", failed);
+    return failed;
+}
+
+int test_owned_before_async() {
+    int failed = 0;
+    book_snapshot book(10);
+    g_copies = 0;
+
+    // the calc prefix reduces the borrowed view to an owned value, which may then cross the async step.
+    auto bp = make_borrowing_blueprint<book_snapshot>()
+        | transform([](const book_snapshot& b) noexcept { return depth_sum(b); })
+        | await<plus_one_awaitable>()
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+
+    run_observer obs;
+    auto runner = make_runner(bp_ptr, sum_receiver{&obs});
+    runner(book);
+
+    check(obs.calls == 1 && obs.value == 56, "owned value crosses the async step", failed);
+    check(g_copies == 0, "reducing the borrowed input does not copy it", failed);
+    return failed;
+}
+} // namespace
+
+int main() {
+    int failed = 0;
+    failed += test_calc_prefix_reads_in_place();
+    failed += test_fast_runner_borrowed();
+    failed += test_owned_before_async();
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] flow borrow test passed\n");
+    return 0;
+}
@@ -0,0 +1,361 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "executor/simple_executor.h"
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using in_t = result_t<int, err_t>;
+using cache_t = flow_cache<int, int, err_t>;
+
+std::atomic<int> submits{0};
+
+// the backend keeps every request until complete_all(); negative keys fail.
+struct deferred_lookup final : awaitable_base<deferred_lookup, int, err_t> {
+    using async_result_type = in_t;
+    static std::vector<deferred_lookup*> pending;
+
+    int v;
+
+    explicit deferred_lookup(async_result_type&& in) noexcept
+        : v(in.has_value() ? in.value() : 0) {
+    }
+
+    int submit() noexcept {
+        submits.fetch_add(1, std::memory_order_relaxed);
+        this->retain();
+        pending.push_back(this);
+        return 0;
+    }
+
+    void cancel() noexcept {
+    }
+
+    static void complete_all() noexcept {
+        auto batch = std::move(pending);
+        pending.clear();
+        for (auto p : batch) {
+            if (p->v < 0) {
+                p->resume(async_result_type(error_tag, std::make_exception_ptr(std::logic_error("lookup"))));
+            } else {
+                p->resume(async_result_type(value_tag, p->v * 100));
+            }
+            p->release();
+        }
+    }
+};
+
+std::vector<deferred_lookup*> deferred_lookup::pending;
+
+struct inline_lookup final : awaitable_base<inline_lookup, int, err_t> {
+    using async_result_type = in_t;
+    int v;
+
+    explicit inline_lookup(async_result_type&& in) noexcept
+        : v(in.has_value() ? in.value() : 0) {
+    }
+
+    int submit() noexcept {
+        submits.fetch_add(1, std::memory_order_relaxed);
+        this->resume(async_result_type(value_tag, v * 100));
+        return 0;
+    }
+
+    void cancel() noexcept {
+    }
+};
+
+struct identity_key {
+    int operator()(int v) const noexcept {
+        return v;
+    }
+};
+
+struct result_log {
+    std::vector<int> values;
+    int errors = 0;
+};
+
+struct log_receiver {
+    using value_type = in_t;
+    result_log* log;
+
+    void emplace(value_type&& r) noexcept {
+        if (r.has_value()) {
+            log->values.push_back(r.value());
+        } else {
+            ++log->errors;
+        }
+    }
+};
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+template <typename BP>
+auto share(BP&& bp) {
+    return make_lite_ptr<std::decay_t<BP>>(std::forward<BP>(bp));
+}
+
+template <typename BP>
+void run(const lite_ptr<BP>& bp, result_log* log, int v) {
+    auto runner = make_runner(bp, log_receiver{log});
+    runner(v);
+}
+
+int test_coalesce_and_hit() {
+    int failed = 0;
+    submits = 0;
+    cache_t cache(64);
+    result_log log;
+
+    auto bp = share(make_blueprint<int>() | cached<deferred_lookup>(cache, identity_key{}) | end());
+    run(bp, &log, 1);
+    run(bp, &log, 1);
+    run(bp, &log, 1);
+    check(submits.load() == 1, "concurrent misses submit the backend once", failed);
+    check(log.values.empty(), "coalesced flows wait for the leader", failed);
+
+    deferred_lookup::complete_all();
+    check(log.values == std::vector<int>({100, 100, 100}), "every coalesced flow resumes with the result", failed);
+
+    run(bp, &log, 1);
+    check(submits.load() == 1 && log.values.size() == 4 && log.values[3] == 100, "a cached key is a hit", failed);
+
+    auto st = cache.stats();
+    check(st.misses == 1 && st.coalesced == 2 && st.hits == 1, "hit/miss/coalesce counters", failed);
+    return failed;
+}
+
+int test_ttl() {
+    int failed = 0;
+    submits = 0;
+    cache_t cache(64, std::chrono::milliseconds(20));
+    result_log log;
+
+    auto bp = share(make_blueprint<int>() | cached<inline_lookup>(cache, identity_key{}) | end());
+    run(bp, &log, 2);
+    run(bp, &log, 2);
+    check(submits.load() == 1, "a fresh value is served from the cache", failed);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    run(bp, &log, 2);
+    check(submits.load() == 2, "an expired value is recomputed", failed);
+    check(log.values == std::vector<int>({200, 200, 200}), "ttl does not change the result", failed);
+    return failed;
+}
+
+int test_clock_eviction() {
+    int failed = 0;
+    submits = 0;
+    flow_cache<int, int, err_t, 1> cache(2);
+    result_log log;
+
+    auto bp = share(make_blueprint<int>() | cached<inline_lookup>(cache, identity_key{}) | end());
+    run(bp, &log, 1);
+    run(bp, &log, 2);
+    run(bp, &log, 1);   // referenced, gets a second chance
+    run(bp, &log, 3);   // evicts 2
+    check(cache.stats().evictions == 1, "a full shard evicts one value", failed);
+
+    submits = 0;
+    run(bp, &log, 1);
+    check(submits.load() == 0, "a recently hit value survives the sweep", failed);
+    run(bp, &log, 2);
+    check(submits.load() == 1, "the unreferenced value is evicted", failed);
+
+    cache.invalidate(3);
+    run(bp, &log, 3);
+    check(submits.load() == 2, "invalidate drops a cached value", failed);
+    return failed;
+}
+
+int test_errors_not_cached() {
+    int failed = 0;
+    submits = 0;
+    cache_t cache(64);
+    result_log log;
+
+    auto bp = share(make_blueprint<int>() | cached<deferred_lookup>(cache, identity_key{}) | end());
+    run(bp, &log, -1);
+    run(bp, &log, -1);
+    deferred_lookup::complete_all();
+    check(log.errors == 2 && submits.load() == 1, "coalesced flows share the error", failed);
+
+    run(bp, &log, -1);
+    deferred_lookup::complete_all();
+    check(log.errors == 3 && submits.load() == 2, "errors are not cached", failed);
+
+    auto failing = make_runner(bp, log_receiver{&log});
+    failing(in_t(error_tag, std::make_exception_ptr(std::logic_error("upstream"))));
+    check(log.errors == 4 && submits.load() == 2, "error input passes through", failed);
+    return failed;
+}
+
+int test_cancel_coalesced() {
+    int failed = 0;
+    submits = 0;
+    cache_t cache(64);
+    result_log leader_log;
+    result_log joined_log;
+
+    auto bp = share(make_blueprint<int>() | cached<deferred_lookup>(cache, identity_key{}) | end());
+    auto leader = make_runner(bp, log_receiver{&leader_log});
+    leader(7);
+    auto joined = make_runner(bp, log_receiver{&joined_log});
+    joined(7);
+
+    joined.get_controller()->cancel(true);
+    check(joined_log.errors == 1, "a canceled coalesced flow resumes with an error", failed);
+
+    leader.get_controller()->cancel(true);
+    check(leader_log.errors == 1, "the leader can be canceled too", failed);
+
+    deferred_lookup::complete_all();
+    check(joined_log.errors == 1 && leader_log.values.empty(), "canceled flows are not resumed twice", failed);
+
+    result_log log;
+    run(bp, &log, 7);
+    check(submits.load() == 1 && log.values == std::vector<int>({700}), "the fill completes for the cache", failed);
+    return failed;
+}
+
+struct executor_env {
+    simple_executor<1024> ex;
+    std::thread worker;
+
+    executor_env()
+        : worker([this]() noexcept { ex.run(); }) {
+    }
+
+    ~executor_env() {
+        for (int i = 0; i < 200000; ++i) {
+            if (ex.try_shutdown()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+executor_env* backend = nullptr;
+
+// completes on the executor thread.
+struct remote_lookup final : awaitable_base<remote_lookup, int, err_t> {
+    using async_result_type = in_t;
+    int v;
+
+    explicit remote_lookup(async_result_type&& in) noexcept
+        : v(in.has_value() ? in.value() : 0) {
+    }
+
+    int submit() noexcept {
+        submits.fetch_add(1, std::memory_order_relaxed);
+        this->retain();
+        backend->ex.dispatch(task_wrapper_sbo([this]() noexcept {
+            this->resume(async_result_type(value_tag, v * 100));
+            this->release();
+        }));
+        return 0;
+    }
+
+    void cancel() noexcept {
+    }
+};
+
+int test_concurrent_flows() {
+    int failed = 0;
+    constexpr int threads = 4;
+    constexpr int rounds = 20000;
+    constexpr int keys = 32;
+
+    submits = 0;
+    executor_env env;
+    backend = &env;
+    cache_t cache(1024);
+    std::atomic<int> done{0};
+    std::atomic<int> wrong{0};
+
+    struct check_receiver {
+        using value_type = in_t;
+        std::atomic<int>* done;
+        std::atomic<int>* wrong;
+        int expected;
+
+        void emplace(value_type&& r) noexcept {
+            if (!r.has_value() || r.value() != expected) {
+                wrong->fetch_add(1, std::memory_order_relaxed);
+            }
+            done->fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    auto bp = share(make_blueprint<int>() | cached<remote_lookup>(cache, identity_key{}) | end());
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < rounds; ++i) {
+                int k = (i * 7 + t) % keys;
+                auto runner = make_runner(bp, check_receiver{&done, &wrong, k * 100});
+                runner(k);
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    while (done.load(std::memory_order_acquire) != threads * rounds) {
+        std::this_thread::yield();
+        if (std::chrono::steady_clock::now() - begin > std::chrono::seconds(10)) {
+            std::printf("[FAIL] cached flows did not complete\n");
+            std::abort();
+        }
+    }
+
+    auto st = cache.stats();
+    check(wrong.load() == 0, "every flow gets the value of its key", failed);
+    check(submits.load() == keys && st.misses == static_cast<size_t>(keys), "each key is computed once", failed);
+    check(st.hits + st.misses + st.coalesced == static_cast<size_t>(threads * rounds), "counters add up", failed);
+    return failed;
+}
+
+} // namespace
+
+int main() {
+    int failed = 0;
+
+    failed += test_coalesce_and_hit();
+    failed += test_ttl();
+    failed += test_clock_eviction();
+    failed += test_errors_not_cached();
+    failed += test_cancel_coalesced();
+    failed += test_concurrent_flows();
+
+    if (failed == 0) {
+        std::printf("[PASS] cache test passed\n");
+        return 0;
+    }
+
+    std::printf("[FAIL] cache test failed with %d failures\n", failed);
+    return 1;
+}
@@ -0,0 +1,430 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using out_t = result_t<int, err_t>;
+
+static std::atomic<unsigned long long> g_rng{0x9E3779B97F4A7C15ull};
+
+unsigned fast_rand_u32() noexcept {
+    auto x = g_rng.fetch_add(0x9E3779B97F4A7C15ull, std::memory_order_relaxed);
+    x ^= (x >> 12);
+    x ^= (x << 25);
+    x ^= (x >> 27);
+    return static_cast<unsigned>((x * 2685821657736338717ull) >> 32);
+}
+
+void spin_for_us(unsigned us) {
+    auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(us);
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+struct leaf_counters {
+    std::atomic<int> submitted{0};
+    std::atomic<int> cancel_calls{0};
+    std::atomic<int> by_cancel{0};
+    std::atomic<int> by_deadline{0};
+    std::atomic<int> failed{0};
+    std::atomic<int> inflight{0};
+
+    void reset() noexcept {
+        submitted.store(0, std::memory_order_relaxed);
+        cancel_calls.store(0, std::memory_order_relaxed);
+        by_cancel.store(0, std::memory_order_relaxed);
+        by_deadline.store(0, std::memory_order_relaxed);
+        failed.store(0, std::memory_order_relaxed);
+    }
+};
+
+static leaf_counters g_leaf;
+
+struct parked_leaf_awaitable;
+
+// a single thread that resumes parked leaves once they are canceled or their deadline passed.
+class leaf_ticker {
+public:
+    leaf_ticker()
+        : stopping_(false), worker_([this]() { run(); }) {
+    }
+
+    ~leaf_ticker() {
+        stopping_.store(true, std::memory_order_release);
+        worker_.join();
+    }
+
+    void park(parked_leaf_awaitable* leaf) {
+        std::lock_guard<std::mutex> lk(m_);
+        parked_.push_back(leaf);
+    }
+
+private:
+    void run();
+
+    std::mutex m_;
+    std::vector<parked_leaf_awaitable*> parked_;
+    std::atomic<bool> stopping_;
+    std::thread worker_;
+};
+
+leaf_ticker& ticker() {
+    static leaf_ticker t;
+    return t;
+}
+
+// input >= 0: parks for `input` microseconds, then yields input + 1, unless canceled first.
+// input < 0: fails after a few microseconds.
+struct parked_leaf_awaitable final : awaitable_base<parked_leaf_awaitable, int, err_t> {
+    using async_result_type = out_t;
+
+    int input;
+    std::chrono::steady_clock::time_point deadline;
+    std::atomic<bool> canceled{false};
+
+    explicit parked_leaf_awaitable(async_result_type&& in) noexcept
+        : input(in.has_value() ? in.value() : 0) {
+    }
+
+    int submit() noexcept {
+        this->retain();
+        g_leaf.submitted.fetch_add(1, std::memory_order_relaxed);
+        g_leaf.inflight.fetch_add(1, std::memory_order_relaxed);
+
+        auto us = input < 0 ? 5 : input;
+        deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(us);
+        ticker().park(this);
+        return 0;
+    }
+
+    void cancel() noexcept {
+        g_leaf.cancel_calls.fetch_add(1, std::memory_order_relaxed);
+        canceled.store(true, std::memory_order_release);
+    }
+
+    // called by the ticker only.
+    bool try_finish(std::chrono::steady_clock::time_point now) noexcept {
+        if (canceled.load(std::memory_order_acquire)) {
+            g_leaf.by_cancel.fetch_add(1, std::memory_order_relaxed);
+            this->resume(async_result_type(error_tag, std::make_exception_ptr(std::runtime_error("leaf canceled"))));
+        } else if (now >= deadline) {
+            if (input < 0) {
+                g_leaf.failed.fetch_add(1, std::memory_order_relaxed);
+                this->resume(async_result_type(error_tag, std::make_exception_ptr(std::runtime_error("leaf failed"))));
+            } else {
+                g_leaf.by_deadline.fetch_add(1, std::memory_order_relaxed);
+                this->resume(async_result_type(value_tag, input + 1));
+            }
+        } else {
+            return false;
+        }
+
+        this->release();
+        g_leaf.inflight.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+};
+
+void leaf_ticker::run() {
+    std::vector<parked_leaf_awaitable*> local;
+    while (!stopping_.load(std::memory_order_acquire) || !local.empty()) {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            local.insert(local.end(), parked_.begin(), parked_.end());
+            parked_.clear();
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        size_t kept = 0;
+        for (size_t i = 0; i < local.size(); ++i) {
+            if (!local[i]->try_finish(now)) {
+                local[kept++] = local[i];
+            }
+        }
+        local.resize(kept);
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+}
+
+struct receiver_state {
+    std::atomic<int> done{0};
+    std::atomic<int> has_value{-1};
+};
+
+struct int_receiver {
+    using value_type = out_t;
+
+    std::shared_ptr<receiver_state> st;
+
+    void emplace(value_type&& r) noexcept {
+        st->has_value.store(r.has_value() ? 1 : 0, std::memory_order_relaxed);
+        st->done.fetch_add(1, std::memory_order_release);
+    }
+};
+
+bool wait_until(const std::atomic<int>& v, int expect, int timeout_ms) {
+    auto begin = std::chrono::steady_clock::now();
+    while (v.load(std::memory_order_acquire) != expect) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        auto elapsed = std::chrono::steady_clock::now() - begin;
+        if (std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() > timeout_ms) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto all_of_two() noexcept {
+    return [](int a, int b) noexcept {
+        return out_t(value_tag, a + b);
+    };
+}
+
+auto any_of_two() noexcept {
+    return [](size_t, int x) noexcept {
+        return out_t(value_tag, x);
+    };
+}
+
+auto forward_error() noexcept {
+    return [](flow_async_agg_err_t e) noexcept {
+        return out_t(error_tag, std::move(e));
+    };
+}
+
+// when_any( when_all( when_any( when_all(leaf, leaf) x2 ) x2 ) x2 ), 16 leaves, 7 levels of controllers.
+auto make_tree() {
+    auto leaf = make_blueprint<int>()
+        | await<parked_leaf_awaitable>()
+        | end();
+    auto leaf_p = make_lite_ptr<decltype(leaf)>(std::move(leaf));
+
+    auto l1 = await_when_all(all_of_two(), forward_error(), leaf_p, leaf_p) | end();
+    auto l1_p = make_lite_ptr<decltype(l1)>(std::move(l1));
+
+    auto l2 = await_when_any(any_of_two(), forward_error(), l1_p, l1_p) | end();
+    auto l2_p = make_lite_ptr<decltype(l2)>(std::move(l2));
+
+    auto l3 = await_when_all(all_of_two(), forward_error(), l2_p, l2_p) | end();
+    auto l3_p = make_lite_ptr<decltype(l3)>(std::move(l3));
+
+    auto l4 = await_when_any(any_of_two(), forward_error(), l3_p, l3_p) | end();
+    return make_lite_ptr<decltype(l4)>(std::move(l4));
+}
+
+using tree_ptr_t = decltype(make_tree());
+using tree_t = typename tree_ptr_t::element_type;
+
+// every leaf parks for `us(k)` microseconds, k = 0 .. 15.
+template <typename F>
+auto make_input(F&& us) {
+    auto l1 = [&](int k) { return make_flat_storage(us(k), us(k + 1)); };
+    auto l2 = [&](int k) { return make_flat_storage(l1(k), l1(k + 2)); };
+    auto l3 = [&](int k) { return make_flat_storage(l2(k), l2(k + 4)); };
+    return make_flat_storage(l3(0), l3(8));
+}
+
+struct case_stat {
+    int iterations = 0;
+    int not_reached = 0;
+    int timeout = 0;
+    int duplicate_callback = 0;
+    int unexpected_value = 0;
+    int leaked_leaf = 0;
+    int slow_leaf = 0;
+};
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+void print_stat(const char* name, const case_stat& s) {
+    std::printf("[%s]\n", name);
+    std::printf("  iterations         : %d\n", s.iterations);
+    std::printf("  not_reached        : %d\n", s.not_reached);
+    std::printf("  timeout            : %d\n", s.timeout);
+    std::printf("  duplicate_callback : %d\n", s.duplicate_callback);
+    std::printf("  unexpected_value   : %d\n", s.unexpected_value);
+    std::printf("  leaked_leaf        : %d\n", s.leaked_leaf);
+    std::printf("  slow_leaf          : %d\n", s.slow_leaf);
+}
+
+void finish_iteration(const std::shared_ptr<receiver_state>& st, case_stat& s, bool expect_error) {
+    ++s.iterations;
+    if (!wait_until(st->done, 1, 1000)) {
+        ++s.timeout;
+        return;
+    }
+    if (!wait_until(g_leaf.inflight, 0, 1000)) {
+        ++s.leaked_leaf;
+    }
+    if (st->done.load(std::memory_order_acquire) != 1) {
+        ++s.duplicate_callback;
+    }
+    if (expect_error && st->has_value.load(std::memory_order_relaxed) != 0) {
+        ++s.unexpected_value;
+    }
+}
+
+// a cancel on the root reaches every parked leaf, several levels down, long before their deadline.
+// the when_all/when_any awaitables only unlink their group on cancel, so the leaves are reached
+// through the controller tree, within the root's cancel() call.
+case_stat root_cancel_case(const tree_ptr_t& bp, int iters) {
+    case_stat s;
+    for (int i = 0; i < iters; ++i) {
+        g_leaf.reset();
+        auto ctrl = make_lite_ptr<flow_controller>();
+        auto st = std::make_shared<receiver_state>();
+
+        flow_runner<tree_t, int_receiver> runner(bp, ctrl, int_receiver{st});
+        runner(make_input([](int) { return 2000000; }));
+
+        spin_for_us(fast_rand_u32() % 200);
+        ctrl->cancel((fast_rand_u32() & 1u) != 0u);
+        if (g_leaf.cancel_calls.load(std::memory_order_relaxed) != 16) {
+            ++s.not_reached;
+        }
+
+        finish_iteration(st, s, true);
+        s.slow_leaf += g_leaf.by_deadline.load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+// one failing leaf per inner when_all: each failure cancels its sibling through the group
+// controller, the failures bubble up and the whole tree ends without any leaf reaching its deadline.
+case_stat inner_failure_case(const tree_ptr_t& bp, int iters) {
+    case_stat s;
+    for (int i = 0; i < iters; ++i) {
+        g_leaf.reset();
+        auto ctrl = make_lite_ptr<flow_controller>();
+        auto st = std::make_shared<receiver_state>();
+
+        flow_runner<tree_t, int_receiver> runner(bp, ctrl, int_receiver{st});
+        runner(make_input([](int k) { return (k & 1) ? -1 : 2000000; }));
+
+        finish_iteration(st, s, true);
+        s.slow_leaf += g_leaf.by_deadline.load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+// short random parks against a concurrent cancel from another thread: exactly one callback, no leak.
+case_stat racing_cancel_case(const tree_ptr_t& bp, int iters) {
+    case_stat s;
+    for (int i = 0; i < iters; ++i) {
+        g_leaf.reset();
+        auto ctrl = make_lite_ptr<flow_controller>();
+        auto st = std::make_shared<receiver_state>();
+
+        flow_runner<tree_t, int_receiver> runner(bp, ctrl, int_receiver{st});
+        std::thread canceler([ctrl]() {
+            spin_for_us(fast_rand_u32() % 300);
+            ctrl->cancel((fast_rand_u32() & 1u) != 0u);
+        });
+        runner(make_input([](int) { return static_cast<int>(fast_rand_u32() % 300); }));
+        canceler.join();
+
+        finish_iteration(st, s, false);
+    }
+    return s;
+}
+
+constexpr int kChainDepth = 8;
+
+// runners at depth 0 .. kChainDepth - 1 whose controllers are linked only by attach_child. no awaitable
+// sits between two levels, so the root cancel() can reach the deepest runner through the tree alone.
+case_stat chain_cancel_case(int iters) {
+    auto leaf = make_blueprint<int>()
+        | await<parked_leaf_awaitable>()
+        | end();
+    auto leaf_p = make_lite_ptr<decltype(leaf)>(std::move(leaf));
+    using leaf_t = decltype(leaf);
+
+    case_stat s;
+    for (int i = 0; i < iters; ++i) {
+        g_leaf.reset();
+        flow_controller levels[kChainDepth];
+        std::shared_ptr<receiver_state> states[kChainDepth];
+        for (int d = 0; d < kChainDepth; ++d) {
+            if (d > 0) {
+                levels[d - 1].attach_child(&levels[d]);
+            }
+            states[d] = std::make_shared<receiver_state>();
+            flow_runner<leaf_t, int_receiver, flow_controller*> runner(leaf_p, &levels[d], int_receiver{states[d]});
+            runner(2000000);
+        }
+
+        levels[0].cancel((fast_rand_u32() & 1u) != 0u);
+        if (!levels[kChainDepth - 1].is_canceled() || g_leaf.cancel_calls.load(std::memory_order_relaxed) != kChainDepth) {
+            ++s.not_reached;
+        }
+
+        for (int d = 0; d < kChainDepth; ++d) {
+            finish_iteration(states[d], s, true);
+        }
+        s.slow_leaf += g_leaf.by_deadline.load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+int arg_or_default(char** argv, int argc, int index, int fallback) {
+    if (index >= argc) {
+        return fallback;
+    }
+    const int v = std::atoi(argv[index]);
+    return v > 0 ? v : fallback;
+}
+
+bool clean(const case_stat& s, bool allow_slow) {
+    return s.not_reached == 0 && s.timeout == 0 && s.duplicate_callback == 0 && s.unexpected_value == 0
+        && s.leaked_leaf == 0 && (allow_slow || s.slow_leaf == 0);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int iters = arg_or_default(argv, argc, 1, 2000);
+    auto bp = make_tree();
+
+    auto t1 = root_cancel_case(bp, iters);
+    auto t2 = inner_failure_case(bp, iters);
+    auto t3 = racing_cancel_case(bp, iters);
+    auto t4 = chain_cancel_case(iters);
+
+    print_stat("root cancel", t1);
+    print_stat("inner failure", t2);
+    print_stat("racing cancel", t3);
+    print_stat("controller chain", t4);
+
+    int failed = 0;
+    check(clean(t1, false), "root cancel reaches every nested leaf", failed);
+    check(clean(t2, false), "inner failure cancels the rest of the tree", failed);
+    check(clean(t3, true), "racing cancel completes exactly once", failed);
+    check(clean(t4, false), "root cancel reaches depth-N runners through the tree alone", failed);
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] flow cancel tree stress passed\n");
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using out_t = result_t<int, err_t>;
+using done_t = result_t<void, err_t>;
+using channel_t = async_channel<int, 4>;
+
+constexpr int producers = 2;
+constexpr int consumers = 2;
+constexpr int per_producer = 100000;
+
+static std::atomic<unsigned long long> g_rng{0x9E3779B97F4A7C15ull};
+
+unsigned fast_rand_u32() noexcept {
+    auto x = g_rng.fetch_add(0x9E3779B97F4A7C15ull, std::memory_order_relaxed);
+    x ^= (x >> 12);
+    x ^= (x << 25);
+    x ^= (x >> 27);
+    return static_cast<unsigned>((x * 2685821657736338717ull) >> 32);
+}
+
+void spin_for_us(unsigned us) {
+    auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(us);
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+// 0: pending, 1: value, 2: error
+struct completion {
+    std::atomic<int> state{0};
+    int value = -1;
+};
+
+struct send_receiver {
+    using value_type = done_t;
+
+    std::shared_ptr<completion> c;
+
+    void emplace(value_type&& r) noexcept {
+        c->state.store(r.has_value() ? 1 : 2, std::memory_order_release);
+    }
+};
+
+struct recv_receiver {
+    using value_type = out_t;
+
+    std::shared_ptr<completion> c;
+
+    void emplace(value_type&& r) noexcept {
+        if (r.has_value()) {
+            c->value = r.value();
+            c->state.store(1, std::memory_order_release);
+        } else {
+            c->state.store(2, std::memory_order_release);
+        }
+    }
+};
+
+int wait_for(const completion& c) {
+    int s;
+    while ((s = c.state.load(std::memory_order_acquire)) == 0) {
+        std::this_thread::yield();
+    }
+    return s;
+}
+
+// about half of the flows are canceled a few microseconds after they are started,
+// which races the cancel against the peer handing them a permit.
+template <typename Runner>
+void maybe_cancel(Runner& runner) {
+    auto r = fast_rand_u32();
+    if (r & 1) {
+        spin_for_us((r >> 1) % 3);
+        runner.get_controller()->cancel(true);
+    }
+}
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+template <typename BP>
+auto share(BP&& bp) {
+    return make_lite_ptr<std::decay_t<BP>>(std::forward<BP>(bp));
+}
+
+int test_cancel_races_send_and_recv() {
+    int failed = 0;
+    constexpr int total = producers * per_producer;
+
+    channel_t ch;
+    std::unique_ptr<std::atomic<int>[]> sent(new std::atomic<int>[total]);
+    std::unique_ptr<std::atomic<int>[]> received(new std::atomic<int>[total]);
+    for (int i = 0; i < total; ++i) {
+        sent[i].store(0, std::memory_order_relaxed);
+        received[i].store(0, std::memory_order_relaxed);
+    }
+    std::atomic<int> send_canceled{0};
+    std::atomic<int> recv_canceled{0};
+
+    auto send_bp = share(make_blueprint<int>() | await_send(ch) | end());
+    auto recv_bp = share(make_blueprint<int>() | await_recv(ch) | end());
+
+    std::vector<std::thread> receivers;
+    for (int c = 0; c < consumers; ++c) {
+        receivers.emplace_back([&]() {
+            for (;;) {
+                auto done = std::make_shared<completion>();
+                auto runner = make_runner(recv_bp, recv_receiver{done});
+                runner(0);
+                maybe_cancel(runner);
+                if (wait_for(*done) == 1) {
+                    received[done->value].fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                if (ch.is_closed()) {
+                    return;
+                }
+                recv_canceled.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    std::vector<std::thread> senders;
+    for (int p = 0; p < producers; ++p) {
+        senders.emplace_back([&, p]() {
+            for (int i = 0; i < per_producer; ++i) {
+                const int v = p * per_producer + i;
+                auto done = std::make_shared<completion>();
+                auto runner = make_runner(send_bp, send_receiver{done});
+                runner(v);
+                maybe_cancel(runner);
+                if (wait_for(*done) == 1) {
+                    sent[v].store(1, std::memory_order_relaxed);
+                } else {
+                    send_canceled.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (auto& t : senders) {
+        t.join();
+    }
+    ch.close();
+    for (auto& t : receivers) {
+        t.join();
+    }
+
+    // receivers stop at the first error after close, whatever is left is still buffered.
+    for (;;) {
+        auto v = ch.try_recv();
+        if (!v.has_value()) {
+            break;
+        }
+        received[v.get()].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int lost = 0;
+    int duplicated = 0;
+    int phantom = 0;
+    for (int i = 0; i < total; ++i) {
+        auto s = sent[i].load(std::memory_order_relaxed);
+        auto r = received[i].load(std::memory_order_relaxed);
+        if (r > 1) {
+            ++duplicated;
+        } else if (s == 1 && r == 0) {
+            ++lost;
+        } else if (s == 0 && r == 1) {
+            ++phantom;
+        }
+    }
+
+    std::printf("[stat] send canceled=%d recv canceled=%d lost=%d duplicated=%d phantom=%d\n",
+        send_canceled.load(), recv_canceled.load(), lost, duplicated, phantom);
+    check(lost == 0, "every value whose send succeeded is received", failed);
+    check(duplicated == 0, "no value is received twice", failed);
+    check(phantom == 0, "a canceled send does not publish its value", failed);
+    check(send_canceled.load() > 0 && recv_canceled.load() > 0, "cancel actually raced both sides", failed);
+    return failed;
+}
+
+} // namespace
+
+int main() {
+    int failed = 0;
+
+    failed += test_cancel_races_send_and_recv();
+
+    if (failed == 0) {
+        std::printf("[PASS] channel cancel stress passed\n");
+        return 0;
+    }
+
+    std::printf("[FAIL] channel cancel stress failed with %d failures\n", failed);
+    return 1;
+}
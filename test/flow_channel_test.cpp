@@ -0,0 +1,284 @@
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using out_t = result_t<int, err_t>;
+using done_t = result_t<void, err_t>;
+using channel_t = async_channel<int, 2>;
+
+struct recv_log {
+    std::vector<int> values;
+    int errors = 0;
+};
+
+struct recv_receiver {
+    using value_type = out_t;
+
+    recv_log* log;
+
+    void emplace(value_type&& r) noexcept {
+        if (r.has_value()) {
+            log->values.push_back(r.value());
+        } else {
+            ++log->errors;
+        }
+    }
+};
+
+struct send_log {
+    int sent = 0;
+    int errors = 0;
+};
+
+struct send_receiver {
+    using value_type = done_t;
+
+    send_log* log;
+
+    void emplace(value_type&& r) noexcept {
+        if (r.has_value()) {
+            ++log->sent;
+        } else {
+            ++log->errors;
+        }
+    }
+};
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+template <typename BP>
+auto share(BP&& bp) {
+    return make_lite_ptr<std::decay_t<BP>>(std::forward<BP>(bp));
+}
+
+int test_send_parks_when_full() {
+    int failed = 0;
+    channel_t ch;
+    send_log slog;
+    recv_log rlog;
+
+    auto send_bp = share(make_blueprint<int>() | await_send(ch) | end());
+    auto recv_bp = share(make_blueprint<int>() | await_recv(ch) | end());
+
+    for (int i = 0; i < 3; ++i) {
+        auto runner = make_runner(send_bp, send_receiver{&slog});
+        runner(i);
+    }
+    check(slog.sent == 2, "sends beyond capacity park", failed);
+    check(ch.size() == 2, "channel buffers capacity values", failed);
+
+    for (int i = 0; i < 3; ++i) {
+        auto runner = make_runner(recv_bp, recv_receiver{&rlog});
+        runner(0);
+    }
+    check(slog.sent == 3, "recv resumes the parked sender", failed);
+    check(rlog.values == std::vector<int>({0, 1, 2}), "values are received in order", failed);
+    check(ch.size() == 0, "channel is drained", failed);
+    return failed;
+}
+
+int test_recv_parks_when_empty() {
+    int failed = 0;
+    channel_t ch;
+    send_log slog;
+    recv_log rlog;
+
+    auto send_bp = share(make_blueprint<int>() | await_send(ch) | end());
+    auto recv_bp = share(make_blueprint<int>() | await_recv(ch) | end());
+
+    for (int i = 0; i < 2; ++i) {
+        auto runner = make_runner(recv_bp, recv_receiver{&rlog});
+        runner(0);
+    }
+    check(rlog.values.empty(), "recv on empty channel parks", failed);
+
+    for (int i = 0; i < 2; ++i) {
+        auto runner = make_runner(send_bp, send_receiver{&slog});
+        runner(10 + i);
+    }
+    check(rlog.values == std::vector<int>({10, 11}), "send resumes parked receivers in FIFO order", failed);
+    check(ch.size() == 0, "handed-off values do not stay buffered", failed);
+    return failed;
+}
+
+int test_close_propagates_end_of_stream() {
+    int failed = 0;
+    send_log slog;
+    recv_log rlog;
+    {
+        channel_t ch;
+        auto send_bp = share(make_blueprint<int>() | await_send(ch) | end());
+        auto recv_bp = share(make_blueprint<int>() | await_recv(ch) | end());
+
+        for (int i = 0; i < 3; ++i) {
+            auto runner = make_runner(send_bp, send_receiver{&slog});
+            runner(i);
+        }
+        ch.close();
+        check(slog.sent == 2 && slog.errors == 1, "close fails the parked sender", failed);
+
+        auto late = make_runner(send_bp, send_receiver{&slog});
+        late(100);
+        check(slog.errors == 2, "send after close fails", failed);
+
+        for (int i = 0; i < 3; ++i) {
+            auto runner = make_runner(recv_bp, recv_receiver{&rlog});
+            runner(0);
+        }
+        check(rlog.values == std::vector<int>({0, 1}), "buffered values drain after close", failed);
+        check(rlog.errors == 1, "drained channel reports end of stream", failed);
+    }
+    {
+        channel_t ch;
+        recv_log parked;
+        auto recv_bp = share(make_blueprint<int>() | await_recv(ch) | end());
+        auto runner = make_runner(recv_bp, recv_receiver{&parked});
+        runner(0);
+        ch.close();
+        check(parked.errors == 1, "close wakes parked receivers with end of stream", failed);
+    }
+    return failed;
+}
+
+int test_cancel_parked_receiver() {
+    int failed = 0;
+    channel_t ch;
+    send_log slog;
+    recv_log rlog;
+
+    auto send_bp = share(make_blueprint<int>() | await_send(ch) | end());
+    auto recv_bp = share(make_blueprint<int>() | await_recv(ch) | end());
+
+    auto canceled = make_runner(recv_bp, recv_receiver{&rlog});
+    canceled(0);
+    canceled.get_controller()->cancel(true);
+    check(rlog.errors == 1, "canceled receiver resumes with an error", failed);
+
+    auto sender = make_runner(send_bp, send_receiver{&slog});
+    sender(7);
+    check(ch.size() == 1, "value is buffered instead of handed to the canceled receiver", failed);
+
+    auto runner = make_runner(recv_bp, recv_receiver{&rlog});
+    runner(0);
+    check(rlog.values == std::vector<int>({7}), "next receiver gets the value", failed);
+    return failed;
+}
+
+int test_mpmc_pipeline() {
+    int failed = 0;
+    constexpr int producers = 2;
+    constexpr int consumers = 2;
+    constexpr int per_producer = 20000;
+
+    async_channel<int, 8> ch;
+    std::atomic<long long> sum{0};
+    std::atomic<int> received{0};
+
+    struct flag_receiver {
+        using value_type = done_t;
+        std::atomic<int>* done;
+        void emplace(value_type&&) noexcept {
+            done->fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    struct sum_receiver {
+        using value_type = out_t;
+        std::atomic<long long>* sum;
+        std::atomic<int>* received;
+        std::atomic<int>* state;
+        void emplace(value_type&& r) noexcept {
+            if (r.has_value()) {
+                sum->fetch_add(r.value(), std::memory_order_relaxed);
+                received->fetch_add(1, std::memory_order_relaxed);
+                state->store(1, std::memory_order_release);
+            } else {
+                state->store(2, std::memory_order_release);
+            }
+        }
+    };
+
+    auto send_bp = share(make_blueprint<int>() | await_send(ch) | end());
+    auto recv_bp = share(make_blueprint<int>() | await_recv(ch) | end());
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            std::atomic<int> state{0};
+            for (;;) {
+                state.store(0, std::memory_order_relaxed);
+                auto runner = make_runner(recv_bp, sum_receiver{&sum, &received, &state});
+                runner(0);
+                int s;
+                while ((s = state.load(std::memory_order_acquire)) == 0) {
+                    std::this_thread::yield();
+                }
+                if (s == 2) {
+                    return;
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> senders;
+    for (int p = 0; p < producers; ++p) {
+        senders.emplace_back([&]() {
+            std::atomic<int> done{0};
+            for (int i = 0; i < per_producer; ++i) {
+                auto runner = make_runner(send_bp, flag_receiver{&done});
+                runner(i);
+                while (done.load(std::memory_order_acquire) != i + 1) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& t : senders) {
+        t.join();
+    }
+    ch.close();
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    const long long expected = static_cast<long long>(producers) * per_producer * (per_producer - 1) / 2;
+    check(received.load() == producers * per_producer, "every sent value is received once", failed);
+    check(sum.load() == expected, "received values are intact", failed);
+    return failed;
+}
+
+} // namespace
+
+int main() {
+    int failed = 0;
+
+    failed += test_send_parks_when_full();
+    failed += test_recv_parks_when_empty();
+    failed += test_close_propagates_end_of_stream();
+    failed += test_cancel_parked_receiver();
+    failed += test_mpmc_pipeline();
+
+    if (failed == 0) {
+        std::printf("[PASS] channel test passed\n");
+        return 0;
+    }
+
+    std::printf("[FAIL] channel test failed with %d failures\n", failed);
+    return 1;
+}
@@ -0,0 +1,263 @@
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using in_t = result_t<int, err_t>;
+
+template <typename Lock>
+struct lock_log {
+    std::vector<int> values;
+    std::vector<Lock> held;
+    int errors = 0;
+};
+
+template <typename Lock>
+struct hold_receiver {
+    using value_type = result_t<locked_value<Lock, int>, err_t>;
+
+    lock_log<Lock>* log;
+
+    void emplace(value_type&& r) noexcept {
+        if (r.has_value()) {
+            log->values.push_back(r.value().value);
+            log->held.push_back(std::move(r.value().lock));
+        } else {
+            ++log->errors;
+        }
+    }
+};
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+template <typename BP>
+auto share(BP&& bp) {
+    return make_lite_ptr<std::decay_t<BP>>(std::forward<BP>(bp));
+}
+
+int test_exclusive_fifo() {
+    int failed = 0;
+    using lock_t = async_unique_lock<async_mutex>;
+    async_mutex m;
+    lock_log<lock_t> log;
+
+    auto bp = share(make_blueprint<int>() | await_lock(m) | end());
+    for (int i = 0; i < 3; ++i) {
+        auto runner = make_runner(bp, hold_receiver<lock_t>{&log});
+        runner(i);
+    }
+    check(log.values == std::vector<int>({0}), "only one flow holds the mutex", failed);
+    check(!m.try_lock(), "mutex is held", failed);
+
+    log.held[0].unlock();
+    check(log.values == std::vector<int>({0, 1}), "unlock hands the mutex to the oldest waiter", failed);
+    log.held[1].unlock();
+    log.held[2].unlock();
+    check(log.values == std::vector<int>({0, 1, 2}), "waiters are granted in FIFO order", failed);
+    check(m.try_lock(), "mutex is free once every guard unlocked", failed);
+    m.unlock();
+    return failed;
+}
+
+int test_guard_unlocks_on_destruction() {
+    int failed = 0;
+    async_mutex m;
+    int seen = 0;
+
+    auto bp = share(make_blueprint<int>()
+        | await_lock(m)
+        | transform([&](locked_value<async_unique_lock<async_mutex>, int>&& l) noexcept {
+            seen = l.value;
+            return l.value;
+        })
+        | end());
+
+    struct int_receiver {
+        using value_type = in_t;
+        void emplace(value_type&&) noexcept {
+        }
+    };
+
+    auto runner = make_runner(bp, int_receiver{});
+    runner(5);
+    check(seen == 5, "locked payload carries the upstream value", failed);
+    check(m.try_lock(), "dropping the payload unlocks the mutex", failed);
+    m.unlock();
+
+    lock_log<async_unique_lock<async_mutex>> log;
+    auto lock_bp = share(make_blueprint<int>() | await_lock(m) | end());
+    auto failing = make_runner(lock_bp, hold_receiver<async_unique_lock<async_mutex>>{&log});
+    failing(in_t(error_tag, std::make_exception_ptr(std::logic_error("upstream"))));
+    check(log.errors == 1, "error input passes through", failed);
+    check(m.try_lock(), "error input does not take the mutex", failed);
+    m.unlock();
+    return failed;
+}
+
+int test_shared_readers_and_writer() {
+    int failed = 0;
+    using rlock_t = async_shared_lock<async_shared_mutex>;
+    using wlock_t = async_unique_lock<async_shared_mutex>;
+    async_shared_mutex m;
+    lock_log<rlock_t> readers;
+    lock_log<wlock_t> writers;
+
+    auto rbp = share(make_blueprint<int>() | await_lock_shared(m) | end());
+    auto wbp = share(make_blueprint<int>() | await_lock(m) | end());
+
+    for (int i = 0; i < 2; ++i) {
+        auto runner = make_runner(rbp, hold_receiver<rlock_t>{&readers});
+        runner(i);
+    }
+    check(readers.values.size() == 2, "readers share the mutex", failed);
+
+    auto writer = make_runner(wbp, hold_receiver<wlock_t>{&writers});
+    writer(100);
+    check(writers.values.empty(), "writer waits for the readers", failed);
+
+    for (int i = 2; i < 4; ++i) {
+        auto runner = make_runner(rbp, hold_receiver<rlock_t>{&readers});
+        runner(i);
+    }
+    check(readers.values.size() == 2, "new readers queue behind a waiting writer", failed);
+
+    readers.held[0].unlock();
+    check(writers.values.empty(), "writer still waits for the last reader", failed);
+    readers.held[1].unlock();
+    check(writers.values == std::vector<int>({100}), "last reader hands the mutex to the writer", failed);
+    check(readers.values.size() == 2, "queued readers wait for the writer", failed);
+
+    writers.held[0].unlock();
+    check(readers.values == std::vector<int>({0, 1, 2, 3}), "writer unlock admits every queued reader", failed);
+
+    readers.held.clear();
+    check(m.try_lock(), "shared mutex is free after every guard is gone", failed);
+    m.unlock();
+    return failed;
+}
+
+int test_cancel_parked_waiter() {
+    int failed = 0;
+    using rlock_t = async_shared_lock<async_shared_mutex>;
+    using wlock_t = async_unique_lock<async_shared_mutex>;
+    async_shared_mutex m;
+    lock_log<rlock_t> readers;
+    lock_log<wlock_t> writers;
+
+    auto rbp = share(make_blueprint<int>() | await_lock_shared(m) | end());
+    auto wbp = share(make_blueprint<int>() | await_lock(m) | end());
+
+    auto first = make_runner(rbp, hold_receiver<rlock_t>{&readers});
+    first(0);
+    auto writer = make_runner(wbp, hold_receiver<wlock_t>{&writers});
+    writer(100);
+    auto second = make_runner(rbp, hold_receiver<rlock_t>{&readers});
+    second(1);
+    check(readers.values.size() == 1, "reader parks behind the writer", failed);
+
+    writer.get_controller()->cancel(true);
+    check(writers.errors == 1, "canceled writer resumes with an error", failed);
+    check(readers.values == std::vector<int>({0, 1}), "canceling the writer admits the reader behind it", failed);
+
+    readers.held.clear();
+    check(m.try_lock(), "canceled writer never takes the mutex", failed);
+    m.unlock();
+    return failed;
+}
+
+template <typename Mutex, typename Lock, typename Await>
+int run_stress(const char* name, Await&& await_node) {
+    int failed = 0;
+    constexpr int threads = 4;
+    constexpr int rounds = 20000;
+
+    Mutex m;
+    long long counter = 0;
+    std::atomic<int> in_section{0};
+    std::atomic<bool> overlap{false};
+
+    struct count_receiver {
+        using value_type = in_t;
+        std::atomic<int>* done;
+        void emplace(value_type&&) noexcept {
+            done->fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    auto bp = share(make_blueprint<int>()
+        | await_node(m)
+        | transform([&](locked_value<Lock, int>&& l) noexcept {
+            if (in_section.fetch_add(1, std::memory_order_acq_rel) != 0) {
+                overlap.store(true, std::memory_order_relaxed);
+            }
+            ++counter;
+            in_section.fetch_sub(1, std::memory_order_acq_rel);
+            return l.value;
+        })
+        | end());
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            std::atomic<int> mine{0};
+            for (int i = 0; i < rounds; ++i) {
+                auto runner = make_runner(bp, count_receiver{&mine});
+                runner(i);
+                while (mine.load(std::memory_order_acquire) != i + 1) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    check(!overlap.load() && counter == static_cast<long long>(threads) * rounds, name, failed);
+    return failed;
+}
+
+struct lock_exclusive {
+    template <typename Mutex>
+    auto operator()(Mutex& m) const noexcept {
+        return await_lock(m);
+    }
+};
+
+} // namespace
+
+int main() {
+    int failed = 0;
+
+    failed += test_exclusive_fifo();
+    failed += test_guard_unlocks_on_destruction();
+    failed += test_shared_readers_and_writer();
+    failed += test_cancel_parked_waiter();
+    failed += run_stress<async_mutex, async_unique_lock<async_mutex>>(
+        "async_mutex serializes concurrent flows", lock_exclusive{});
+    failed += run_stress<async_shared_mutex, async_unique_lock<async_shared_mutex>>(
+        "async_shared_mutex serializes concurrent writers", lock_exclusive{});
+
+    if (failed == 0) {
+        std::printf("[PASS] mutex test passed\n");
+        return 0;
+    }
+
+    std::printf("[FAIL] mutex test failed with %d failures\n", failed);
+    return 1;
+}
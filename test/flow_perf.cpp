@@ -185,6 +185,64 @@ auto make_sync_20_bp() {
     return bp;
 }
 
+struct mix_step {
+    int operator()(int x) const noexcept {
+        return (x ^ 0x5a5a5a5a) + (x >> 3);
+    }
+};
+
+// appends N transform(mix_step) nodes, consecutive calc nodes fuse into one blueprint node.
+template <size_t N>
+struct calc_chain {
+    template <typename BP>
+    static auto append(BP&& bp) {
+        return calc_chain<N - 1>::append(std::forward<BP>(bp) | transform(mix_step{}));
+    }
+};
+
+template <>
+struct calc_chain<0> {
+    template <typename BP>
+    static auto append(BP&& bp) {
+        return std::forward<BP>(bp);
+    }
+};
+
+template <size_t N>
+auto make_sync_n_bp() {
+    auto bp = calc_chain<N>::append(make_blueprint<int>()) | end();
+    // make_blueprint() starts with an identity step, so N + 1 callables fuse into one node plus end.
+    static_assert(N + 1 > flow_impl::MAX_ZIP_N || decltype(bp)::node_count == 2, "calc chain was not fused into one node");
+    return bp;
+}
+
+template <size_t N>
+bench_result run_sync_n(const char* name, int iters_hint, volatile long long& sink) {
+    auto bp = make_sync_n_bp<N>();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+    auto runner = make_runner(bp_ptr, sink_receiver{&sink});
+    return run_bench(name, 20000, iters_hint, [&](int i) {
+        runner(i);
+    });
+}
+
+template <size_t N>
+bench_result run_fast_sync_n(const char* name, int iters_hint, volatile long long& sink) {
+    auto runner = make_fast_runner(make_sync_n_bp<N>(), sink_receiver{&sink});
+    return run_bench(name, 20000, iters_hint, [&](int i) {
+        runner(i);
+    });
+}
+
+// same chain behind any_blueprint: one indirect call to start the run, one to deliver the result.
+template <size_t N>
+bench_result run_any_sync_n(const char* name, int iters_hint, volatile long long& sink) {
+    auto runner = make_runner(make_any_blueprint(make_sync_n_bp<N>()), sink_receiver{&sink});
+    return run_bench(name, 20000, iters_hint, [&](int i) {
+        runner(i);
+    });
+}
+
 auto make_async_4_bp() {
     auto bp = make_blueprint<int>()
         | await<immediate_plus_one_awaitable>()
@@ -252,6 +310,13 @@ int main() {
     });
     print_result(r2);
 
+    print_result(run_sync_n<5>("runner.sync.5nodes", 3000000, sink));
+    print_result(run_fast_sync_n<5>("fast_runner.sync.5nodes", 3000000, sink));
+    print_result(run_sync_n<100>("runner.sync.100nodes", 500000, sink));
+    print_result(run_fast_sync_n<100>("fast_runner.sync.100nodes", 500000, sink));
+    print_result(run_any_sync_n<5>("any_runner.sync.5nodes", 3000000, sink));
+    print_result(run_any_sync_n<20>("any_runner.sync.20nodes", 2000000, sink));
+
     auto bp_async4 = make_async_4_bp();
     auto bp_async4_ptr = make_lite_ptr<decltype(bp_async4)>(std::move(bp_async4));
     auto runner_await4 = make_runner(bp_async4_ptr, sink_receiver{&sink});
@@ -290,6 +355,12 @@ int main() {
     });
     print_result(r3a1);
 
+    auto any_runner_await1 = make_runner(make_any_blueprint(make_async_1_bp()), sink_receiver{&sink});
+    auto r3a1any = run_bench("any_runner.awaitable.async1", 10000, 1200000, [&](int i) {
+        any_runner_await1(i);
+    });
+    print_result(r3a1any);
+
     auto bp_async1_fast_runner = make_async_1_bp();
     auto fast_runner_await1 = make_fast_runner_view(bp_async1_fast_runner, sink_receiver{&sink});
     auto r3a1f = run_bench("fast_runner.awaitable.async1", 10000, 1200000, [&](int i) {
@@ -0,0 +1,197 @@
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using out_t = result_t<int, err_t>;
+
+struct order_log {
+    std::vector<int> values;
+    int errors = 0;
+};
+
+struct log_receiver {
+    using value_type = out_t;
+
+    order_log* log;
+
+    void emplace(value_type&& r) noexcept {
+        if (r.has_value()) {
+            log->values.push_back(r.value());
+        } else {
+            ++log->errors;
+        }
+    }
+};
+
+struct count_receiver {
+    using value_type = out_t;
+
+    std::atomic<int>* done;
+
+    void emplace(value_type&&) noexcept {
+        done->fetch_add(1, std::memory_order_release);
+    }
+};
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+int test_fifo_admission() {
+    int failed = 0;
+    async_semaphore sem(2);
+    order_log log;
+
+    auto bp = make_blueprint<int>()
+        | await_acquire(sem)
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+
+    for (int i = 0; i < 5; ++i) {
+        auto runner = make_runner(bp_ptr, log_receiver{&log});
+        runner(i);
+    }
+
+    check(log.values.size() == 2, "semaphore admits only 2 flows", failed);
+    check(sem.available() == 0, "semaphore has no permit left", failed);
+
+    sem.release();
+    sem.release();
+    sem.release();
+    check(log.values.size() == 5, "released permits resume parked flows", failed);
+    check(log.values == std::vector<int>({0, 1, 2, 3, 4}), "parked flows resume in FIFO order", failed);
+
+    sem.release(5);
+    check(sem.available() == 5, "permits return to the semaphore once nobody is parked", failed);
+    return failed;
+}
+
+int test_error_passthrough() {
+    int failed = 0;
+    async_semaphore sem(0);
+    order_log log;
+
+    auto bp = make_blueprint<int>()
+        | await_acquire(sem)
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+    auto runner = make_runner(bp_ptr, log_receiver{&log});
+    runner(out_t(error_tag, std::make_exception_ptr(std::logic_error("upstream"))));
+
+    check(log.errors == 1, "error input passes through without a permit", failed);
+    check(sem.available() == 0, "error input does not touch the permits", failed);
+    return failed;
+}
+
+int test_cancel_unlinks_waiter() {
+    int failed = 0;
+    async_semaphore sem(1);
+    order_log log;
+
+    auto bp = make_blueprint<int>()
+        | await_acquire(sem)
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+
+    auto holder = make_runner(bp_ptr, log_receiver{&log});
+    holder(1);
+
+    auto canceled = make_runner(bp_ptr, log_receiver{&log});
+    canceled(2);
+    auto waiter = make_runner(bp_ptr, log_receiver{&log});
+    waiter(3);
+
+    canceled.get_controller()->cancel(true);
+    check(log.errors == 1, "canceled waiter is resumed with an error", failed);
+
+    sem.release();
+    check(log.values == std::vector<int>({1, 3}), "canceled waiter is skipped", failed);
+
+    sem.release();
+    check(sem.available() == 1, "canceled waiter never consumes a permit", failed);
+    return failed;
+}
+
+int test_concurrent_admission() {
+    int failed = 0;
+    constexpr int permits = 2;
+    constexpr int threads = 4;
+    constexpr int rounds = 20000;
+
+    async_semaphore sem(permits);
+    std::atomic<int> in_flight{0};
+    std::atomic<int> max_in_flight{0};
+    std::atomic<int> done{0};
+
+    auto bp = make_blueprint<int>()
+        | await_acquire(sem)
+        | transform([&](int v) noexcept {
+            auto now = in_flight.fetch_add(1, std::memory_order_acq_rel) + 1;
+            auto seen = max_in_flight.load(std::memory_order_relaxed);
+            while (now > seen && !max_in_flight.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {
+            }
+            in_flight.fetch_sub(1, std::memory_order_acq_rel);
+            sem.release();
+            return v;
+        })
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            std::atomic<int> mine{0};
+            for (int i = 0; i < rounds; ++i) {
+                auto runner = make_runner(bp_ptr, count_receiver{&mine});
+                runner(i);
+                // one outstanding flow per thread keeps the inline resume chain short.
+                while (mine.load(std::memory_order_acquire) != i + 1) {
+                    std::this_thread::yield();
+                }
+            }
+            done.fetch_add(mine.load(), std::memory_order_relaxed);
+        });
+    }
+
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    check(done.load() == threads * rounds, "every admitted flow completes", failed);
+    check(max_in_flight.load() <= permits, "concurrency never exceeds the permit count", failed);
+    check(sem.available() == permits, "permits are balanced after the run", failed);
+    return failed;
+}
+
+} // namespace
+
+int main() {
+    int failed = 0;
+
+    failed += test_fifo_admission();
+    failed += test_error_passthrough();
+    failed += test_cancel_unlinks_waiter();
+    failed += test_concurrent_admission();
+
+    if (failed == 0) {
+        std::printf("[PASS] semaphore test passed\n");
+        return 0;
+    }
+
+    std::printf("[FAIL] semaphore test failed with %d failures\n", failed);
+    return 1;
+}
@@ -550,6 +550,44 @@ int test_fast_runner_input_overloads() {
     return failed;
 }
 
+int test_fused_calc_chain() {
+    int failed = 0;
+    {
+        run_observer obs;
+        auto bp = make_blueprint<int>()
+            | transform([](int x) noexcept { return x + 1; })
+            | transform([](int x) noexcept { return x * 2; })
+            | transform([](int x) noexcept { return x + 3; })
+            | transform([](int x) noexcept { return x * 4; })
+            | transform([](int x) noexcept { return x + 5; })
+            | transform([](int x) noexcept { return x * 6; })
+            | end();
+        static_assert(decltype(bp)::node_count == 2, "consecutive calc nodes fuse into one node");
+        auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+        auto runner = make_runner(bp_ptr, int_receiver{&obs});
+        runner(1);
+        check(obs.has_value, "fused calc chain has value", failed);
+        check(obs.value == ((((1 + 1) * 2 + 3) * 4 + 5) * 6), "fused calc chain applies steps in order", failed);
+    }
+    {
+        run_observer obs;
+        int later_steps = 0;
+        auto bp = make_blueprint<int>()
+            | transform([](int x) noexcept { return x + 1; })
+            | then([](out_t&&) -> out_t { throw std::logic_error("fused-step-error"); })
+            | transform([&later_steps](int x) noexcept { ++later_steps; return x; })
+            | transform([&later_steps](int x) noexcept { ++later_steps; return x; })
+            | end();
+        auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+        auto runner = make_fast_runner(bp_ptr, int_receiver{&obs});
+        runner(1);
+        check(!obs.has_value && has_logic_error_message(obs.err, "fused-step-error"),
+            "fused calc chain forwards a step error", failed);
+        check(later_steps == 0, "fused calc chain skips steps after an error", failed);
+    }
+    return failed;
+}
+
 } // namespace
 
 int main() {
@@ -569,6 +607,7 @@ int main() {
     failed += test_submit_fail_fast_path();
     failed += test_runner_input_overloads();
     failed += test_fast_runner_input_overloads();
+    failed += test_fused_calc_chain();
 
     if (failed == 0) {
         std::printf("[PASS] smoke test passed\n");
@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "executor/simple_executor.h"
+#include "flow/flow.h"
+#include "utility/concurrent_queues.h"
+
+using namespace flux_foundry;
+
+// await<A>(&other_executor) vs await_sticky<A>() when the step after the await touches state
+// owned by the executor that submitted it. A non-sticky resume runs that step on another core,
+// so every cache line of the state migrates twice per flow; the sticky resume keeps it local.
+// Wall time is reported here, run under `perf stat -e cache-misses` to see the miss counts.
+
+namespace {
+using err_t = std::exception_ptr;
+using out_t = result_t<int, err_t>;
+
+constexpr int kExecutors = 4;
+constexpr int kRounds = 3;
+constexpr size_t kStateLines = 2048; // 128 KB per executor, roughly an L2 slice
+constexpr size_t kLineWords = 64 / sizeof(std::uint64_t);
+
+struct alignas(64) shard_state {
+    std::vector<std::atomic<std::uint64_t>> words = std::vector<std::atomic<std::uint64_t>>(kStateLines * kLineWords);
+    std::thread::id owner;
+};
+
+std::array<shard_state, kExecutors> g_shards;
+
+// writes one word per cache line of the shard.
+int touch(int shard) noexcept {
+    auto& words = g_shards[static_cast<size_t>(shard)].words;
+    for (size_t i = 0; i < words.size(); i += kLineWords) {
+        words[i].store(words[i].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    return shard;
+}
+
+struct backend_fast_awaitable;
+
+// completes awaitables from its own thread, standing in for an I/O backend.
+class backend {
+public:
+    backend()
+        : stopping_(false), worker_([this]() { run(); }) {
+    }
+
+    ~backend() {
+        stopping_.store(true, std::memory_order_release);
+        worker_.join();
+    }
+
+    void post(backend_fast_awaitable* aw) noexcept {
+        q_.wait_and_emplace(aw);
+    }
+
+private:
+    void run();
+
+    mpmc_queue<backend_fast_awaitable*, 4096> q_;
+    std::atomic<bool> stopping_;
+    std::thread worker_;
+};
+
+backend& io_backend() {
+    static backend b;
+    return b;
+}
+
+struct backend_fast_awaitable final : fast_awaitable_base<backend_fast_awaitable, int, err_t> {
+    using async_result_type = out_t;
+
+    int v;
+
+    explicit backend_fast_awaitable(async_result_type&& in) noexcept
+        : v(in.has_value() ? in.value() : 0) {
+    }
+
+    bool available() const noexcept {
+        return true;
+    }
+
+    int submit() noexcept {
+        io_backend().post(this);
+        return 0;
+    }
+
+    void complete() noexcept {
+        this->resume(async_result_type(value_tag, v));
+    }
+};
+
+void backend::run() {
+    while (!stopping_.load(std::memory_order_acquire)) {
+        auto aw = q_.try_pop();
+        if (aw) {
+            aw.get()->complete();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+struct executor_env {
+    simple_executor<4096> ex;
+    std::thread worker;
+
+    executor_env()
+        : worker([this]() noexcept { ex.run(); }) {
+    }
+
+    ~executor_env() {
+        for (int i = 0; i < 200000; ++i) {
+            if (ex.try_shutdown()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+struct counters {
+    std::atomic<int> done{0};
+    std::atomic<int> local{0};
+};
+
+struct count_receiver {
+    using value_type = out_t;
+    counters* c;
+
+    void emplace(value_type&& r) noexcept {
+        if (r.has_value() && g_shards[static_cast<size_t>(r.value())].owner == std::this_thread::get_id()) {
+            c->local.fetch_add(1, std::memory_order_relaxed);
+        }
+        c->done.fetch_add(1, std::memory_order_release);
+    }
+};
+
+template <typename BP>
+auto share(BP&& bp) {
+    return make_lite_ptr<std::decay_t<BP>>(std::forward<BP>(bp));
+}
+
+template <typename Executor>
+auto make_hop_bp(Executor* resume_on) {
+    return share(make_blueprint<int>()
+        | transform([](int s) noexcept { return touch(s); })
+        | await<backend_fast_awaitable>(resume_on)
+        | transform([](int s) noexcept { return touch(s); })
+        | end());
+}
+
+auto make_sticky_bp() {
+    return share(make_blueprint<int>()
+        | transform([](int s) noexcept { return touch(s); })
+        | await_sticky<backend_fast_awaitable>()
+        | transform([](int s) noexcept { return touch(s); })
+        | end());
+}
+
+struct bench_result {
+    const char* name;
+    double ns_per_flow;
+    double local_ratio;
+};
+
+// every executor k starts `flows` flows over shard k, `bp_for(k)` picks the blueprint.
+template <typename BPFor>
+bench_result run_case(const char* name, std::array<executor_env, kExecutors>& envs, int flows, BPFor&& bp_for) {
+    std::array<long long, kRounds> ns{};
+    double local_ratio = 0;
+
+    for (int round = 0; round < kRounds; ++round) {
+        counters c;
+        auto begin = std::chrono::steady_clock::now();
+        for (int k = 0; k < kExecutors; ++k) {
+            auto bp = bp_for(k);
+            envs[static_cast<size_t>(k)].ex.dispatch(task_wrapper_sbo([bp, k, flows, &c]() noexcept {
+                for (int i = 0; i < flows; ++i) {
+                    auto runner = make_runner(bp, count_receiver{&c});
+                    runner(k);
+                }
+            }));
+        }
+
+        const int total = flows * kExecutors;
+        while (c.done.load(std::memory_order_acquire) != total) {
+            std::this_thread::yield();
+        }
+        ns[static_cast<size_t>(round)] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+        local_ratio = static_cast<double>(c.local.load()) / total;
+    }
+
+    std::sort(ns.begin(), ns.end());
+    return bench_result{name, static_cast<double>(ns[kRounds / 2]) / (flows * kExecutors), local_ratio};
+}
+
+void print_result(const bench_result& r) {
+    std::printf("%-32s %12.2f ns/flow   resumed on submitting executor: %5.1f%%\n",
+        r.name, r.ns_per_flow, r.local_ratio * 100.0);
+}
+
+int arg_or_default(char** argv, int argc, int index, int fallback) {
+    if (index >= argc) {
+        return fallback;
+    }
+    const int v = std::atoi(argv[index]);
+    return v > 0 ? v : fallback;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int flows = arg_or_default(argv, argc, 1, 2000);
+    std::printf("[flow sticky perf] executors=%d state=%zu KB/executor flows=%d/executor\n",
+        kExecutors, kStateLines * 64 / 1024, flows);
+
+    std::array<executor_env, kExecutors> envs;
+    for (int k = 0; k < kExecutors; ++k) {
+        g_shards[static_cast<size_t>(k)].owner = envs[static_cast<size_t>(k)].worker.get_id();
+    }
+
+    auto next = run_case("await(&next_executor)", envs, flows, [&envs](int k) {
+        return make_hop_bp(&envs[static_cast<size_t>((k + 1) % kExecutors)].ex);
+    });
+    print_result(next);
+
+    auto sticky_bp = make_sticky_bp();
+    auto sticky = run_case("await_sticky", envs, flows, [&sticky_bp](int) {
+        return sticky_bp;
+    });
+    print_result(sticky);
+
+    if (sticky.local_ratio != 1.0) {
+        std::printf("[FAIL] sticky flows resumed away from their submitting executor\n");
+        return 1;
+    }
+
+    std::printf("[PASS] flow sticky perf finished\n");
+    return 0;
+}
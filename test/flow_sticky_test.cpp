@@ -0,0 +1,374 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "executor/blocking_pool.h"
+#include "executor/simple_executor.h"
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using in_t = result_t<int, err_t>;
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+struct executor_env {
+    simple_executor<1024> ex;
+    std::thread worker;
+
+    executor_env()
+        : worker([this]() noexcept { ex.run(); }) {
+    }
+
+    ~executor_env() {
+        for (int i = 0; i < 200000; ++i) {
+            if (ex.try_shutdown()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+// completes every awaitable from its own thread, like an I/O backend would.
+class backend {
+public:
+    backend()
+        : stopping_(false), worker_([this]() { run(); }) {
+    }
+
+    ~backend() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        worker_.join();
+    }
+
+    void post(std::function<void()> fn) {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            q_.push_back(std::move(fn));
+        }
+        cv_.notify_one();
+    }
+
+    std::thread::id id() const noexcept {
+        return worker_.get_id();
+    }
+
+private:
+    void run() {
+        for (;;) {
+            std::function<void()> fn;
+            {
+                std::unique_lock<std::mutex> lk(m_);
+                cv_.wait(lk, [this]() { return stopping_ || !q_.empty(); });
+                if (q_.empty()) {
+                    return;
+                }
+                fn = std::move(q_.front());
+                q_.pop_front();
+            }
+            fn();
+        }
+    }
+
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> q_;
+    bool stopping_;
+    std::thread worker_;
+};
+
+backend& io_backend() {
+    static backend b;
+    return b;
+}
+
+struct backend_awaitable final : awaitable_base<backend_awaitable, int, err_t> {
+    using async_result_type = in_t;
+
+    int v;
+
+    explicit backend_awaitable(async_result_type&& in) noexcept
+        : v(in.has_value() ? in.value() : 0) {
+    }
+
+    int submit() noexcept {
+        this->retain();
+        io_backend().post([this]() {
+            this->resume(async_result_type(value_tag, v + 100));
+            this->release();
+        });
+        return 0;
+    }
+
+    void cancel() noexcept {
+    }
+};
+
+struct backend_fast_awaitable final : fast_awaitable_base<backend_fast_awaitable, int, err_t> {
+    using async_result_type = in_t;
+
+    int v;
+
+    explicit backend_fast_awaitable(async_result_type&& in) noexcept
+        : v(in.has_value() ? in.value() : 0) {
+    }
+
+    bool available() const noexcept {
+        return true;
+    }
+
+    int submit() noexcept {
+        io_backend().post([this]() {
+            this->resume(async_result_type(value_tag, v + 100));
+        });
+        return 0;
+    }
+};
+
+struct flow_log {
+    std::atomic<int> done{0};
+    std::atomic<int> sum{0};
+    std::atomic<int> wrong_thread{0};
+    std::thread::id expected_thread;
+};
+
+struct log_receiver {
+    using value_type = in_t;
+    flow_log* log;
+
+    void emplace(value_type&& r) noexcept {
+        if (std::this_thread::get_id() != log->expected_thread) {
+            log->wrong_thread.fetch_add(1, std::memory_order_relaxed);
+        }
+        log->sum.fetch_add(r.has_value() ? r.value() : -1000, std::memory_order_relaxed);
+        log->done.fetch_add(1, std::memory_order_release);
+    }
+};
+
+void wait_for(const std::atomic<int>& done, int n) {
+    auto begin = std::chrono::steady_clock::now();
+    while (done.load(std::memory_order_acquire) != n) {
+        std::this_thread::yield();
+        if (std::chrono::steady_clock::now() - begin > std::chrono::seconds(10)) {
+            std::printf("[FAIL] sticky flows did not complete\n");
+            std::abort();
+        }
+    }
+}
+
+template <typename BP>
+auto share(BP&& bp) {
+    return make_lite_ptr<std::decay_t<BP>>(std::forward<BP>(bp));
+}
+
+// starts one flow per executor from inside that executor, each one must resume where it started.
+template <typename Awaitable>
+int test_resumes_on_submitting_executor(const char* name) {
+    int failed = 0;
+    executor_env a;
+    executor_env b;
+    flow_log log_a;
+    flow_log log_b;
+    log_a.expected_thread = a.worker.get_id();
+    log_b.expected_thread = b.worker.get_id();
+
+    auto bp = share(make_blueprint<int>()
+        | await_sticky<Awaitable>()
+        | transform([](int v) noexcept { return v + 1; })
+        | end());
+
+    for (int i = 0; i < 16; ++i) {
+        a.ex.dispatch(task_wrapper_sbo([bp, &log_a]() noexcept {
+            auto runner = make_runner(bp, log_receiver{&log_a});
+            runner(1);
+        }));
+        b.ex.dispatch(task_wrapper_sbo([bp, &log_b]() noexcept {
+            auto runner = make_runner(bp, log_receiver{&log_b});
+            runner(2);
+        }));
+    }
+    wait_for(log_a.done, 16);
+    wait_for(log_b.done, 16);
+
+    check(log_a.sum.load() == 16 * 102 && log_b.sum.load() == 16 * 103, name, failed);
+    check(log_a.wrong_thread.load() == 0 && log_b.wrong_thread.load() == 0,
+        "sticky resume returns to the submitting executor", failed);
+    return failed;
+}
+
+int test_no_executor_resumes_inline() {
+    int failed = 0;
+    flow_log log;
+    log.expected_thread = io_backend().id();
+
+    auto bp = share(make_blueprint<int>()
+        | await_sticky<backend_awaitable>()
+        | end());
+
+    auto runner = make_runner(bp, log_receiver{&log});
+    runner(1);
+    wait_for(log.done, 1);
+
+    check(log.sum.load() == 101, "sticky step outside of any executor completes", failed);
+    check(log.wrong_thread.load() == 0, "sticky step outside of any executor resumes inline", failed);
+    return failed;
+}
+
+int test_blocking_pool_is_sticky_target() {
+    int failed = 0;
+    blocking_pool<> pool(2);
+    std::atomic<int> done{0};
+    std::atomic<int> on_pool{0};
+
+    struct pool_receiver {
+        using value_type = in_t;
+        blocking_pool<>* pool;
+        std::atomic<int>* on_pool;
+        std::atomic<int>* done;
+
+        void emplace(value_type&&) noexcept {
+            if (executor_ref::current() == executor_ref(pool)) {
+                on_pool->fetch_add(1, std::memory_order_relaxed);
+            }
+            done->fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    // await_blocking without a resume executor continues on the pool worker.
+    auto bp = share(make_blueprint<int>()
+        | await_blocking([](int v) noexcept { return v; }, &pool)
+        | await_sticky<backend_awaitable>()
+        | end());
+
+    for (int i = 0; i < 4; ++i) {
+        auto runner = make_runner(bp, pool_receiver{&pool, &on_pool, &done});
+        runner(i);
+    }
+    wait_for(done, 4);
+
+    check(on_pool.load() == 4, "sticky step submitted from a blocking_pool task resumes on the pool", failed);
+    return failed;
+}
+struct inline_awaitable final : awaitable_base<inline_awaitable, int, err_t> {
+    using async_result_type = in_t;
+
+    int v;
+
+    explicit inline_awaitable(async_result_type&& in) noexcept
+        : v(in.has_value() ? in.value() : 0) {
+    }
+
+    int submit() noexcept {
+        this->resume(async_result_type(value_tag, v + 100));
+        return 0;
+    }
+
+    void cancel() noexcept {
+    }
+};
+
+// single threaded executor that publishes itself while it drains, budget is its inline_hop_budget.
+template <size_t budget>
+struct queued_executor {
+    static constexpr size_t inline_hop_budget = budget;
+
+    std::deque<task_wrapper_sbo> q;
+    int dispatched = 0;
+
+    void dispatch(task_wrapper_sbo&& task) noexcept {
+        ++dispatched;
+        q.push_back(std::move(task));
+    }
+
+    void drain() noexcept {
+        current_executor_scope scope(this);
+        while (!q.empty()) {
+            auto task = std::move(q.front());
+            q.pop_front();
+            task();
+        }
+    }
+};
+
+// a sticky resume that is already on its executor runs inline within that executor's budget.
+template <size_t budget>
+int sticky_hops_dispatched() {
+    queued_executor<budget> ex;
+    std::atomic<int> sum{0};
+    std::atomic<int> done{0};
+
+    struct sum_receiver {
+        using value_type = in_t;
+        std::atomic<int>* sum;
+        std::atomic<int>* done;
+
+        void emplace(value_type&& r) noexcept {
+            sum->fetch_add(r.has_value() ? r.value() : -1000, std::memory_order_relaxed);
+            done->fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    auto bp = share(make_blueprint<int>()
+        | await_sticky<inline_awaitable>()
+        | end());
+
+    ex.dispatch(task_wrapper_sbo([bp, &sum, &done]() noexcept {
+        auto runner = make_runner(bp, sum_receiver{&sum, &done});
+        runner(1);
+    }));
+    ex.drain();
+
+    return done.load() == 1 && sum.load() == 101 ? ex.dispatched - 1 : -1;
+}
+
+int test_sticky_uses_executor_budget() {
+    int failed = 0;
+    check(executor_ref(static_cast<queued_executor<0>*>(nullptr)).inline_hop_budget() == 0
+        && executor_ref(static_cast<queued_executor<4>*>(nullptr)).inline_hop_budget() == 4,
+        "executor_ref carries the inline_hop_budget of its executor type", failed);
+    check(sticky_hops_dispatched<4>() == 0, "sticky resume on its own executor runs inline", failed);
+    check(sticky_hops_dispatched<0>() == 1, "inline_hop_budget = 0 queues the sticky resume", failed);
+    return failed;
+}
+} // namespace
+
+int main() {
+    int failed = 0;
+    failed += test_resumes_on_submitting_executor<backend_awaitable>("sticky awaitable results are delivered");
+    failed += test_resumes_on_submitting_executor<backend_fast_awaitable>("sticky fast_awaitable results are delivered");
+    failed += test_no_executor_resumes_inline();
+    failed += test_blocking_pool_is_sticky_target();
+    failed += test_sticky_uses_executor_budget();
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] flow sticky test passed\n");
+    return 0;
+}
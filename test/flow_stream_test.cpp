@@ -0,0 +1,277 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "executor/simple_executor.h"
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using out_t = result_t<int, err_t>;
+using end_t = result_t<void, err_t>;
+
+struct stream_log {
+    std::vector<int> values;
+    int errors = 0;
+    int completed = 0;
+    int failed = 0;
+    bool items_after_end = false;
+};
+
+struct log_receiver {
+    using value_type = out_t;
+
+    stream_log* log;
+
+    void emplace(value_type&& r) noexcept {
+        if (log->completed || log->failed) {
+            log->items_after_end = true;
+        }
+        if (r.has_value()) {
+            log->values.push_back(r.value());
+        } else {
+            ++log->errors;
+        }
+    }
+
+    void complete(end_t&& r) noexcept {
+        if (r.has_value()) {
+            ++log->completed;
+        } else {
+            ++log->failed;
+        }
+    }
+};
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+template <typename BP>
+auto share(BP&& bp) {
+    return make_lite_ptr<std::decay_t<BP>>(std::forward<BP>(bp));
+}
+
+int test_credit_window() {
+    int failed = 0;
+    stream_log log;
+
+    auto bp = share(make_blueprint<int>()
+        | transform([](int v) noexcept { return v * 10; })
+        | end());
+    auto stream = make_stream_runner<4>(bp, log_receiver{&log});
+
+    check(!stream.try_emit(1), "no demand, no emit", failed);
+    check(stream.request(2) == 2, "request grants the demand", failed);
+    check(stream.try_emit(1) && stream.try_emit(2), "source spends the credits", failed);
+    check(!stream.try_emit(3), "source is throttled once the credits are spent", failed);
+    check(log.values == std::vector<int>({10, 20}), "items flow through the calc nodes in order", failed);
+
+    check(stream.request(10) == 4, "request is clamped to the window", failed);
+    check(stream.request(1) == 0, "a full window grants nothing", failed);
+
+    stream.complete();
+    check(log.completed == 1 && !log.items_after_end, "complete ends the stream after the items", failed);
+    check(!stream.try_emit(4), "emit after complete is refused", failed);
+    return failed;
+}
+
+int test_async_stage_keeps_order() {
+    int failed = 0;
+    stream_log log;
+    async_semaphore gate(0);
+
+    // every item parks on the gate, the next one must not start before it is delivered.
+    auto bp = share(make_blueprint<int>()
+        | await_acquire(gate)
+        | end());
+    auto stream = make_stream_runner<8>(bp, log_receiver{&log});
+
+    stream.request(3);
+    stream.try_emit(1);
+    stream.try_emit(2);
+    stream.try_emit(3);
+    stream.complete();
+    check(log.values.empty(), "first item is parked in the await node", failed);
+
+    gate.release();
+    check(log.values == std::vector<int>({1}), "one item is in flight at a time", failed);
+    check(gate.available() == 0, "the next item took the gate only after the previous one", failed);
+
+    gate.release(2);
+    check(log.values == std::vector<int>({1, 2, 3}), "queued items resume in emission order", failed);
+    check(log.completed == 1 && !log.items_after_end, "end signal waits for the items in flight", failed);
+    return failed;
+}
+
+int test_fail_and_cancel() {
+    int failed = 0;
+    {
+        stream_log log;
+        auto bp = share(make_blueprint<int>() | end());
+        auto stream = make_stream_runner<4>(bp, log_receiver{&log});
+        stream.request(1);
+        stream.try_emit(7);
+        stream.fail(std::make_exception_ptr(std::logic_error("source")));
+        stream.complete();
+        check(log.values == std::vector<int>({7}) && log.failed == 1 && log.completed == 0,
+            "fail ends the stream with an error, only the first end signal counts", failed);
+    }
+    {
+        stream_log log;
+        async_semaphore gate(0);
+        auto bp = share(make_blueprint<int>() | await_acquire(gate) | end());
+        auto stream = make_stream_runner<4>(bp, log_receiver{&log});
+        stream.request(3);
+        stream.try_emit(1);
+        stream.try_emit(2);
+
+        stream.cancel(true);
+        check(log.errors == 2, "cancel fails the item in flight and the queued ones", failed);
+        check(!stream.try_emit(3), "canceled stream refuses new items", failed);
+
+        stream.complete();
+        check(log.completed == 1, "canceled stream still delivers the end signal", failed);
+        check(gate.available() == 0, "canceled items never consume a permit", failed);
+    }
+    return failed;
+}
+
+struct executor_env {
+    simple_executor<1024> ex;
+    std::thread worker;
+
+    executor_env()
+        : worker([this]() noexcept { ex.run(); }) {
+    }
+
+    ~executor_env() {
+        for (int i = 0; i < 200000; ++i) {
+            if (ex.try_shutdown()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+int test_cross_thread_backpressure() {
+    int failed = 0;
+    constexpr int items = 50000;
+    constexpr size_t window = 16;
+
+    struct concurrent_log {
+        std::atomic<long long> sum{0};
+        std::atomic<int> received{0};
+        std::atomic<bool> ordered{true};
+        std::atomic<int> done{0};
+        int last = -1;
+    };
+
+    executor_env env;
+    concurrent_log log;
+
+    auto bp = share(make_blueprint<int>()
+        | via(&env.ex)
+        | transform([](int v) noexcept { return v + 1; })
+        | end());
+
+    struct requesting_receiver {
+        using value_type = out_t;
+        concurrent_log* log;
+        // filled once the stream exists, the receiver asks for one more item per delivery.
+        std::atomic<void*>* stream;
+        size_t (*request_one)(void*);
+
+        void emplace(value_type&& r) noexcept {
+            if (r.has_value()) {
+                if (r.value() != log->last + 2) {
+                    log->ordered.store(false, std::memory_order_relaxed);
+                }
+                log->last = r.value() - 1;
+                log->sum.fetch_add(r.value(), std::memory_order_relaxed);
+                log->received.fetch_add(1, std::memory_order_release);
+            }
+            request_one(stream->load(std::memory_order_acquire));
+        }
+
+        void complete(end_t&&) noexcept {
+            log->done.store(1, std::memory_order_release);
+        }
+    };
+
+    using runner_t = decltype(make_stream_runner<window>(bp, std::declval<requesting_receiver>()));
+    std::atomic<void*> handle{nullptr};
+    auto stream = make_stream_runner<window>(bp, requesting_receiver{&log, &handle,
+        [](void* p) noexcept { return static_cast<runner_t*>(p)->request(1); }});
+    handle.store(&stream, std::memory_order_release);
+
+    stream.request(window);
+    std::thread producer([&]() {
+        size_t max_demand = 0;
+        for (int i = 0; i < items;) {
+            auto d = stream.demand();
+            max_demand = d > max_demand ? d : max_demand;
+            if (stream.try_emit(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        stream.complete();
+        if (max_demand > window) {
+            std::printf("[FAIL] demand exceeded the window\n");
+            std::abort();
+        }
+    });
+    producer.join();
+
+    auto begin = std::chrono::steady_clock::now();
+    while (log.done.load(std::memory_order_acquire) == 0) {
+        std::this_thread::yield();
+        if (std::chrono::steady_clock::now() - begin > std::chrono::seconds(10)) {
+            std::printf("[FAIL] stream did not complete\n");
+            std::abort();
+        }
+    }
+
+    const long long expected = static_cast<long long>(items) * (items + 1) / 2;
+    check(log.received.load() == items, "every item crosses the executor once", failed);
+    check(log.sum.load() == expected, "items are intact", failed);
+    check(log.ordered.load(), "items stay in emission order across threads", failed);
+    return failed;
+}
+
+} // namespace
+
+int main() {
+    int failed = 0;
+
+    failed += test_credit_window();
+    failed += test_async_stage_keeps_order();
+    failed += test_fail_and_cancel();
+    failed += test_cross_thread_backpressure();
+
+    if (failed == 0) {
+        std::printf("[PASS] stream test passed\n");
+        return 0;
+    }
+
+    std::printf("[FAIL] stream test failed with %d failures\n", failed);
+    return 1;
+}
@@ -0,0 +1,47 @@
+// must NOT compile: the via continuation of flow_task_sbo_test.cpp does not fit task_wrapper_sbo, so on
+// the default executor it spills, and FLUX_FOUNDRY_SBO_SPILL_DIAGNOSTIC=2 turns that into a build error.
+// built by the flow_task_sbo_spill test, which expects the spill diagnostic in the compiler output.
+#define FLUX_FOUNDRY_SBO_SPILL_DIAGNOSTIC 2
+
+#include <array>
+#include <exception>
+
+#include "executor/simple_executor.h"
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using quote_t = std::array<long long, 8>;
+using out_t = result_t<quote_t, err_t>;
+
+struct drop_receiver {
+    using value_type = out_t;
+
+    void emplace(value_type&&) noexcept {
+    }
+};
+} // namespace
+
+int main() {
+    simple_executor<1024> ex;
+
+    auto bp = make_blueprint<int>()
+        | transform([](int x) noexcept {
+            quote_t q{};
+            q.fill(x);
+            return q;
+        })
+        | via(&ex)
+        | transform([](quote_t q) noexcept {
+            q[0] += 1;
+            return q;
+        })
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+
+    auto runner = make_runner(bp_ptr, drop_receiver{});
+    runner(1);
+    return 0;
+}
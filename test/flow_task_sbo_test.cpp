@@ -0,0 +1,214 @@
+// every type-erased wrapper in this file must hold its target inline, a spill fails the build.
+#define FLUX_FOUNDRY_SBO_SPILL_DIAGNOSTIC 2
+// room for the awaitable continuation of a runner whose receiver carries a quote_t.
+#define FLUX_FOUNDRY_NEXT_STEP_SBO_SIZE 128
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+
+#include "executor/simple_executor.h"
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+// a result large enough to push a via continuation (runner, controller, result) past task_wrapper_sbo.
+using quote_t = std::array<long long, 8>;
+using out_t = result_t<quote_t, err_t>;
+using large_executor_t = simple_executor<1024, task_wrapper_large>;
+
+static_assert(std::is_same<flow_impl::dispatch_wrapper_t<large_executor_t*>::task_type, task_wrapper_large>::value,
+    "via(&large_executor) builds its continuations as task_wrapper_large");
+static_assert(std::is_same<flow_impl::dispatch_wrapper_t<simple_executor<1024>*>::task_type, task_wrapper_sbo>::value,
+    "the default executor keeps task_wrapper_sbo");
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+struct executor_env {
+    large_executor_t ex;
+    std::thread worker;
+
+    executor_env()
+        : worker([this]() noexcept { ex.run(); }) {
+    }
+
+    ~executor_env() {
+        for (int i = 0; i < 200000; ++i) {
+            if (ex.try_shutdown()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+struct sum_receiver {
+    using value_type = out_t;
+    std::atomic<long long>* sum;
+    std::atomic<int>* done;
+
+    void emplace(value_type&& r) noexcept {
+        long long s = 0;
+        if (r.has_value()) {
+            for (long long v : r.value()) {
+                s += v;
+            }
+        }
+        sum->fetch_add(s, std::memory_order_relaxed);
+        done->fetch_add(1, std::memory_order_release);
+    }
+};
+
+void wait_for(const std::atomic<int>& done, int n) {
+    auto begin = std::chrono::steady_clock::now();
+    while (done.load(std::memory_order_acquire) != n) {
+        std::this_thread::yield();
+        if (std::chrono::steady_clock::now() - begin > std::chrono::seconds(10)) {
+            std::printf("[FAIL] flows did not complete\n");
+            std::abort();
+        }
+    }
+}
+
+int test_large_continuation_stays_inline() {
+    int failed = 0;
+    executor_env env;
+    std::atomic<long long> sum{0};
+    std::atomic<int> done{0};
+
+    auto bp = make_blueprint<int>()
+        | transform([](int x) noexcept {
+            quote_t q{};
+            q.fill(x);
+            return q;
+        })
+        | via(&env.ex)
+        | transform([](quote_t q) noexcept {
+            q[0] += 1;
+            return q;
+        })
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+
+    for (int i = 0; i < 32; ++i) {
+        auto runner = make_runner(bp_ptr, sum_receiver{&sum, &done});
+        runner(i);
+    }
+    wait_for(done, 32);
+
+    check(sum.load() == 8 * (31 * 32 / 2) + 32, "large via continuations run on the large executor", failed);
+    return failed;
+}
+
+struct quote_plus_one_awaitable final : awaitable_base<quote_plus_one_awaitable, quote_t, err_t> {
+    using async_result_type = out_t;
+    quote_t q;
+
+    explicit quote_plus_one_awaitable(async_result_type&& in) noexcept
+        : q(in.has_value() ? in.value() : quote_t{}) {
+    }
+
+    int submit() noexcept {
+        q[0] += 1;
+        this->resume(async_result_type(value_tag, q));
+        return 0;
+    }
+
+    void cancel() noexcept {}
+};
+
+// a receiver as large as the result, the continuation handed to the awaitable carries it.
+struct quote_receiver {
+    using value_type = out_t;
+    quote_t seen;
+    quote_t* out;
+
+    void emplace(value_type&& r) noexcept {
+        seen = r.has_value() ? r.value() : quote_t{};
+        *out = seen;
+    }
+};
+
+int test_large_awaitable_continuation_stays_inline() {
+    int failed = 0;
+    quote_t out{};
+
+    auto bp = make_blueprint<quote_t>()
+        | await<quote_plus_one_awaitable>()
+        | end();
+    auto bp_ptr = make_lite_ptr<decltype(bp)>(std::move(bp));
+
+    quote_t in{};
+    in.fill(2);
+    auto runner = make_runner(bp_ptr, quote_receiver{quote_t{}, &out});
+    runner(in);
+
+    check(out[0] == 3 && out[7] == 2, "a continuation past callable_wrapper_sbo_size fits the next step buffer", failed);
+    return failed;
+}
+
+int test_plain_task_is_wrapped() {
+    int failed = 0;
+    executor_env env;
+    std::atomic<int> done{0};
+
+    for (int i = 0; i < 16; ++i) {
+        env.ex.dispatch(task_wrapper_sbo([&done]() noexcept {
+            done.fetch_add(1, std::memory_order_release);
+        }));
+    }
+    wait_for(done, 16);
+
+    check(done.load() == 16, "task_wrapper_sbo dispatched to the large executor runs", failed);
+    return failed;
+}
+
+int test_task_wrapper_sizes() {
+    int failed = 0;
+    long long captured[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    long long out = 0;
+
+    task_wrapper<128> task([captured, &out]() noexcept {
+        for (long long v : captured) {
+            out += v;
+        }
+    });
+    task();
+
+    check(out == 78, "task_wrapper<128> holds a 96 byte capture inline", failed);
+    check(sizeof(task_wrapper_large) == 2 * OPTIMIZED_ALIGN, "task_wrapper_large spans two alignment blocks", failed);
+    return failed;
+}
+} // namespace
+
+int main() {
+    int failed = 0;
+    failed += test_large_continuation_stays_inline();
+    failed += test_large_awaitable_continuation_stays_inline();
+    failed += test_plain_task_is_wrapped();
+    failed += test_task_wrapper_sizes();
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] flow task sbo test passed\n");
+    return 0;
+}
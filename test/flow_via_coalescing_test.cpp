@@ -0,0 +1,267 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+
+#include "executor/simple_executor.h"
+#include "flow/flow.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+using in_t = result_t<int, err_t>;
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+struct executor_env {
+    simple_executor<1024> ex;
+    std::thread worker;
+
+    executor_env()
+        : worker([this]() noexcept { ex.run(); }) {
+    }
+
+    ~executor_env() {
+        for (int i = 0; i < 200000; ++i) {
+            if (ex.try_shutdown()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+// forwards to a simple_executor and counts the queue round-trips.
+template <size_t budget>
+struct counting_executor {
+    static constexpr size_t inline_hop_budget = budget;
+
+    simple_executor<1024>* ex;
+    std::atomic<int> dispatched{0};
+
+    explicit counting_executor(simple_executor<1024>* ex_) noexcept
+        : ex(ex_) {
+    }
+
+    void dispatch(task_wrapper_sbo&& t) noexcept {
+        dispatched.fetch_add(1, std::memory_order_relaxed);
+        ex->dispatch(std::move(t));
+    }
+
+    bool running_in_this_thread() const noexcept {
+        return ex->running_in_this_thread();
+    }
+};
+
+// same, but cannot tell whether the caller runs on it: never coalesced.
+struct opaque_executor {
+    simple_executor<1024>* ex;
+    std::atomic<int> dispatched{0};
+
+    explicit opaque_executor(simple_executor<1024>* ex_) noexcept
+        : ex(ex_) {
+    }
+
+    void dispatch(task_wrapper_sbo&& t) noexcept {
+        dispatched.fetch_add(1, std::memory_order_relaxed);
+        ex->dispatch(std::move(t));
+    }
+};
+
+struct flow_log {
+    std::atomic<int> done{0};
+    std::atomic<int> value{0};
+    std::atomic<int> wrong_thread{0};
+    std::thread::id expected_thread;
+};
+
+struct log_receiver {
+    using value_type = in_t;
+    flow_log* log;
+
+    void emplace(value_type&& r) noexcept {
+        if (std::this_thread::get_id() != log->expected_thread) {
+            log->wrong_thread.fetch_add(1, std::memory_order_relaxed);
+        }
+        log->value.store(r.has_value() ? r.value() : -1, std::memory_order_relaxed);
+        log->done.fetch_add(1, std::memory_order_release);
+    }
+};
+
+void wait_for(flow_log& log, int n) {
+    auto begin = std::chrono::steady_clock::now();
+    while (log.done.load(std::memory_order_acquire) != n) {
+        std::this_thread::yield();
+        if (std::chrono::steady_clock::now() - begin > std::chrono::seconds(10)) {
+            std::printf("[FAIL] coalescing flows did not complete\n");
+            std::abort();
+        }
+    }
+}
+
+template <typename BP>
+auto share(BP&& bp) {
+    return make_lite_ptr<std::decay_t<BP>>(std::forward<BP>(bp));
+}
+
+auto plus_one() noexcept {
+    return [](int v) noexcept { return v + 1; };
+}
+
+// ten consecutive hops to the same executor, each followed by a step.
+template <typename Executor>
+auto make_hops(Executor* e) {
+    return share(make_blueprint<int>()
+        | via(e) | transform(plus_one()) | via(e) | transform(plus_one())
+        | via(e) | transform(plus_one()) | via(e) | transform(plus_one())
+        | via(e) | transform(plus_one()) | via(e) | transform(plus_one())
+        | via(e) | transform(plus_one()) | via(e) | transform(plus_one())
+        | via(e) | transform(plus_one()) | via(e) | transform(plus_one())
+        | end());
+}
+
+struct immediate_awaitable final : fast_awaitable_base<immediate_awaitable, int, err_t> {
+    using async_result_type = in_t;
+
+    int v;
+
+    explicit immediate_awaitable(async_result_type&& in) noexcept
+        : v(in.has_value() ? in.value() : 0) {
+    }
+
+    bool available() const noexcept {
+        return true;
+    }
+
+    int submit() noexcept {
+        this->resume(async_result_type(value_tag, v * 2));
+        return 0;
+    }
+};
+
+int test_budgeted_hops() {
+    int failed = 0;
+    executor_env env;
+    counting_executor<4> exec(&env.ex);
+    flow_log log;
+    log.expected_thread = env.worker.get_id();
+
+    auto runner = make_runner(make_hops(&exec), log_receiver{&log});
+    runner(0);
+    wait_for(log, 1);
+
+    check(log.value.load() == 10, "coalesced hops still run every step", failed);
+    check(log.wrong_thread.load() == 0, "coalesced hops stay on the executor", failed);
+    // the first hop comes from this thread, then 4 inline, one requeue, 4 inline.
+    check(exec.dispatched.load() == 2, "hops to the current executor run inline up to the budget", failed);
+    return failed;
+}
+
+int test_opaque_executor_not_coalesced() {
+    int failed = 0;
+    executor_env env;
+    opaque_executor exec(&env.ex);
+    flow_log log;
+    log.expected_thread = env.worker.get_id();
+
+    auto runner = make_runner(make_hops(&exec), log_receiver{&log});
+    runner(0);
+    wait_for(log, 1);
+
+    check(log.value.load() == 10, "opaque executor runs every step", failed);
+    check(exec.dispatched.load() == 10, "executor without running_in_this_thread() is never coalesced", failed);
+    return failed;
+}
+
+int test_zero_budget() {
+    int failed = 0;
+    executor_env env;
+    counting_executor<0> exec(&env.ex);
+    flow_log log;
+    log.expected_thread = env.worker.get_id();
+
+    auto runner = make_runner(make_hops(&exec), log_receiver{&log});
+    runner(0);
+    wait_for(log, 1);
+
+    check(exec.dispatched.load() == 10, "inline_hop_budget = 0 turns coalescing off", failed);
+    return failed;
+}
+
+int test_async_resume_coalesced() {
+    int failed = 0;
+    executor_env env;
+    counting_executor<FLUX_FOUNDRY_INLINE_HOP_BUDGET> exec(&env.ex);
+    flow_log log;
+    log.expected_thread = env.worker.get_id();
+
+    auto bp = share(make_blueprint<int>()
+        | via(&exec)
+        | transform(plus_one())
+        | await<immediate_awaitable>(&exec)
+        | end());
+
+    auto runner = make_runner(bp, log_receiver{&log});
+    runner(1);
+    wait_for(log, 1);
+
+    check(log.value.load() == 4, "async resume result is delivered", failed);
+    check(log.wrong_thread.load() == 0, "async resume stays on the executor", failed);
+    check(exec.dispatched.load() == 1, "async resume on the current executor skips the queue", failed);
+    return failed;
+}
+
+int test_foreign_thread_dispatches() {
+    int failed = 0;
+    executor_env env;
+    executor_env other;
+    counting_executor<FLUX_FOUNDRY_INLINE_HOP_BUDGET> a(&env.ex);
+    counting_executor<FLUX_FOUNDRY_INLINE_HOP_BUDGET> b(&other.ex);
+    flow_log log;
+    log.expected_thread = env.worker.get_id();
+
+    auto bp = share(make_blueprint<int>()
+        | via(&a) | transform(plus_one())
+        | via(&b) | transform(plus_one())
+        | via(&a) | transform(plus_one())
+        | end());
+
+    auto runner = make_runner(bp, log_receiver{&log});
+    runner(0);
+    wait_for(log, 1);
+
+    check(log.value.load() == 3 && log.wrong_thread.load() == 0, "alternating hops end on the last executor", failed);
+    check(a.dispatched.load() == 2 && b.dispatched.load() == 1, "hops between different executors still enqueue", failed);
+    return failed;
+}
+} // namespace
+
+int main() {
+    int failed = 0;
+    failed += test_budgeted_hops();
+    failed += test_opaque_executor_not_coalesced();
+    failed += test_zero_budget();
+    failed += test_async_resume_coalesced();
+    failed += test_foreign_thread_dispatches();
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] flow via coalescing test passed\n");
+    return 0;
+}
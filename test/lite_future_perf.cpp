@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <thread>
+
+#include "task/lite_future.h"
+
+using namespace flux_foundry;
+
+// std::promise/std::future vs lite_promise/lite_future on the two ways results are handed back
+// to a non-flow thread:
+// - local: create, set and get on one thread, i.e. the shared state allocation plus the bookkeeping
+// - handoff: a worker sets the value, the caller blocks in get(), i.e. the wait and the wake-up path
+
+namespace {
+constexpr int kRounds = 3;
+
+struct std_pair {
+    using promise_t = std::promise<int>;
+
+    static int get(std::future<int>& f) {
+        return f.get();
+    }
+};
+
+struct lite_pair {
+    using promise_t = lite_promise<int>;
+
+    static int get(lite_future<int>& f) noexcept {
+        return f.get().value();
+    }
+};
+
+template <typename Pair>
+long long run_local(int n) {
+    long long sum = 0;
+    for (int i = 0; i < n; ++i) {
+        typename Pair::promise_t p;
+        auto f = p.get_future();
+        p.set_value(i);
+        sum += Pair::get(f);
+    }
+    return sum;
+}
+
+// the worker takes one promise at a time from `slot` and sets it.
+template <typename Pair>
+class handoff_worker {
+    using promise_t = typename Pair::promise_t;
+
+    std::atomic<promise_t*> slot_{nullptr};
+    std::atomic<bool> stop_{false};
+    std::thread worker_;
+
+public:
+    handoff_worker()
+        : worker_([this]() noexcept {
+            int v = 0;
+            while (!stop_.load(std::memory_order_acquire)) {
+                promise_t* p = slot_.exchange(nullptr, std::memory_order_acq_rel);
+                if (p) {
+                    p->set_value(v++);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }) {
+    }
+
+    ~handoff_worker() {
+        stop_.store(true, std::memory_order_release);
+        worker_.join();
+    }
+
+    long long run(int n) {
+        long long sum = 0;
+        for (int i = 0; i < n; ++i) {
+            promise_t p;
+            auto f = p.get_future();
+            slot_.store(&p, std::memory_order_release);
+            sum += Pair::get(f);
+        }
+        return sum;
+    }
+};
+
+template <typename F>
+double median_ns_per_op(int n, F&& f) {
+    std::array<long long, kRounds> ns{};
+    for (int round = 0; round < kRounds; ++round) {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        ns[static_cast<size_t>(round)] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+    }
+    std::sort(ns.begin(), ns.end());
+    return static_cast<double>(ns[kRounds / 2]) / n;
+}
+
+void print_row(const char* name, double std_ns, double lite_ns) {
+    std::printf("%-10s std::promise %10.1f ns/op   lite_promise %10.1f ns/op   x%.2f\n",
+        name, std_ns, lite_ns, lite_ns > 0 ? std_ns / lite_ns : 0.0);
+}
+
+int arg_or_default(char** argv, int argc, int index, int fallback) {
+    if (index >= argc) {
+        return fallback;
+    }
+    const int v = std::atoi(argv[index]);
+    return v > 0 ? v : fallback;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int local_n = arg_or_default(argv, argc, 1, 1000000);
+    const int handoff_n = arg_or_default(argv, argc, 2, 50000);
+    std::printf("[lite future perf] local=%d handoff=%d\n", local_n, handoff_n);
+
+    const long long local_expected = static_cast<long long>(local_n) * (local_n - 1) / 2;
+    long long std_sum = 0;
+    long long lite_sum = 0;
+    const double std_local = median_ns_per_op(local_n, [&]() { std_sum = run_local<std_pair>(local_n); });
+    const double lite_local = median_ns_per_op(local_n, [&]() { lite_sum = run_local<lite_pair>(local_n); });
+    print_row("local", std_local, lite_local);
+    if (std_sum != local_expected || lite_sum != local_expected) {
+        std::printf("[FAIL] local results differ\n");
+        return 1;
+    }
+
+    double std_handoff = 0;
+    double lite_handoff = 0;
+    {
+        handoff_worker<std_pair> w;
+        std_handoff = median_ns_per_op(handoff_n, [&]() { w.run(handoff_n); });
+    }
+    {
+        handoff_worker<lite_pair> w;
+        lite_handoff = median_ns_per_op(handoff_n, [&]() { w.run(handoff_n); });
+    }
+    print_row("handoff", std_handoff, lite_handoff);
+
+    std::printf("[PASS] lite future perf finished\n");
+    return 0;
+}
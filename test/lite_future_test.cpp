@@ -0,0 +1,207 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+#include "executor/simple_executor.h"
+#include "task/future_task.h"
+#include "task/lite_future.h"
+
+using namespace flux_foundry;
+
+namespace {
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+struct executor_env {
+    simple_executor<1024> ex;
+    std::thread worker;
+
+    executor_env()
+        : worker([this]() noexcept { ex.run(); }) {
+    }
+
+    ~executor_env() {
+        for (int i = 0; i < 200000; ++i) {
+            if (ex.try_shutdown()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+void wait_for(const std::atomic<int>& done, int n) {
+    auto begin = std::chrono::steady_clock::now();
+    while (done.load(std::memory_order_acquire) != n) {
+        std::this_thread::yield();
+        if (std::chrono::steady_clock::now() - begin > std::chrono::seconds(10)) {
+            std::printf("[FAIL] continuations did not run\n");
+            std::abort();
+        }
+    }
+}
+
+int test_value_and_error() {
+    int failed = 0;
+    lite_promise<int> p;
+    auto f = p.get_future();
+    check(f.valid() && !f.ready(), "a fresh future is not ready", failed);
+    p.set_value(42);
+    check(f.ready(), "set_value makes the future ready", failed);
+    auto r = f.get();
+    check(r.has_value() && r.value() == 42 && !f.valid(), "get moves the value out", failed);
+
+    lite_promise<void, int> q;
+    auto g = q.get_future();
+    q.set_error(7);
+    auto e = g.get();
+    check(e.has_error() && e.error() == 7, "set_error publishes the error", failed);
+    return failed;
+}
+
+int test_cross_thread_park() {
+    int failed = 0;
+    lite_promise<int> p;
+    auto f = p.get_future();
+    std::thread producer([&p]() noexcept {
+        // long enough for the consumer to stop spinning and park.
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        p.set_value(9);
+    });
+    auto r = f.get();
+    producer.join();
+    check(r.has_value() && r.value() == 9, "a parked consumer is woken by the producer", failed);
+    return failed;
+}
+
+int test_wait_for() {
+    int failed = 0;
+    lite_promise<int> p;
+    auto f = p.get_future();
+    check(!f.wait_for(std::chrono::milliseconds(5)), "wait_for times out without a result", failed);
+    p.set_value(1);
+    check(f.wait_for(std::chrono::milliseconds(5)), "wait_for sees a published result", failed);
+    return failed;
+}
+
+int test_broken_promise() {
+    int failed = 0;
+    lite_future<int> f;
+    {
+        lite_promise<int> p;
+        f = p.get_future();
+    }
+    auto r = f.get();
+    bool broken = false;
+    if (r.has_error()) {
+        try {
+            std::rethrow_exception(r.error());
+        } catch (const std::future_error& e) {
+            broken = e.code() == std::future_errc::broken_promise;
+        } catch (...) {
+        }
+    }
+    check(broken, "a dropped promise publishes broken_promise", failed);
+    return failed;
+}
+
+int test_empty_promise() {
+    int failed = 0;
+    lite_promise<int> held(nullptr);
+    lite_promise<int> p;
+    auto f = p.get_future();
+    held = std::move(p);
+    check(!f.ready(), "moving a promise into an empty one publishes nothing", failed);
+    held.set_value(5);
+    auto r = f.get();
+    check(r.has_value() && r.value() == 5, "the promise moved in still completes its future", failed);
+    return failed;
+}
+
+int test_then() {
+    int failed = 0;
+    executor_env env;
+    std::atomic<int> done{0};
+    std::atomic<int> sum{0};
+    std::atomic<bool> on_executor{true};
+    const auto executor_thread = env.worker.get_id();
+
+    auto record = [&](result_t<int, std::exception_ptr>&& r) noexcept {
+        if (std::this_thread::get_id() != executor_thread) {
+            on_executor.store(false, std::memory_order_relaxed);
+        }
+        sum.fetch_add(r.has_value() ? r.value() : -1000, std::memory_order_relaxed);
+        done.fetch_add(1, std::memory_order_release);
+    };
+
+    // attached before the result.
+    lite_promise<int> p;
+    p.get_future().then(&env.ex, record);
+    p.set_value(3);
+
+    // attached after the result.
+    lite_promise<int> q;
+    auto f = q.get_future();
+    q.set_value(4);
+    std::move(f).then(&env.ex, record);
+
+    wait_for(done, 2);
+    check(sum.load() == 7, "then runs once whichever side comes second", failed);
+    check(on_executor.load(), "then runs on the given executor", failed);
+    return failed;
+}
+
+int test_future_task() {
+    int failed = 0;
+    auto ok = make_future_task([](int a, int b) { return a * b; }, 6, 7);
+    auto ok_future = ok.get_future();
+
+    auto bad = make_future_task([]() -> int { throw std::runtime_error("boom"); });
+    auto bad_future = bad.get_future();
+
+    std::thread worker([&]() noexcept {
+        ok();
+        bad();
+    });
+    auto r = ok_future.get();
+    auto e = bad_future.get();
+    worker.join();
+
+    check(r.has_value() && r.value() == 42, "future_task hands its value to the future", failed);
+    check(e.has_error() && e.error() != nullptr, "future_task hands the exception to the future", failed);
+    return failed;
+}
+} // namespace
+
+int main() {
+    int failed = 0;
+    failed += test_value_and_error();
+    failed += test_cross_thread_park();
+    failed += test_wait_for();
+    failed += test_broken_promise();
+    failed += test_empty_promise();
+    failed += test_then();
+    failed += test_future_task();
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] lite future test passed\n");
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "executor/blocking_pool.h"
+#include "task/parallel_for.h"
+
+using namespace flux_foundry;
+
+// Scaling of parallel_for / parallel_reduce over 1..threads workers against a plain serial loop.
+// - for: every index writes a value computed from `spin` rounds of dependent arithmetic.
+// - reduce: the same values summed, with per-worker partials.
+// The pool is sized to the worker count of each row, so `workers` is the real parallelism.
+
+namespace {
+constexpr int kRounds = 5;
+
+std::uint64_t item(size_t i, int spin) noexcept {
+    std::uint64_t x = static_cast<std::uint64_t>(i) + 1;
+    for (int k = 0; k < spin; ++k) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    return x >> 33;
+}
+
+template <typename F>
+double median_ms(F&& f) {
+    std::array<double, kRounds> ms{};
+    for (int round = 0; round < kRounds; ++round) {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        ms[static_cast<size_t>(round)] = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - begin).count();
+    }
+    std::sort(ms.begin(), ms.end());
+    return ms[kRounds / 2];
+}
+
+bool run_case(const char* name, size_t n, int spin, size_t max_threads) {
+    std::vector<std::uint64_t> out(n);
+    std::uint64_t expect = 0;
+    const double serial = median_ms([&]() {
+        std::uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = item(i, spin);
+            sum += out[i];
+        }
+        expect = sum;
+    });
+    std::printf("%-6s n=%8zu serial %9.3f ms\n", name, n, serial);
+
+    bool ok = true;
+    for (size_t workers = 1; workers <= max_threads; workers *= 2) {
+        blocking_pool<4096> pool(workers);
+        // warm up the pool threads.
+        parallel_for(&pool, 0, n, [&](size_t i) noexcept { out[i] = item(i, spin); }, 0, workers);
+
+        const double pf = median_ms([&]() {
+            parallel_for(&pool, 0, n, [&](size_t i) noexcept { out[i] = item(i, spin); }, 0, workers);
+        });
+        std::uint64_t sum = 0;
+        const double pr = median_ms([&]() {
+            sum = parallel_reduce(&pool, 0, n, std::uint64_t{0},
+                [&](size_t i) noexcept { return item(i, spin); },
+                [](std::uint64_t a, std::uint64_t b) noexcept { return a + b; }, 0, workers);
+        });
+        ok = ok && sum == expect;
+
+        std::printf("       workers=%3zu for %9.3f ms (x%5.2f)   reduce %9.3f ms (x%5.2f)\n",
+            workers, pf, serial / pf, pr, serial / pr);
+        if (workers < max_threads && workers * 2 > max_threads) {
+            workers = max_threads / 2;
+        }
+    }
+    return ok;
+}
+
+int arg_or_default(char** argv, int argc, int index, int fallback) {
+    if (index >= argc) {
+        return fallback;
+    }
+    const int v = std::atoi(argv[index]);
+    return v > 0 ? v : fallback;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t hw = std::thread::hardware_concurrency();
+    const size_t threads = static_cast<size_t>(arg_or_default(argv, argc, 1, static_cast<int>(hw ? hw : 1)));
+    std::printf("[parallel for perf] threads=%zu\n", threads);
+
+    bool ok = true;
+    // scheduling cost: a few ns of work per index.
+    ok = run_case("tiny", 4000000, 2, threads) && ok;
+    // compute bound: about a microsecond per index.
+    ok = run_case("heavy", 200000, 400, threads) && ok;
+
+    if (!ok) {
+        std::printf("[FAIL] a parallel_reduce result differs from the serial sum\n");
+        return 1;
+    }
+
+    std::printf("[PASS] parallel for perf finished\n");
+    return 0;
+}
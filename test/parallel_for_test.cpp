@@ -0,0 +1,222 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "executor/blocking_pool.h"
+#include "executor/simple_executor.h"
+#include "flow/flow.h"
+#include "task/parallel_for.h"
+
+using namespace flux_foundry;
+
+namespace {
+using err_t = std::exception_ptr;
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+struct executor_env {
+    simple_executor<1024> ex;
+    std::thread worker;
+
+    executor_env()
+        : worker([this]() noexcept { ex.run(); }) {
+    }
+
+    ~executor_env() {
+        for (int i = 0; i < 200000; ++i) {
+            if (ex.try_shutdown()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+// runs every task at once on the dispatching thread.
+struct inline_runner {
+    void dispatch(task_wrapper_sbo&& t) noexcept {
+        t();
+    }
+};
+
+template <typename BP>
+auto share(BP&& bp) {
+    return make_lite_ptr<std::decay_t<BP>>(std::forward<BP>(bp));
+}
+
+int test_every_index_once() {
+    int failed = 0;
+    constexpr size_t kN = 200000;
+    blocking_pool<> pool(4);
+    std::unique_ptr<std::atomic<int>[]> hits(new std::atomic<int>[kN]);
+    for (size_t i = 0; i < kN; ++i) {
+        hits[i].store(0, std::memory_order_relaxed);
+    }
+
+    parallel_for(&pool, 0, kN, [&](size_t i) noexcept {
+        hits[i].fetch_add(1, std::memory_order_relaxed);
+    }, 0, 4);
+
+    bool once = true;
+    for (size_t i = 0; i < kN; ++i) {
+        once = once && hits[i].load(std::memory_order_relaxed) == 1;
+    }
+    check(once, "parallel_for runs every index exactly once", failed);
+
+    std::vector<int> out(1000, 0);
+    parallel_for(&pool, 10, 20, [&](size_t i) noexcept { out[i] = 1; }, 64, 4);
+    parallel_for(&pool, 5, 5, [&](size_t i) noexcept { out[i] = 2; });
+    int marked = 0;
+    for (int v : out) {
+        marked += v;
+    }
+    check(marked == 10 && out[10] == 1 && out[19] == 1, "short and empty ranges run serially", failed);
+    return failed;
+}
+
+int test_reduce() {
+    int failed = 0;
+    constexpr size_t kN = 1000000;
+    blocking_pool<> pool(4);
+
+    const std::uint64_t sum = parallel_reduce(&pool, 0, kN, std::uint64_t{0},
+        [](size_t i) noexcept { return static_cast<std::uint64_t>(i); },
+        [](std::uint64_t a, std::uint64_t b) noexcept { return a + b; }, 0, 4);
+    check(sum == static_cast<std::uint64_t>(kN) * (kN - 1) / 2, "parallel_reduce folds every index", failed);
+
+    const std::uint64_t empty = parallel_reduce(&pool, 3, 3, std::uint64_t{7},
+        [](size_t i) noexcept { return static_cast<std::uint64_t>(i); },
+        [](std::uint64_t a, std::uint64_t b) noexcept { return a + b; });
+    check(empty == 7, "an empty reduce returns the identity", failed);
+    return failed;
+}
+
+int test_caller_never_waits_on_executor() {
+    int failed = 0;
+    constexpr size_t kN = 100000;
+
+    // the loop is started from the executor's only thread, its helpers can only run after it returns.
+    executor_env env;
+    std::atomic<std::uint64_t> from_worker{0};
+    std::atomic<bool> finished{false};
+    env.ex.dispatch(task_wrapper_sbo([&]() noexcept {
+        from_worker.store(parallel_reduce(&env.ex, 0, kN, std::uint64_t{0},
+            [](size_t i) noexcept { return static_cast<std::uint64_t>(i); },
+            [](std::uint64_t a, std::uint64_t b) noexcept { return a + b; }, 0, 4), std::memory_order_relaxed);
+        finished.store(true, std::memory_order_release);
+    }));
+    auto begin = std::chrono::steady_clock::now();
+    while (!finished.load(std::memory_order_acquire)
+        && std::chrono::steady_clock::now() - begin < std::chrono::seconds(10)) {
+        std::this_thread::yield();
+    }
+    check(finished.load() && from_worker.load() == static_cast<std::uint64_t>(kN) * (kN - 1) / 2,
+        "a loop started on a single-thread executor completes", failed);
+
+    // helpers run inline at dispatch, before the caller has any work to share.
+    inline_runner inline_exec;
+    std::atomic<size_t> count{0};
+    parallel_for(&inline_exec, 0, kN, [&](size_t) noexcept {
+        count.fetch_add(1, std::memory_order_relaxed);
+    }, 0, 4);
+    check(count.load() == kN, "a loop on an inline executor completes", failed);
+    return failed;
+}
+
+struct flow_log {
+    std::atomic<int> done{0};
+    std::atomic<int> errors{0};
+    std::atomic<std::uint64_t> value{0};
+};
+
+template <typename T>
+struct log_receiver {
+    using value_type = result_t<T, err_t>;
+    flow_log* log;
+
+    void emplace(value_type&& r) noexcept {
+        if (r.has_value()) {
+            log->value.store(static_cast<std::uint64_t>(r.value()), std::memory_order_relaxed);
+        } else {
+            log->errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        log->done.fetch_add(1, std::memory_order_release);
+    }
+};
+
+void wait_for(flow_log& log, int n) {
+    auto begin = std::chrono::steady_clock::now();
+    while (log.done.load(std::memory_order_acquire) != n) {
+        std::this_thread::yield();
+        if (std::chrono::steady_clock::now() - begin > std::chrono::seconds(10)) {
+            std::printf("[FAIL] parallel flows did not complete\n");
+            std::abort();
+        }
+    }
+}
+
+int test_awaitable() {
+    int failed = 0;
+    executor_env env;
+    blocking_pool<> pool(4);
+    flow_log log;
+
+    using values = std::vector<std::uint64_t>;
+    auto count = [](const values& v) noexcept { return v.size(); };
+    auto bp = share(make_blueprint<values>()
+        | await_parallel_for(&pool, count, [](values& v, size_t i) noexcept { v[i] = i * 2; }, &env.ex)
+        | await_parallel_reduce(&pool, count, std::uint64_t{0},
+            [](const values& v, size_t i) noexcept { return v[i]; },
+            [](std::uint64_t a, std::uint64_t b) noexcept { return a + b; }, &env.ex)
+        | end());
+
+    constexpr size_t kN = 50000;
+    make_runner(bp, log_receiver<std::uint64_t>{&log})(values(kN, 0));
+    wait_for(log, 1);
+    check(log.errors.load() == 0 && log.value.load() == static_cast<std::uint64_t>(kN) * (kN - 1),
+        "a flow awaits a parallel loop and a parallel reduce", failed);
+
+    make_runner(bp, log_receiver<std::uint64_t>{&log})(values());
+    wait_for(log, 2);
+    check(log.errors.load() == 0 && log.value.load() == 0, "an empty input resumes at once", failed);
+
+    make_runner(bp, log_receiver<std::uint64_t>{&log})(
+        result_t<values, err_t>(error_tag, std::make_exception_ptr(std::logic_error("upstream"))));
+    wait_for(log, 3);
+    check(log.errors.load() == 1, "an error input skips the loops", failed);
+    return failed;
+}
+} // namespace
+
+int main() {
+    int failed = 0;
+    failed += test_every_index_once();
+    failed += test_reduce();
+    failed += test_caller_never_waits_on_executor();
+    failed += test_awaitable();
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] parallel for test passed\n");
+    return 0;
+}
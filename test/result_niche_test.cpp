@@ -0,0 +1,134 @@
+#include <cstddef>
+#include <cstdio>
+#include <system_error>
+#include <utility>
+
+#include "memory/result_t.h"
+
+using namespace flux_foundry;
+
+// an error that always names its venue, the null venue pointer is spare.
+struct venue_error {
+    int code;
+    const char* venue;
+};
+
+namespace flux_foundry {
+    template <>
+    struct either_niche<venue_error> : pointer_niche<offsetof(venue_error, venue)> {
+    };
+}
+
+namespace {
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+#if FLUX_FOUNDRY_ERROR_CODE_NICHE
+static_assert(sizeof(result_t<int*, std::error_code>) == sizeof(std::error_code),
+    "result_t<T*, error_code> keeps its discriminant in the error_code");
+static_assert(sizeof(result_t<int, std::error_code>) == sizeof(std::error_code),
+    "result_t<int, error_code> keeps its discriminant in the error_code");
+static_assert(sizeof(result_t<void, std::error_code>) == sizeof(std::error_code),
+    "result_t<void, error_code> keeps its discriminant in the error_code");
+static_assert(sizeof(either_t<int*, std::error_code>) == sizeof(std::error_code),
+    "either_t<T*, error_code> keeps its discriminant in the error_code");
+#endif
+static_assert(sizeof(result_t<int, venue_error>) == sizeof(venue_error),
+    "a user declared niche is used");
+// T does not fit before the niche, the discriminant stays separate.
+static_assert(sizeof(result_t<double[2], std::error_code>) > 2 * sizeof(double),
+    "a T overlapping the niche keeps a separate discriminant");
+
+template <typename T>
+int test_round_trip(T v, const char* name) {
+    int failed = 0;
+    using res_t = result_t<T, std::error_code>;
+    const std::error_code ec = std::make_error_code(std::errc::timed_out);
+
+    res_t r(value_tag, v);
+    bool ok = r.has_value() && r.value() == v;
+
+    r.emplace_error(ec);
+    ok = ok && r.has_error() && r.error() == ec;
+
+    res_t copy(r);
+    ok = ok && copy.has_error() && copy.error() == ec;
+
+    r.emplace_value(v);
+    ok = ok && r.has_value() && r.value() == v;
+
+    res_t moved(std::move(r));
+    ok = ok && moved.has_value() && moved.value() == v;
+
+    moved = copy;
+    ok = ok && moved.has_error() && moved.error() == ec;
+
+    using either_type = either_t<T, std::error_code>;
+    either_type a(to_first, v);
+    either_type b(to_second, ec);
+    a.swap(b);
+    ok = ok && !a.has_first() && a.get_second() == ec && b.has_first() && b.get_first() == v;
+    a.swap(b);
+    ok = ok && a.has_first() && a.get_first() == v && !b.has_first() && b.get_second() == ec;
+
+    check(ok, name, failed);
+    return failed;
+}
+
+int test_void_round_trip() {
+    int failed = 0;
+    using res_t = result_t<void, std::error_code>;
+    const std::error_code ec = std::make_error_code(std::errc::broken_pipe);
+
+    res_t r(value_tag);
+    bool ok = r.has_value();
+    r.emplace_error(ec);
+    ok = ok && r.has_error() && r.error() == ec;
+    res_t copy(r);
+    r.emplace_value();
+    ok = ok && r.has_value() && copy.has_error() && copy.error() == ec;
+
+    check(ok, "result_t<void, error_code> round trip", failed);
+    return failed;
+}
+
+int test_user_niche() {
+    int failed = 0;
+    using res_t = result_t<int, venue_error>;
+
+    res_t r(value_tag, 7);
+    bool ok = r.has_value() && r.value() == 7;
+    r.emplace_error(venue_error{3, "XNAS"});
+    ok = ok && r.has_error() && r.error().code == 3 && r.error().venue[0] == 'X';
+    res_t copy(r);
+    r.emplace_value(9);
+    ok = ok && r.has_value() && r.value() == 9 && copy.has_error();
+
+    check(ok, "user declared niche round trip", failed);
+    return failed;
+}
+} // namespace
+
+int main() {
+    int failed = 0;
+    int x = 42;
+    failed += test_round_trip<int*>(&x, "result_t<int*, error_code> round trip");
+    failed += test_round_trip<int*>(nullptr, "result_t<int*, error_code> holds a null value");
+    failed += test_round_trip<int>(-1, "result_t<int, error_code> round trip");
+    failed += test_void_round_trip();
+    failed += test_user_niche();
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] result niche test passed\n");
+    return 0;
+}
@@ -0,0 +1,229 @@
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+#include "memory/hazard_ptr.h"
+#include "memory/inline_ring.h"
+#include "memory/small_vector.h"
+
+using namespace flux_foundry;
+
+namespace {
+int g_live = 0;
+
+// counts live instances, so leaks and double destroys show up.
+struct tracked {
+    int v;
+
+    explicit tracked(int v_ = 0) noexcept
+        : v(v_) {
+        ++g_live;
+    }
+
+    tracked(const tracked& rhs) noexcept
+        : v(rhs.v) {
+        ++g_live;
+    }
+
+    tracked(tracked&& rhs) noexcept
+        : v(rhs.v) {
+        rhs.v = -1;
+        ++g_live;
+    }
+
+    tracked& operator=(const tracked&) noexcept = default;
+    tracked& operator=(tracked&&) noexcept = default;
+
+    ~tracked() noexcept {
+        --g_live;
+    }
+};
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+template <typename C>
+bool holds_sequence(const C& c, int first, int n) {
+    if (c.size() != static_cast<size_t>(n)) {
+        return false;
+    }
+    for (int i = 0; i < n; ++i) {
+        if (c[i].v != first + i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int test_small_vector_spill() {
+    int failed = 0;
+    g_live = 0;
+    {
+        small_vector<tracked, 4> v;
+        for (int i = 0; i < 4; ++i) {
+            v.emplace_back(i);
+        }
+        check(v.is_inline() && v.capacity() == 4, "small_vector keeps N elements inline", failed);
+
+        // the argument refers into the vector while it grows.
+        v.push_back(v[0]);
+        for (int i = 5; i < 40; ++i) {
+            v.emplace_back(i);
+        }
+        check(!v.is_inline() && v.capacity() == 64, "small_vector spills and doubles", failed);
+        check(v[4].v == 0 && v[39].v == 39 && v.size() == 40, "elements survive the spill", failed);
+
+        v.resize(3);
+        v.shrink_to_fit();
+        check(v.is_inline() && holds_sequence(v, 0, 3), "shrink_to_fit returns to the inline buffer", failed);
+        check(g_live == 3, "resize destroys the tail", failed);
+    }
+    check(g_live == 0, "small_vector destroys every element", failed);
+    return failed;
+}
+
+int test_small_vector_move_copy() {
+    int failed = 0;
+    g_live = 0;
+    {
+        small_vector<tracked, 4> a;
+        a.emplace_back(1);
+        a.emplace_back(2);
+        small_vector<tracked, 4> b(std::move(a));
+        check(a.empty() && holds_sequence(b, 1, 2), "inline move moves the elements", failed);
+
+        small_vector<tracked, 4> c;
+        for (int i = 0; i < 10; ++i) {
+            c.emplace_back(i);
+        }
+        const tracked* heap = c.data();
+        small_vector<tracked, 4> d(std::move(c));
+        check(d.data() == heap && c.empty() && c.is_inline(), "heap move takes the block", failed);
+
+        small_vector<tracked, 4> e(d);
+        check(holds_sequence(e, 0, 10) && holds_sequence(d, 0, 10), "copy duplicates the elements", failed);
+
+        b = std::move(e);
+        check(holds_sequence(b, 0, 10) && e.empty(), "move assignment replaces the elements", failed);
+        check(g_live == 20, "no element leaks across moves and copies", failed);
+    }
+    check(g_live == 0, "moved vectors destroy every element", failed);
+    return failed;
+}
+
+int test_small_vector_reserve() {
+    int failed = 0;
+    small_vector<std::string, 2> v;
+    bool ok = v.reserve(100);
+    check(ok && v.capacity() == 128, "reserve rounds up to the next doubling", failed);
+    v.emplace_back(std::string(64, 'x'));
+    v.emplace_back("flux");
+    check(v.size() == 2 && v[1] == "flux", "reserved vector holds non trivial elements", failed);
+    return failed;
+}
+
+int test_inline_ring_wrap_and_grow() {
+    int failed = 0;
+    g_live = 0;
+    {
+        inline_ring<tracked, 4> r;
+        for (int i = 0; i < 4; ++i) {
+            r.emplace_back(i);
+        }
+        r.pop_front();
+        r.pop_front();
+        r.emplace_back(4);
+        r.emplace_back(5);
+        check(r.is_inline() && holds_sequence(r, 2, 4), "inline_ring wraps inside the inline buffer", failed);
+
+        // grows while wrapped, the order is kept.
+        r.push_back(r.front());
+        for (int i = 7; i < 20; ++i) {
+            r.emplace_back(i);
+        }
+        check(!r.is_inline() && r.size() == 18, "inline_ring spills and doubles", failed);
+        check(r[0].v == 2 && r[4].v == 2 && r[5].v == 7 && r.back().v == 19, "elements keep FIFO order", failed);
+
+        tracked t = r.take_front();
+        check(t.v == 2 && r.front().v == 3, "take_front moves the front out", failed);
+
+        inline_ring<tracked, 4> moved(std::move(r));
+        check(r.empty() && moved.size() == 17 && moved.front().v == 3, "heap ring moves by taking the block", failed);
+    }
+    check(g_live == 0, "inline_ring destroys every element", failed);
+    return failed;
+}
+
+int test_inline_ring_copy() {
+    int failed = 0;
+    inline_ring<int, 2> r;
+    for (int i = 0; i < 5; ++i) {
+        r.push_back(i);
+    }
+    r.pop_front();
+    inline_ring<int, 2> c(r);
+    bool ok = c.size() == 4;
+    for (size_t i = 0; ok && i < c.size(); ++i) {
+        ok = c[i] == r[i];
+    }
+    check(ok, "inline_ring copy keeps the order", failed);
+    return failed;
+}
+
+int g_reclaimed = 0;
+
+// a plain function pointer does not carry noexcept in C++14.
+const auto count_reclaim = [](int*) noexcept {
+    ++g_reclaimed;
+};
+
+int test_retire_list_spill() {
+    int failed = 0;
+    constexpr int hazardous = static_cast<int>(RETIRE_BATCH) + 8;
+    int node = 0;
+    int other = 0;
+    std::atomic<int*> target{&node};
+    g_reclaimed = 0;
+
+    hazard_ptr hp;
+    hp.protect(target);
+    // every retirement of the protected node stays on this thread's retire list, past its inline capacity.
+    for (int i = 0; i < hazardous; ++i) {
+        hazard_ptr::retire(&node, count_reclaim);
+    }
+    check(g_reclaimed == 0, "protected retirements are kept", failed);
+
+    hp.unprotect();
+    // unprotected retirements run at once and trigger the periodic sweep.
+    for (size_t i = 0; i < RETIRE_BATCH; ++i) {
+        hazard_ptr::retire(&other, count_reclaim);
+    }
+    check(g_reclaimed == hazardous + static_cast<int>(RETIRE_BATCH), "the spilled retire list is swept", failed);
+    return failed;
+}
+} // namespace
+
+int main() {
+    int failed = 0;
+    failed += test_small_vector_spill();
+    failed += test_small_vector_move_copy();
+    failed += test_small_vector_reserve();
+    failed += test_inline_ring_wrap_and_grow();
+    failed += test_inline_ring_copy();
+    failed += test_retire_list_spill();
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] small containers test passed\n");
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "executor/blocking_pool.h"
+#include "task/task_graph.h"
+
+using namespace flux_foundry;
+
+// A layered DAG (depth x width, every node depends on 3 nodes of the layer above) run three ways:
+// - serial: the node bodies called in topological order, no scheduling at all
+// - task_graph: the same graph on a blocking_pool of `threads` workers, built once and re-run
+// The critical path is `depth` nodes long, so with enough cores the graph approaches depth x node time;
+// with tiny nodes the difference to serial is the per-node scheduling cost.
+
+namespace {
+constexpr int kRounds = 3;
+
+std::atomic<std::uint64_t> g_sink{0};
+
+// `spin` iterations of dependent arithmetic, the body of every node.
+void node_work(int node, int spin) noexcept {
+    std::uint64_t x = static_cast<std::uint64_t>(node) + 1;
+    for (int i = 0; i < spin; ++i) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    g_sink.fetch_add(x, std::memory_order_relaxed);
+}
+
+struct layered_dag {
+    int depth;
+    int width;
+    // for every node of layer l > 0, three parents in layer l - 1.
+    std::vector<std::array<int, 3>> parents;
+
+    layered_dag(int depth_, int width_)
+        : depth(depth_), width(width_), parents(static_cast<size_t>(depth_ * width_)) {
+        std::uint32_t seed = 12345;
+        for (int v = width; v < depth * width; ++v) {
+            const int layer_begin = (v / width - 1) * width;
+            for (auto& p : parents[static_cast<size_t>(v)]) {
+                seed = seed * 1103515245u + 12345u;
+                p = layer_begin + static_cast<int>((seed >> 8) % static_cast<std::uint32_t>(width));
+            }
+        }
+    }
+
+    int nodes() const noexcept {
+        return depth * width;
+    }
+};
+
+void run_serial(const layered_dag& dag, int spin) noexcept {
+    // node ids are a topological order already.
+    for (int v = 0; v < dag.nodes(); ++v) {
+        node_work(v, spin);
+    }
+}
+
+void build_graph(task_graph& g, const layered_dag& dag, int spin) {
+    for (int v = 0; v < dag.nodes(); ++v) {
+        g.add([v, spin]() noexcept { node_work(v, spin); });
+    }
+    for (int v = dag.width; v < dag.nodes(); ++v) {
+        for (int p : dag.parents[static_cast<size_t>(v)]) {
+            g.precede(static_cast<task_graph::node_id>(p), static_cast<task_graph::node_id>(v));
+        }
+    }
+}
+
+template <typename F>
+double median_ms(F&& f) {
+    std::array<double, kRounds> ms{};
+    for (int round = 0; round < kRounds; ++round) {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        ms[static_cast<size_t>(round)] = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - begin).count();
+    }
+    std::sort(ms.begin(), ms.end());
+    return ms[kRounds / 2];
+}
+
+bool run_case(const char* name, int depth, int width, int spin, size_t threads) {
+    layered_dag dag(depth, width);
+    blocking_pool<4096> pool(threads);
+    task_graph g;
+    build_graph(g, dag, spin);
+
+    // warm up the pool threads and the flat layout.
+    bool ok = g.run(&pool, threads).get().has_value();
+
+    const double serial = median_ms([&]() { run_serial(dag, spin); });
+    const double graph = median_ms([&]() { ok = g.run(&pool, threads).get().has_value() && ok; });
+    const double node_ms = serial / dag.nodes();
+    const double bound = std::max(node_ms * depth, serial / static_cast<double>(threads));
+
+    std::printf("%-8s nodes=%6d serial %9.3f ms   task_graph %9.3f ms   bound %9.3f ms   overhead %7.1f ns/node\n",
+        name, dag.nodes(), serial, graph, bound, (graph - bound) * 1e6 / dag.nodes());
+    return ok;
+}
+
+int arg_or_default(char** argv, int argc, int index, int fallback) {
+    if (index >= argc) {
+        return fallback;
+    }
+    const int v = std::atoi(argv[index]);
+    return v > 0 ? v : fallback;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t hw = std::thread::hardware_concurrency();
+    const size_t threads = static_cast<size_t>(arg_or_default(argv, argc, 1, static_cast<int>(hw ? hw : 1)));
+    std::printf("[task graph perf] threads=%zu\n", threads);
+
+    bool ok = true;
+    // scheduling cost: nodes do almost nothing.
+    ok = run_case("tiny", 64, 64, 16, threads) && ok;
+    // critical path: nodes carry real work, wide layers.
+    ok = run_case("heavy", 16, 64, 20000, threads) && ok;
+
+    if (!ok) {
+        std::printf("[FAIL] a task_graph run reported an error\n");
+        return 1;
+    }
+
+    std::printf("[PASS] task graph perf finished\n");
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#include "executor/blocking_pool.h"
+#include "executor/simple_executor.h"
+#include "task/task_graph.h"
+
+using namespace flux_foundry;
+
+namespace {
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+struct executor_env {
+    simple_executor<1024> ex;
+    std::thread worker;
+
+    executor_env()
+        : worker([this]() noexcept { ex.run(); }) {
+    }
+
+    ~executor_env() {
+        for (int i = 0; i < 200000; ++i) {
+            if (ex.try_shutdown()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+int test_diamond_rerun() {
+    int failed = 0;
+    executor_env env;
+    std::atomic<int> seq{0};
+    int at[4] = {0, 0, 0, 0};
+    int runs[4] = {0, 0, 0, 0};
+
+    task_graph g;
+    task_graph::node_id ids[4];
+    for (int i = 0; i < 4; ++i) {
+        ids[i] = g.add([&, i]() noexcept {
+            at[i] = seq.fetch_add(1, std::memory_order_relaxed);
+            ++runs[i];
+        });
+    }
+    g.precede(ids[0], ids[1]);
+    g.precede(ids[0], ids[2]);
+    g.precede(ids[1], ids[3]);
+    g.precede(ids[2], ids[3]);
+
+    bool ordered = true;
+    for (int round = 0; round < 3; ++round) {
+        auto r = g.run(&env.ex).get();
+        ordered = ordered && r.has_value()
+            && at[0] < at[1] && at[0] < at[2] && at[1] < at[3] && at[2] < at[3];
+    }
+    check(ordered, "every run respects the edges", failed);
+    check(runs[0] == 3 && runs[1] == 3 && runs[2] == 3 && runs[3] == 3, "a rerun runs every node again", failed);
+    return failed;
+}
+
+int test_wide_fan_out() {
+    int failed = 0;
+    constexpr int kWidth = 200;
+    blocking_pool<> pool(4);
+    std::atomic<int> middle{0};
+    int seen_by_sink = -1;
+
+    task_graph g;
+    auto root = g.add([]() noexcept {});
+    auto sink = g.add([&]() noexcept { seen_by_sink = middle.load(std::memory_order_relaxed); });
+    for (int i = 0; i < kWidth; ++i) {
+        auto v = g.add([&]() noexcept { middle.fetch_add(1, std::memory_order_relaxed); });
+        g.precede(root, v);
+        g.precede(v, sink);
+    }
+
+    auto r = g.run(&pool, 4).get();
+    check(r.has_value() && seen_by_sink == kWidth, "the sink runs after every fanned out node", failed);
+    check(g.node_count() == kWidth + 2 && g.edge_count() == 2 * kWidth, "the graph keeps its shape", failed);
+    return failed;
+}
+
+int test_error_skips_dependents() {
+    int failed = 0;
+    executor_env env;
+    bool after_ran = false;
+
+    task_graph g;
+    auto bad = g.add([]() -> int { throw std::runtime_error("node failed"); });
+    auto after = g.add([&]() noexcept { after_ran = true; });
+    g.precede(bad, after);
+
+    auto r = g.run(&env.ex).get();
+    check(r.has_error() && r.error() != nullptr, "a failing node fails the run", failed);
+    check(!after_ran, "nodes after the failure are skipped", failed);
+    return failed;
+}
+
+int test_cycle_and_empty() {
+    int failed = 0;
+    executor_env env;
+
+    task_graph empty;
+    check(empty.run(&env.ex).get().has_value(), "an empty graph completes at once", failed);
+
+    task_graph g;
+    auto a = g.add([]() noexcept {});
+    auto b = g.add([]() noexcept {});
+    g.precede(a, b);
+    g.precede(b, a);
+    check(g.run(&env.ex).get().has_error(), "a cycle is reported instead of hanging", failed);
+    return failed;
+}
+} // namespace
+
+int main() {
+    int failed = 0;
+    failed += test_diamond_rerun();
+    failed += test_wide_fan_out();
+    failed += test_error_skips_dependents();
+    failed += test_cycle_and_empty();
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] task graph test passed\n");
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <utility>
+
+#include "flow/flow.h"
+#include "task/task_wrapper.h"
+
+using namespace flux_foundry;
+
+namespace {
+int g_moves = 0;
+int g_destroys = 0;
+
+// owns a heap buffer through a plain pointer, its move constructor is user-provided.
+struct order_buffer {
+    int* p;
+
+    explicit order_buffer(int v)
+        : p(new int(v)) {
+    }
+
+    order_buffer(order_buffer&& rhs) noexcept
+        : p(rhs.p) {
+        rhs.p = nullptr;
+        ++g_moves;
+    }
+
+    ~order_buffer() noexcept {
+        if (p) {
+            ++g_destroys;
+            delete p;
+        }
+    }
+};
+
+// the same layout, without the opt-in below.
+struct plain_buffer : order_buffer {
+    using order_buffer::order_buffer;
+};
+} // namespace
+
+namespace flux_foundry {
+    template <>
+    struct is_trivially_relocatable<order_buffer> : std::true_type {
+    };
+}
+
+namespace {
+static_assert(is_trivially_relocatable<lite_ptr<int>>::value, "lite_ptr is relocatable");
+static_assert(is_trivially_relocatable<std::shared_ptr<int>>::value, "shared_ptr is relocatable");
+static_assert(is_trivially_relocatable<result_t<int, std::exception_ptr>>::value,
+    "result_t of relocatable types is relocatable");
+static_assert(is_trivially_relocatable<compressed_pair<lite_ptr<int>, int>>::value,
+    "compressed_pair of relocatable types is relocatable");
+static_assert(!is_trivially_relocatable<plain_buffer>::value, "a user-provided move is not relocatable by default");
+static_assert(!is_trivially_relocatable<result_t<plain_buffer, std::exception_ptr>>::value,
+    "result_t holding a non relocatable type is not relocatable");
+
+void check(bool cond, const char* name, int& failed) {
+    if (cond) {
+        std::printf("[OK] %s\n", name);
+    } else {
+        std::printf("[FAIL] %s\n", name);
+        ++failed;
+    }
+}
+
+template <typename buffer_t>
+struct consume_task {
+    buffer_t buf;
+    int* out;
+
+    void operator()() noexcept {
+        *out += *buf.p;
+    }
+};
+
+int test_declared_type_is_memcpy_moved() {
+    int failed = 0;
+    int out = 0;
+    g_moves = 0;
+    g_destroys = 0;
+    {
+        // consume_task itself has no opt-in, relocatable_if carries the one of its order_buffer member.
+        task_wrapper_sbo a(relocatable_if<is_trivially_relocatable<order_buffer>::value>(
+            consume_task<order_buffer>{order_buffer(7), &out}));
+        g_moves = 0;
+        task_wrapper_sbo b(std::move(a));
+        task_wrapper_sbo c;
+        c = std::move(b);
+        check(!a && !b && static_cast<bool>(c), "moved-from wrappers are empty", failed);
+        check(g_moves == 0, "a relocatable target is moved without its move constructor", failed);
+        c();
+    }
+    check(out == 7, "the relocated task runs", failed);
+    check(g_destroys == 1, "the relocated target is destroyed exactly once", failed);
+    return failed;
+}
+
+int test_plain_type_keeps_move_constructor() {
+    int failed = 0;
+    int out = 0;
+    g_moves = 0;
+    g_destroys = 0;
+    {
+        task_wrapper_sbo a(consume_task<plain_buffer>{plain_buffer(5), &out});
+        g_moves = 0;
+        task_wrapper_sbo b(std::move(a));
+        check(g_moves == 1, "a non relocatable target is moved by its move constructor", failed);
+        b();
+    }
+    check(out == 5 && g_destroys == 1, "the moved task runs and is destroyed once", failed);
+    return failed;
+}
+
+int test_mixed_swap() {
+    int failed = 0;
+    int out = 0;
+    g_destroys = 0;
+    {
+        task_wrapper_sbo a(relocatable_if<is_trivially_relocatable<order_buffer>::value>(
+            consume_task<order_buffer>{order_buffer(1), &out}));
+        task_wrapper_sbo b(consume_task<plain_buffer>{plain_buffer(10), &out});
+        task_wrapper_sbo e;
+        a.swap(b);
+        a();
+        b.swap(e);
+        e();
+        check(!b, "swapping with an empty wrapper moves the target across", failed);
+    }
+    check(out == 11 && g_destroys == 2, "swapped tasks run and are destroyed once", failed);
+    return failed;
+}
+
+int test_callable_wrapper() {
+    int failed = 0;
+    auto sp = std::make_shared<int>(3);
+    callable_wrapper<int()> f(relocatable_if<is_trivially_relocatable<std::shared_ptr<int>>::value>(
+        [sp]() noexcept { return *sp; }));
+    callable_wrapper<int()> g(std::move(f));
+    check(g() == 3 && sp.use_count() == 2, "callable_wrapper relocates a shared_ptr capture", failed);
+    g = callable_wrapper<int()>();
+    check(sp.use_count() == 1, "the relocated capture is released once", failed);
+    return failed;
+}
+} // namespace
+
+int main() {
+    int failed = 0;
+    failed += test_declared_type_is_memcpy_moved();
+    failed += test_plain_type_keeps_move_constructor();
+    failed += test_mixed_swap();
+    failed += test_callable_wrapper();
+
+    if (failed != 0) {
+        std::printf("[FAIL] %d test(s) failed\n", failed);
+        return 1;
+    }
+
+    std::printf("[PASS] task relocate test passed\n");
+    return 0;
+}
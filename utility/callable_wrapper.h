@@ -11,6 +11,7 @@
 #include "../memory/result_t.h"
 
 namespace flux_foundry {
+    // default inline buffer of a callable_wrapper, pick another one through its second parameter.
     constexpr static size_t callable_wrapper_sbo_size = 48;
 
     namespace callable_handle_impl {
@@ -34,13 +35,13 @@ namespace flux_foundry {
         };
     }
 
-    template <typename>
+    template <typename, size_t sbo_size_ = callable_wrapper_sbo_size>
     class callable_wrapper;
 
     // this is not thread safe
-    template <typename R, typename ... Args>
-    class callable_wrapper <R(Args...)> : 
-        public raw_type_erase_base<callable_wrapper<R(Args...)>, callable_wrapper_sbo_size,
+    template <typename R, typename ... Args, size_t sbo_size_>
+    class callable_wrapper <R(Args...), sbo_size_> : 
+        public raw_type_erase_base<callable_wrapper<R(Args...), sbo_size_>, sbo_size_,
             alignof(std::max_align_t), R(void*, Args...)> {
 
         template <typename T, bool sbo_enabled>
@@ -50,7 +51,7 @@ namespace flux_foundry {
             }
         };
 
-        using base = raw_type_erase_base<callable_wrapper<R(Args...)>, callable_wrapper_sbo_size,
+        using base = raw_type_erase_base<callable_wrapper<R(Args...), sbo_size_>, sbo_size_,
             alignof(std::max_align_t), R(void*, Args...)>;
 
 
@@ -63,7 +64,7 @@ namespace flux_foundry {
 #endif
         }
 
-        friend struct raw_type_erase_base<callable_wrapper<R(Args...)>, callable_wrapper_sbo_size,
+        friend struct raw_type_erase_base<callable_wrapper<R(Args...), sbo_size_>, sbo_size_,
             alignof(std::max_align_t), R(void*, Args...)>;
 #if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
         result_t<R, std::exception_ptr> do_nothrow(std::true_type, Args... args) noexcept {
@@ -89,7 +90,7 @@ namespace flux_foundry {
         template <typename T, bool sbo_enabled>
         void do_customize() noexcept {
             this->invoker_ = callable_vfns<T, sbo_enabled>::call;
-            this->manager_ = life_span_manager<T, sbo_enabled>::manage;
+            this->manager_ = &life_span_manager<T, sbo_enabled>::vtable;
         }
 
         template <typename callable,
@@ -131,9 +132,9 @@ namespace flux_foundry {
 #endif
     };
 
-    template <typename R, typename ... Args>
-    class callable_wrapper <R(Args...) const> 
-        : public raw_type_erase_base<callable_wrapper<R(Args...) const>, callable_wrapper_sbo_size,
+    template <typename R, typename ... Args, size_t sbo_size_>
+    class callable_wrapper <R(Args...) const, sbo_size_> 
+        : public raw_type_erase_base<callable_wrapper<R(Args...) const, sbo_size_>, sbo_size_,
             alignof(std::max_align_t), R(const void*, Args...)> {
         template <typename T, bool sbo_enabled>
         struct callable_vfns {
@@ -142,7 +143,7 @@ namespace flux_foundry {
             }
         };
 
-        using base = raw_type_erase_base<callable_wrapper<R(Args...) const>, callable_wrapper_sbo_size,
+        using base = raw_type_erase_base<callable_wrapper<R(Args...) const, sbo_size_>, sbo_size_,
             alignof(std::max_align_t), R(const void*, Args...)>;
 
         static R stub(const void*, Args... args) {
@@ -154,7 +155,7 @@ namespace flux_foundry {
 #endif
         }
 
-        friend struct raw_type_erase_base<callable_wrapper<R(Args...) const>, callable_wrapper_sbo_size,
+        friend struct raw_type_erase_base<callable_wrapper<R(Args...) const, sbo_size_>, sbo_size_,
             alignof(std::max_align_t), R(const void*, Args...)>;
 
 #if FLUX_FOUNDRY_COMPILER_HAS_EXCEPTIONS
@@ -181,7 +182,7 @@ namespace flux_foundry {
         template <typename T, bool sbo_enabled>
         void do_customize() noexcept {
             this->invoker_ = callable_vfns<T, sbo_enabled>::call;
-            this->manager_ = life_span_manager<T, sbo_enabled>::manage;
+            this->manager_ = &life_span_manager<T, sbo_enabled>::vtable;
         }
 
         template <typename callable,
@@ -221,8 +222,8 @@ namespace flux_foundry {
 #endif
     };
 
-    template <typename callable>
-    void swap(callable_wrapper<callable>& a, callable_wrapper<callable>& b) noexcept {
+    template <typename callable, size_t sbo_size_>
+    void swap(callable_wrapper<callable, sbo_size_>& a, callable_wrapper<callable, sbo_size_>& b) noexcept {
         a.swap(b);
     }
 }
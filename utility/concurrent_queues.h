@@ -743,6 +743,11 @@ public:
 
         return {};
     }
+
+    // owner only, and only for approximating the size: a steal in flight is still counted.
+    size_t size() noexcept {
+        return _t.get() - _h.get().load(std::memory_order_relaxed);
+    }
 };
 }
 
@@ -0,0 +1,103 @@
+#ifndef FLUX_FOUNDRY_PARK_H
+#define FLUX_FOUNDRY_PARK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "../base/traits.h"
+#include "back_off.h"
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace flux_foundry {
+    // park_on / unpark_all: sleep on a 32-bit atomic word until another thread changes it and wakes it.
+    // this is the blocking half of the waits done by non-flow threads (lite_future::wait ...).
+    //
+    // - park_on() returns when the word no longer holds `expected`, on a wake-up, or spuriously.
+    //   callers re-check their condition in a loop.
+    // - Linux: a private futex, so a parked thread costs no CPU and unpark_all() is one syscall.
+    // - elsewhere: a short sleep per round, the word is polled.
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+        "the parking word must be a plain 32-bit integer.");
+
+#if defined(__linux__)
+    namespace detail {
+        inline int futex_call(std::atomic<std::uint32_t>& word, int op, std::uint32_t v, const timespec* ts) noexcept {
+            return static_cast<int>(syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), op, v, ts, nullptr, 0));
+        }
+    }
+
+    inline void park_on(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept {
+        detail::futex_call(word, FUTEX_WAIT_PRIVATE, expected, nullptr);
+    }
+
+    template <typename Rep, typename Period>
+    void park_on_for(std::atomic<std::uint32_t>& word, std::uint32_t expected,
+        const std::chrono::duration<Rep, Period>& timeout) noexcept {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+        UNLIKELY_IF (ns <= 0) {
+            return;
+        }
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+        ts.tv_nsec = static_cast<long>(ns % 1000000000);
+        detail::futex_call(word, FUTEX_WAIT_PRIVATE, expected, &ts);
+    }
+
+    inline void unpark_all(std::atomic<std::uint32_t>& word) noexcept {
+        detail::futex_call(word, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr);
+    }
+#else
+    namespace detail {
+        constexpr std::chrono::microseconds park_poll_interval {50};
+    }
+
+    inline void park_on(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept {
+        if (word.load(std::memory_order_acquire) == expected) {
+            std::this_thread::sleep_for(detail::park_poll_interval);
+        }
+    }
+
+    template <typename Rep, typename Period>
+    void park_on_for(std::atomic<std::uint32_t>& word, std::uint32_t expected,
+        const std::chrono::duration<Rep, Period>& timeout) noexcept {
+        if (word.load(std::memory_order_acquire) == expected) {
+            if (timeout < detail::park_poll_interval) {
+                std::this_thread::sleep_for(timeout);
+            } else {
+                std::this_thread::sleep_for(detail::park_poll_interval);
+            }
+        }
+    }
+
+    inline void unpark_all(std::atomic<std::uint32_t>&) noexcept {
+    }
+#endif
+
+    // the spinning half: polls `ready()` for a few backoff rounds before a caller parks, since most
+    // results handed to a waiting thread arrive within a few microseconds. on a single hardware thread
+    // the producer cannot run while we spin, so it only checks once.
+    template <typename Pred>
+    bool spin_until(Pred&& ready) noexcept {
+        static const bool multicore = std::thread::hardware_concurrency() > 1;
+        UNLIKELY_IF (!multicore) {
+            return ready();
+        }
+        for (backoff_strategy<8, 64> backoff; backoff.steps < 8; backoff.yield()) {
+            if (ready()) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+#endif // FLUX_FOUNDRY_PARK_H